@@ -116,6 +116,7 @@ struct blm_reject_ap_timestamp {
 /**
  * struct blm_reject_ap - Structure of a node added to blacklist manager
  * @node: Node of the entry
+ * @hash_node: Node of the entry in its BSSID hash bucket
  * @bssid: Bssid of the AP entry.
  * @rssi_reject_params: Rssi reject params of the AP entry.
  * @bad_bssid_counter: It represent how many times data stall happened.
@@ -125,6 +126,7 @@ struct blm_reject_ap_timestamp {
  */
 struct blm_reject_ap {
 	qdf_list_node_t node;
+	qdf_list_node_t hash_node;
 	struct qdf_mac_addr bssid;
 	struct blm_rssi_disallow_params rssi_reject_params;
 	uint8_t bad_bssid_counter;
@@ -185,7 +187,7 @@ blm_add_bssid_to_reject_list(struct wlan_objmgr_pdev *pdev,
 /**
  * blm_send_reject_ap_list_to_fw() - Send the blacklist BSSIDs to FW
  * @pdev: Pdev object
- * @reject_db_list: List of blacklist BSSIDs
+ * @blm_ctx: Blacklist manager pdev priv object holding the reject AP list
  * @cfg: Blacklist manager cfg
  *
  * This API will send the blacklist BSSIDs to FW for avoiding or blacklisting
@@ -195,7 +197,7 @@ blm_add_bssid_to_reject_list(struct wlan_objmgr_pdev *pdev,
  */
 void
 blm_send_reject_ap_list_to_fw(struct wlan_objmgr_pdev *pdev,
-			      qdf_list_t *reject_db_list,
+			      struct blm_pdev_priv_obj *blm_ctx,
 			      struct blm_config *cfg);
 
 /**
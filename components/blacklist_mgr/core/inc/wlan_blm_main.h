@@ -40,15 +40,45 @@
 #define blm_nofl_debug(params...)\
 		QDF_TRACE_DEBUG_NO_FL(QDF_MODULE_ID_BLACKLIST_MGR, params)
 
+/* Number of BSSID hash buckets of the reject AP list, power of 2 */
+#define BLM_REJECT_AP_HASH_SIZE 16
+#define BLM_REJECT_AP_HASH(_bssid) \
+	(((_bssid)->bytes[4] ^ (_bssid)->bytes[5]) & \
+	 (BLM_REJECT_AP_HASH_SIZE - 1))
+
+/**
+ * struct blm_lookup_stats - cost of the reject AP list lookups
+ * @num_filter: scan lists filtered
+ * @num_lookup: BSSIDs looked up while filtering scan lists
+ * @filter_us: time spent filtering scan lists
+ * @num_prune: prune passes over the reject AP list
+ * @num_pruned: entries removed by the prune passes
+ * @prune_us: time spent in prune passes
+ */
+struct blm_lookup_stats {
+	uint32_t num_filter;
+	uint32_t num_lookup;
+	uint64_t filter_us;
+	uint32_t num_prune;
+	uint32_t num_pruned;
+	uint64_t prune_us;
+};
+
 /**
  * struct blm_pdev_priv_obj - Pdev priv struct to store list of blacklist mgr.
  * @reject_ap_list_lock: Mutex needed to restrict two threads updating the list.
  * @reject_ap_list: The reject Ap list which would contain the list of bad APs.
+ * @reject_ap_hash: The entries of @reject_ap_list hashed by BSSID
+ * @next_expiry: Earliest time a timer of an entry expires, 0 if none
+ * @stats: Lookup and prune counters
  * @blm_tx_ops: tx ops to send reject ap list to FW
  */
 struct blm_pdev_priv_obj {
 	qdf_mutex_t reject_ap_list_lock;
 	qdf_list_t reject_ap_list;
+	qdf_list_t reject_ap_hash[BLM_REJECT_AP_HASH_SIZE];
+	qdf_time_t next_expiry;
+	struct blm_lookup_stats stats;
 	struct wlan_blm_tx_ops blm_tx_ops;
 };
 
@@ -22,6 +22,7 @@
 #include <wlan_objmgr_pdev_obj.h>
 #include <wlan_blm_core.h>
 #include <qdf_mc_timer.h>
+#include <qdf_time.h>
 #include <wlan_scan_public_structs.h>
 #include <wlan_scan_utils_api.h>
 #include "wlan_blm_tgt_api.h"
@@ -134,11 +135,195 @@ blm_update_ap_info(struct blm_reject_ap *blm_entry, struct blm_config *cfg,
 
 #define MAX_BL_TIME 255000
 
+/**
+ * blm_find_entry() - Find the reject list entry of a BSSID
+ * @blm_ctx: blacklist manager pdev priv object
+ * @bssid: BSSID to look for
+ *
+ * Caller must hold reject_ap_list_lock.
+ *
+ * Return: entry of @bssid, NULL if the BSSID is not in the reject list
+ */
+static struct blm_reject_ap *
+blm_find_entry(struct blm_pdev_priv_obj *blm_ctx, struct qdf_mac_addr *bssid)
+{
+	qdf_list_t *bucket = &blm_ctx->reject_ap_hash[BLM_REJECT_AP_HASH(bssid)];
+	qdf_list_node_t *cur_node = NULL, *next_node = NULL;
+	struct blm_reject_ap *blm_entry;
+
+	qdf_list_peek_front(bucket, &cur_node);
+	while (cur_node) {
+		blm_entry = qdf_container_of(cur_node, struct blm_reject_ap,
+					     hash_node);
+		if (qdf_is_macaddr_equal(&blm_entry->bssid, bssid))
+			return blm_entry;
+
+		qdf_list_peek_next(bucket, cur_node, &next_node);
+		cur_node = next_node;
+		next_node = NULL;
+	}
+
+	return NULL;
+}
+
+/**
+ * blm_insert_entry() - Add a new entry at the end of the reject list
+ * @blm_ctx: blacklist manager pdev priv object
+ * @blm_entry: entry, with its BSSID filled
+ *
+ * Caller must hold reject_ap_list_lock.
+ *
+ * Return: None
+ */
+static void blm_insert_entry(struct blm_pdev_priv_obj *blm_ctx,
+			     struct blm_reject_ap *blm_entry)
+{
+	qdf_list_insert_back(&blm_ctx->reject_ap_list, &blm_entry->node);
+	qdf_list_insert_back(
+		&blm_ctx->reject_ap_hash[BLM_REJECT_AP_HASH(&blm_entry->bssid)],
+		&blm_entry->hash_node);
+}
+
+/**
+ * blm_remove_entry() - Remove an entry from the reject list and free it
+ * @blm_ctx: blacklist manager pdev priv object
+ * @blm_entry: entry to remove
+ *
+ * Caller must hold reject_ap_list_lock.
+ *
+ * Return: None
+ */
+static void blm_remove_entry(struct blm_pdev_priv_obj *blm_ctx,
+			     struct blm_reject_ap *blm_entry)
+{
+	qdf_list_remove_node(&blm_ctx->reject_ap_list, &blm_entry->node);
+	qdf_list_remove_node(
+		&blm_ctx->reject_ap_hash[BLM_REJECT_AP_HASH(&blm_entry->bssid)],
+		&blm_entry->hash_node);
+	qdf_mem_free(blm_entry);
+}
+
+/**
+ * blm_get_entry_expiry() - Get the earliest time a timer of an entry expires
+ * @blm_entry: reject list entry
+ * @cfg: blacklist manager cfg
+ *
+ * Mirrors the timers checked by blm_update_ap_info().
+ *
+ * Return: expiry time in ms, 0 if no timer of the entry is running
+ */
+static qdf_time_t blm_get_entry_expiry(struct blm_reject_ap *blm_entry,
+				       struct blm_config *cfg)
+{
+	qdf_time_t expiry = 0, timer_expiry;
+
+	if (BLM_IS_AP_AVOIDED_BY_USERSPACE(blm_entry)) {
+		timer_expiry =
+			blm_entry->ap_timestamp.userspace_avoid_timestamp +
+			MINUTES_TO_MS(cfg->avoid_list_exipry_time);
+		if (!expiry || timer_expiry < expiry)
+			expiry = timer_expiry;
+	}
+
+	if (BLM_IS_AP_AVOIDED_BY_DRIVER(blm_entry)) {
+		timer_expiry = blm_entry->ap_timestamp.driver_avoid_timestamp +
+			MINUTES_TO_MS(cfg->avoid_list_exipry_time);
+		if (!expiry || timer_expiry < expiry)
+			expiry = timer_expiry;
+	}
+
+	if (BLM_IS_AP_BLACKLISTED_BY_DRIVER(blm_entry)) {
+		timer_expiry =
+			blm_entry->ap_timestamp.driver_blacklist_timestamp +
+			MINUTES_TO_MS(cfg->black_list_exipry_time);
+		if (!expiry || timer_expiry < expiry)
+			expiry = timer_expiry;
+	}
+
+	if (BLM_IS_AP_IN_RSSI_REJECT_LIST(blm_entry) &&
+	    blm_entry->rssi_reject_params.retry_delay) {
+		timer_expiry = blm_entry->ap_timestamp.rssi_reject_timestamp +
+			blm_entry->rssi_reject_params.retry_delay;
+		if (!expiry || timer_expiry < expiry)
+			expiry = timer_expiry;
+	}
+
+	return expiry;
+}
+
+/**
+ * blm_update_next_expiry() - Account the timers of an updated entry
+ * @blm_ctx: blacklist manager pdev priv object
+ * @blm_entry: entry whose timers were started
+ * @cfg: blacklist manager cfg
+ *
+ * Return: None
+ */
+static void blm_update_next_expiry(struct blm_pdev_priv_obj *blm_ctx,
+				   struct blm_reject_ap *blm_entry,
+				   struct blm_config *cfg)
+{
+	qdf_time_t expiry = blm_get_entry_expiry(blm_entry, cfg);
+
+	if (expiry && (!blm_ctx->next_expiry || expiry < blm_ctx->next_expiry))
+		blm_ctx->next_expiry = expiry;
+}
+
+/**
+ * blm_prune_expired_entries() - Apply the expired timers of the reject list
+ * @blm_ctx: blacklist manager pdev priv object
+ * @cfg: blacklist manager cfg
+ *
+ * The list is only walked once the earliest timer of its entries expired,
+ * so the common case, nothing expired, costs a time read. Entries left
+ * without any reject type are removed. Caller must hold
+ * reject_ap_list_lock.
+ *
+ * Return: None
+ */
+static void blm_prune_expired_entries(struct blm_pdev_priv_obj *blm_ctx,
+				      struct blm_config *cfg)
+{
+	qdf_list_node_t *cur_node = NULL, *next_node = NULL;
+	struct blm_reject_ap *blm_entry;
+	uint64_t start_us;
+
+	if (!blm_ctx->next_expiry ||
+	    qdf_mc_timer_get_system_time() < blm_ctx->next_expiry)
+		return;
+
+	start_us = qdf_get_log_timestamp_usecs();
+	blm_ctx->next_expiry = 0;
+	qdf_list_peek_front(&blm_ctx->reject_ap_list, &cur_node);
+	while (cur_node) {
+		qdf_list_peek_next(&blm_ctx->reject_ap_list, cur_node,
+				   &next_node);
+		blm_entry = qdf_container_of(cur_node, struct blm_reject_ap,
+					     node);
+
+		blm_update_ap_info(blm_entry, cfg, NULL);
+		if (!blm_entry->reject_ap_type) {
+			blm_debug("%pM cleared from list",
+				  blm_entry->bssid.bytes);
+			blm_remove_entry(blm_ctx, blm_entry);
+			blm_ctx->stats.num_pruned++;
+		} else {
+			blm_update_next_expiry(blm_ctx, blm_entry, cfg);
+		}
+
+		cur_node = next_node;
+		next_node = NULL;
+	}
+
+	blm_ctx->stats.num_prune++;
+	blm_ctx->stats.prune_us += qdf_get_log_timestamp_usecs() - start_us;
+}
+
 static enum blm_bssid_action
 blm_prune_old_entries_and_get_action(struct blm_reject_ap *blm_entry,
 				     struct blm_config *cfg,
 				     struct scan_cache_entry *entry,
-				     qdf_list_t *reject_ap_list)
+				     struct blm_pdev_priv_obj *blm_ctx)
 {
 	blm_update_ap_info(blm_entry, cfg, entry);
 
@@ -149,8 +334,7 @@ blm_prune_old_entries_and_get_action(struct blm_reject_ap *blm_entry,
 	 */
 	if (!blm_entry->reject_ap_type) {
 		blm_debug("%pM cleared from list", blm_entry->bssid.bytes);
-		qdf_list_remove_node(reject_ap_list, &blm_entry->node);
-		qdf_mem_free(blm_entry);
+		blm_remove_entry(blm_ctx, blm_entry);
 		return BLM_ACTION_NOP;
 	}
 
@@ -173,54 +357,30 @@ blm_prune_old_entries_and_get_action(struct blm_reject_ap *blm_entry,
 
 }
 
+/**
+ * blm_action_on_bssid() - Get the action to take on a scan entry
+ * @blm_ctx: blacklist manager pdev priv object
+ * @cfg: blacklist manager cfg
+ * @entry: scan entry
+ *
+ * Caller must hold reject_ap_list_lock.
+ *
+ * Return: action for the scan entry
+ */
 static enum blm_bssid_action
-blm_action_on_bssid(struct wlan_objmgr_pdev *pdev,
+blm_action_on_bssid(struct blm_pdev_priv_obj *blm_ctx,
+		    struct blm_config *cfg,
 		    struct scan_cache_entry *entry)
 {
-	struct blm_pdev_priv_obj *blm_ctx;
-	struct blm_psoc_priv_obj *blm_psoc_obj;
-	struct blm_config *cfg;
-	struct blm_reject_ap *blm_entry = NULL;
-	qdf_list_node_t *cur_node = NULL, *next_node = NULL;
-	QDF_STATUS status;
-	enum blm_bssid_action action = BLM_ACTION_NOP;
-
-	blm_ctx = blm_get_pdev_obj(pdev);
-	blm_psoc_obj = blm_get_psoc_obj(wlan_pdev_get_psoc(pdev));
-	if (!blm_ctx || !blm_psoc_obj) {
-		blm_err("blm_ctx or blm_psoc_obj is NULL");
-		return BLM_ACTION_NOP;
-	}
+	struct blm_reject_ap *blm_entry;
 
-	status = qdf_mutex_acquire(&blm_ctx->reject_ap_list_lock);
-	if (QDF_IS_STATUS_ERROR(status)) {
-		blm_err("failed to acquire reject_ap_list_lock");
+	blm_ctx->stats.num_lookup++;
+	blm_entry = blm_find_entry(blm_ctx, &entry->bssid);
+	if (!blm_entry)
 		return BLM_ACTION_NOP;
-	}
-
-	cfg = &blm_psoc_obj->blm_cfg;
-
-	qdf_list_peek_front(&blm_ctx->reject_ap_list, &cur_node);
-
-	while (cur_node) {
-		qdf_list_peek_next(&blm_ctx->reject_ap_list, cur_node,
-				   &next_node);
-
-		blm_entry = qdf_container_of(cur_node, struct blm_reject_ap,
-					    node);
-
-		if (qdf_is_macaddr_equal(&blm_entry->bssid, &entry->bssid)) {
-			action = blm_prune_old_entries_and_get_action(blm_entry,
-					cfg, entry, &blm_ctx->reject_ap_list);
-			qdf_mutex_release(&blm_ctx->reject_ap_list_lock);
-			return action;
-		}
-		cur_node = next_node;
-		next_node = NULL;
-	}
-	qdf_mutex_release(&blm_ctx->reject_ap_list_lock);
 
-	return BLM_ACTION_NOP;
+	return blm_prune_old_entries_and_get_action(blm_entry, cfg, entry,
+						    blm_ctx);
 }
 
 static void
@@ -251,16 +411,39 @@ blm_modify_scan_list(qdf_list_t *scan_list,
 QDF_STATUS
 blm_filter_bssid(struct wlan_objmgr_pdev *pdev, qdf_list_t *scan_list)
 {
+	struct blm_pdev_priv_obj *blm_ctx;
+	struct blm_psoc_priv_obj *blm_psoc_obj;
 	struct scan_cache_node *scan_node = NULL;
 	uint32_t scan_list_size;
 	enum blm_bssid_action action;
 	qdf_list_node_t *cur_node = NULL, *next_node = NULL;
+	uint64_t start_us;
+	QDF_STATUS status;
 
 	if (!scan_list || !qdf_list_size(scan_list)) {
 		blm_debug("Scan list is NULL or No BSSIDs present");
 		return QDF_STATUS_E_EMPTY;
 	}
 
+	blm_ctx = blm_get_pdev_obj(pdev);
+	blm_psoc_obj = blm_get_psoc_obj(wlan_pdev_get_psoc(pdev));
+	if (!blm_ctx || !blm_psoc_obj) {
+		blm_err("blm_ctx or blm_psoc_obj is NULL");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	status = qdf_mutex_acquire(&blm_ctx->reject_ap_list_lock);
+	if (QDF_IS_STATUS_ERROR(status)) {
+		blm_err("failed to acquire reject_ap_list_lock");
+		return status;
+	}
+
+	if (!qdf_list_size(&blm_ctx->reject_ap_list)) {
+		qdf_mutex_release(&blm_ctx->reject_ap_list_lock);
+		return QDF_STATUS_SUCCESS;
+	}
+
+	start_us = qdf_get_log_timestamp_usecs();
 	scan_list_size = qdf_list_size(scan_list);
 	qdf_list_peek_front(scan_list, &cur_node);
 
@@ -269,7 +452,8 @@ blm_filter_bssid(struct wlan_objmgr_pdev *pdev, qdf_list_t *scan_list)
 
 		scan_node = qdf_container_of(cur_node, struct scan_cache_node,
 					    node);
-		action = blm_action_on_bssid(pdev, scan_node->entry);
+		action = blm_action_on_bssid(blm_ctx, &blm_psoc_obj->blm_cfg,
+					     scan_node->entry);
 		if (action != BLM_ACTION_NOP)
 			blm_modify_scan_list(scan_list, scan_node, action);
 		cur_node = next_node;
@@ -277,6 +461,10 @@ blm_filter_bssid(struct wlan_objmgr_pdev *pdev, qdf_list_t *scan_list)
 		scan_list_size--;
 	}
 
+	blm_ctx->stats.num_filter++;
+	blm_ctx->stats.filter_us += qdf_get_log_timestamp_usecs() - start_us;
+	qdf_mutex_release(&blm_ctx->reject_ap_list_lock);
+
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -517,10 +705,11 @@ blm_is_oldest_entry(enum blm_reject_ap_type list_type,
 }
 
 static QDF_STATUS
-blm_try_delete_bssid_in_list(qdf_list_t *reject_ap_list,
+blm_try_delete_bssid_in_list(struct blm_pdev_priv_obj *blm_ctx,
 			     enum blm_reject_ap_type list_type,
 			     struct blm_config *cfg)
 {
+	qdf_list_t *reject_ap_list = &blm_ctx->reject_ap_list;
 	struct blm_reject_ap *blm_entry = NULL;
 	qdf_list_node_t *cur_node = NULL, *next_node = NULL;
 	struct blm_reject_ap *oldest_blm_entry = NULL;
@@ -555,8 +744,7 @@ blm_try_delete_bssid_in_list(qdf_list_t *reject_ap_list,
 		/* Remove this entry to make space for the next entry */
 		blm_debug("Removed %pM, type = %d",
 			  oldest_blm_entry->bssid.bytes, list_type);
-		qdf_list_remove_node(reject_ap_list, &oldest_blm_entry->node);
-		qdf_mem_free(oldest_blm_entry);
+		blm_remove_entry(blm_ctx, oldest_blm_entry);
 		return QDF_STATUS_SUCCESS;
 	}
 	/* If the flow has reached here, that means no entry could be removed */
@@ -565,7 +753,7 @@ blm_try_delete_bssid_in_list(qdf_list_t *reject_ap_list,
 }
 
 static QDF_STATUS
-blm_remove_lowest_delta_entry(qdf_list_t *reject_ap_list,
+blm_remove_lowest_delta_entry(struct blm_pdev_priv_obj *blm_ctx,
 			      struct blm_config *cfg)
 {
 	QDF_STATUS status;
@@ -582,32 +770,32 @@ blm_remove_lowest_delta_entry(qdf_list_t *reject_ap_list,
 	 * 6. Userspace Blacklist.
 	 */
 
-	status = blm_try_delete_bssid_in_list(reject_ap_list,
+	status = blm_try_delete_bssid_in_list(blm_ctx,
 					      DRIVER_MONITOR_TYPE, cfg);
 	if (QDF_IS_STATUS_SUCCESS(status))
 		return QDF_STATUS_SUCCESS;
 
-	status = blm_try_delete_bssid_in_list(reject_ap_list,
+	status = blm_try_delete_bssid_in_list(blm_ctx,
 					      DRIVER_AVOID_TYPE, cfg);
 	if (QDF_IS_STATUS_SUCCESS(status))
 		return QDF_STATUS_SUCCESS;
 
-	status = blm_try_delete_bssid_in_list(reject_ap_list,
+	status = blm_try_delete_bssid_in_list(blm_ctx,
 					      USERSPACE_AVOID_TYPE, cfg);
 	if (QDF_IS_STATUS_SUCCESS(status))
 		return QDF_STATUS_SUCCESS;
 
-	status = blm_try_delete_bssid_in_list(reject_ap_list,
+	status = blm_try_delete_bssid_in_list(blm_ctx,
 					      DRIVER_RSSI_REJECT_TYPE, cfg);
 	if (QDF_IS_STATUS_SUCCESS(status))
 		return QDF_STATUS_SUCCESS;
 
-	status = blm_try_delete_bssid_in_list(reject_ap_list,
+	status = blm_try_delete_bssid_in_list(blm_ctx,
 					      DRIVER_BLACKLIST_TYPE, cfg);
 	if (QDF_IS_STATUS_SUCCESS(status))
 		return QDF_STATUS_SUCCESS;
 
-	status = blm_try_delete_bssid_in_list(reject_ap_list,
+	status = blm_try_delete_bssid_in_list(blm_ctx,
 					      USERSPACE_BLACKLIST_TYPE, cfg);
 	if (QDF_IS_STATUS_SUCCESS(status))
 		return QDF_STATUS_SUCCESS;
@@ -729,16 +917,22 @@ void blm_dump_blacklist_bssid(struct wlan_objmgr_pdev *pdev)
 		next_node = NULL;
 	}
 
+	blm_nofl_debug("BLACKLIST lookups: %u scan lists %u BSSIDs in %llu us, prune: %u passes %u removed in %llu us",
+		       blm_ctx->stats.num_filter, blm_ctx->stats.num_lookup,
+		       blm_ctx->stats.filter_us, blm_ctx->stats.num_prune,
+		       blm_ctx->stats.num_pruned, blm_ctx->stats.prune_us);
+
 	qdf_mutex_release(&blm_ctx->reject_ap_list_lock);
 }
 
-static void blm_fill_reject_list(qdf_list_t *reject_db_list,
+static void blm_fill_reject_list(struct blm_pdev_priv_obj *blm_ctx,
 				 struct reject_ap_config_params *reject_list,
 				 uint8_t *num_of_reject_bssid,
 				 enum blm_reject_ap_type reject_ap_type,
 				 uint8_t max_bssid_to_be_filled,
 				 struct blm_config *cfg)
 {
+	qdf_list_t *reject_db_list = &blm_ctx->reject_ap_list;
 	struct blm_reject_ap *blm_entry = NULL;
 	qdf_list_node_t *cur_node = NULL, *next_node = NULL;
 
@@ -758,8 +952,7 @@ static void blm_fill_reject_list(qdf_list_t *reject_db_list,
 		if (!blm_entry->reject_ap_type) {
 			blm_debug("%pM cleared from list",
 				  blm_entry->bssid.bytes);
-			qdf_list_remove_node(reject_db_list, &blm_entry->node);
-			qdf_mem_free(blm_entry);
+			blm_remove_entry(blm_ctx, blm_entry);
 			cur_node = next_node;
 			next_node = NULL;
 			continue;
@@ -789,7 +982,7 @@ static void blm_fill_reject_list(qdf_list_t *reject_db_list,
 
 void
 blm_send_reject_ap_list_to_fw(struct wlan_objmgr_pdev *pdev,
-			      qdf_list_t *reject_db_list,
+			      struct blm_pdev_priv_obj *blm_ctx,
 			      struct blm_config *cfg)
 {
 	QDF_STATUS status;
@@ -802,23 +995,23 @@ blm_send_reject_ap_list_to_fw(struct wlan_objmgr_pdev *pdev,
 		return;
 
 	/* The priority for filling is as below */
-	blm_fill_reject_list(reject_db_list, reject_params.bssid_list,
+	blm_fill_reject_list(blm_ctx, reject_params.bssid_list,
 			     &reject_params.num_of_reject_bssid,
 			     USERSPACE_BLACKLIST_TYPE,
 			     PDEV_MAX_NUM_BSSID_DISALLOW_LIST, cfg);
-	blm_fill_reject_list(reject_db_list, reject_params.bssid_list,
+	blm_fill_reject_list(blm_ctx, reject_params.bssid_list,
 			     &reject_params.num_of_reject_bssid,
 			     DRIVER_BLACKLIST_TYPE,
 			     PDEV_MAX_NUM_BSSID_DISALLOW_LIST, cfg);
-	blm_fill_reject_list(reject_db_list, reject_params.bssid_list,
+	blm_fill_reject_list(blm_ctx, reject_params.bssid_list,
 			     &reject_params.num_of_reject_bssid,
 			     DRIVER_RSSI_REJECT_TYPE,
 			     PDEV_MAX_NUM_BSSID_DISALLOW_LIST, cfg);
-	blm_fill_reject_list(reject_db_list, reject_params.bssid_list,
+	blm_fill_reject_list(blm_ctx, reject_params.bssid_list,
 			     &reject_params.num_of_reject_bssid,
 			     USERSPACE_AVOID_TYPE,
 			     PDEV_MAX_NUM_BSSID_DISALLOW_LIST, cfg);
-	blm_fill_reject_list(reject_db_list, reject_params.bssid_list,
+	blm_fill_reject_list(blm_ctx, reject_params.bssid_list,
 			     &reject_params.num_of_reject_bssid,
 			     DRIVER_AVOID_TYPE,
 			     PDEV_MAX_NUM_BSSID_DISALLOW_LIST, cfg);
@@ -839,7 +1032,6 @@ blm_add_bssid_to_reject_list(struct wlan_objmgr_pdev *pdev,
 	struct blm_psoc_priv_obj *blm_psoc_obj;
 	struct blm_config *cfg;
 	struct blm_reject_ap *blm_entry;
-	qdf_list_node_t *cur_node = NULL, *next_node = NULL;
 	QDF_STATUS status;
 
 	blm_ctx = blm_get_pdev_obj(pdev);
@@ -864,42 +1056,18 @@ blm_add_bssid_to_reject_list(struct wlan_objmgr_pdev *pdev,
 
 	cfg = &blm_psoc_obj->blm_cfg;
 
-	qdf_list_peek_front(&blm_ctx->reject_ap_list, &cur_node);
-
-	while (cur_node) {
-		qdf_list_peek_next(&blm_ctx->reject_ap_list,
-				   cur_node, &next_node);
-
-		blm_entry = qdf_container_of(cur_node, struct blm_reject_ap,
-					    node);
-
-		/* Update the AP info to the latest list first */
-		blm_update_ap_info(blm_entry, cfg, NULL);
-		if (!blm_entry->reject_ap_type) {
-			blm_debug("%pM cleared from list",
-				  blm_entry->bssid.bytes);
-			qdf_list_remove_node(&blm_ctx->reject_ap_list,
-					     &blm_entry->node);
-			qdf_mem_free(blm_entry);
-			cur_node = next_node;
-			next_node = NULL;
-			continue;
-		}
-
-		if (qdf_is_macaddr_equal(&blm_entry->bssid, &ap_info->bssid)) {
-			blm_modify_entry(blm_entry, cfg, ap_info);
-			goto end;
-		}
+	/* Update the AP info to the latest list first */
+	blm_prune_expired_entries(blm_ctx, cfg);
 
-		cur_node = next_node;
-		next_node = NULL;
+	blm_entry = blm_find_entry(blm_ctx, &ap_info->bssid);
+	if (blm_entry) {
+		blm_modify_entry(blm_entry, cfg, ap_info);
+		goto end;
 	}
 
 	if (qdf_list_size(&blm_ctx->reject_ap_list) == MAX_BAD_AP_LIST_SIZE) {
 		/* List is FULL, need to delete entries */
-		status =
-			blm_remove_lowest_delta_entry(&blm_ctx->reject_ap_list,
-						      cfg);
+		status = blm_remove_lowest_delta_entry(blm_ctx, cfg);
 
 		if (QDF_IS_STATUS_ERROR(status)) {
 			qdf_mutex_release(&blm_ctx->reject_ap_list_lock);
@@ -914,11 +1082,13 @@ blm_add_bssid_to_reject_list(struct wlan_objmgr_pdev *pdev,
 		return QDF_STATUS_E_FAILURE;
 	}
 
-	qdf_list_insert_back(&blm_ctx->reject_ap_list, &blm_entry->node);
+	blm_entry->bssid = ap_info->bssid;
+	blm_insert_entry(blm_ctx, blm_entry);
 	blm_modify_entry(blm_entry, cfg, ap_info);
 
 end:
-	blm_send_reject_ap_list_to_fw(pdev, &blm_ctx->reject_ap_list, cfg);
+	blm_update_next_expiry(blm_ctx, blm_entry, cfg);
+	blm_send_reject_ap_list_to_fw(pdev, blm_ctx, cfg);
 	qdf_mutex_release(&blm_ctx->reject_ap_list_lock);
 
 	return QDF_STATUS_SUCCESS;
@@ -954,9 +1124,7 @@ blm_clear_userspace_blacklist_info(struct wlan_objmgr_pdev *pdev)
 
 		if (IS_AP_IN_USERSPACE_BLACKLIST_ONLY(blm_entry)) {
 			blm_debug("removing bssid: %pM", blm_entry->bssid.bytes);
-			qdf_list_remove_node(&blm_ctx->reject_ap_list,
-					     &blm_entry->node);
-			qdf_mem_free(blm_entry);
+			blm_remove_entry(blm_ctx, blm_entry);
 		} else if (BLM_IS_AP_BLACKLISTED_BY_USERSPACE(blm_entry)) {
 			blm_debug("Clearing userspace blacklist bit for %pM",
 				  blm_entry->bssid.bytes);
@@ -1000,7 +1168,7 @@ blm_add_userspace_black_list(struct wlan_objmgr_pdev *pdev,
 		return status;
 	}
 
-	blm_send_reject_ap_list_to_fw(pdev, &blm_ctx->reject_ap_list, cfg);
+	blm_send_reject_ap_list_to_fw(pdev, blm_ctx, cfg);
 	qdf_mutex_release(&blm_ctx->reject_ap_list_lock);
 
 	if (!bssid_black_list || !num_of_bssid) {
@@ -1042,12 +1210,11 @@ blm_flush_reject_ap_list(struct blm_pdev_priv_obj *blm_ctx)
 				   &next_node);
 		blm_entry = qdf_container_of(cur_node, struct blm_reject_ap,
 					    node);
-		qdf_list_remove_node(&blm_ctx->reject_ap_list,
-				     &blm_entry->node);
-		qdf_mem_free(blm_entry);
+		blm_remove_entry(blm_ctx, blm_entry);
 		cur_node = next_node;
 		next_node = NULL;
 	}
+	blm_ctx->next_expiry = 0;
 
 	blm_debug("BLM reject ap list flushed");
 	qdf_mutex_release(&blm_ctx->reject_ap_list_lock);
@@ -1078,7 +1245,7 @@ blm_get_bssid_reject_list(struct wlan_objmgr_pdev *pdev,
 		return 0;
 	}
 
-	blm_fill_reject_list(&blm_ctx->reject_ap_list, reject_list,
+	blm_fill_reject_list(blm_ctx, reject_list,
 			     &num_of_reject_bssid, reject_ap_type,
 			     max_bssid_to_be_filled, &blm_psoc_obj->blm_cfg);
 
@@ -1094,11 +1261,9 @@ blm_update_bssid_connect_params(struct wlan_objmgr_pdev *pdev,
 {
 	struct blm_pdev_priv_obj *blm_ctx;
 	struct blm_psoc_priv_obj *blm_psoc_obj;
-	qdf_list_node_t *cur_node = NULL, *next_node = NULL;
 	QDF_STATUS status;
 	struct blm_reject_ap *blm_entry = NULL;
 	qdf_time_t connection_age = 0;
-	bool entry_found = false;
 	qdf_time_t max_entry_time;
 
 	blm_ctx = blm_get_pdev_obj(pdev);
@@ -1115,30 +1280,15 @@ blm_update_bssid_connect_params(struct wlan_objmgr_pdev *pdev,
 		return;
 	}
 
-	qdf_list_peek_front(&blm_ctx->reject_ap_list, &cur_node);
-
-	while (cur_node) {
-		qdf_list_peek_next(&blm_ctx->reject_ap_list, cur_node,
-				   &next_node);
-		blm_entry = qdf_container_of(cur_node, struct blm_reject_ap,
-					     node);
-
-		if (!qdf_mem_cmp(blm_entry->bssid.bytes, bssid.bytes,
-				 QDF_MAC_ADDR_SIZE)) {
-			blm_debug("%pM present in BLM reject list, updating connect info con_state = %d",
-				  blm_entry->bssid.bytes, con_state);
-			entry_found = true;
-			break;
-		}
-		cur_node = next_node;
-		next_node = NULL;
-	}
+	blm_entry = blm_find_entry(blm_ctx, &bssid);
 
 	/* This means that the BSSID was not added in the reject list of BLM */
-	if (!entry_found) {
+	if (!blm_entry) {
 		qdf_mutex_release(&blm_ctx->reject_ap_list_lock);
 		return;
 	}
+	blm_debug("%pM present in BLM reject list, updating connect info con_state = %d",
+		  blm_entry->bssid.bytes, con_state);
 	switch (con_state) {
 	case BLM_AP_CONNECTED:
 		blm_entry->connect_timestamp = qdf_mc_timer_get_system_time();
@@ -1170,11 +1320,8 @@ blm_update_bssid_connect_params(struct wlan_objmgr_pdev *pdev,
 			if (!blm_entry->reject_ap_type) {
 				blm_debug("Bad Bssid timer expired/AP cleared from all blacklisting, removed %pM from list",
 					  blm_entry->bssid.bytes);
-				qdf_list_remove_node(&blm_ctx->reject_ap_list,
-						     &blm_entry->node);
-				qdf_mem_free(blm_entry);
-				blm_send_reject_ap_list_to_fw(pdev,
-					&blm_ctx->reject_ap_list,
+				blm_remove_entry(blm_ctx, blm_entry);
+				blm_send_reject_ap_list_to_fw(pdev, blm_ctx,
 					&blm_psoc_obj->blm_cfg);
 			}
 		}
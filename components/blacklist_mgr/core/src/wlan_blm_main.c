@@ -30,6 +30,35 @@
 #include "cfg_ucfg_api.h"
 #include <wlan_blm_core.h>
 
+/**
+ * blm_reject_ap_hash_create() - Create the hash buckets of the reject list
+ * @blm_ctx: blacklist manager pdev priv object
+ *
+ * Return: None
+ */
+static void blm_reject_ap_hash_create(struct blm_pdev_priv_obj *blm_ctx)
+{
+	uint8_t i;
+
+	for (i = 0; i < BLM_REJECT_AP_HASH_SIZE; i++)
+		qdf_list_create(&blm_ctx->reject_ap_hash[i],
+				MAX_BAD_AP_LIST_SIZE);
+}
+
+/**
+ * blm_reject_ap_hash_destroy() - Destroy the hash buckets of the reject list
+ * @blm_ctx: blacklist manager pdev priv object
+ *
+ * Return: None
+ */
+static void blm_reject_ap_hash_destroy(struct blm_pdev_priv_obj *blm_ctx)
+{
+	uint8_t i;
+
+	for (i = 0; i < BLM_REJECT_AP_HASH_SIZE; i++)
+		qdf_list_destroy(&blm_ctx->reject_ap_hash[i]);
+}
+
 struct blm_pdev_priv_obj *
 blm_get_pdev_obj(struct wlan_objmgr_pdev *pdev)
 {
@@ -72,6 +101,7 @@ blm_pdev_object_created_notification(struct wlan_objmgr_pdev *pdev,
 		return status;
 	}
 	qdf_list_create(&blm_ctx->reject_ap_list, MAX_BAD_AP_LIST_SIZE);
+	blm_reject_ap_hash_create(blm_ctx);
 
 	target_if_blm_register_tx_ops(&blm_ctx->blm_tx_ops);
 	status = wlan_objmgr_pdev_component_obj_attach(pdev,
@@ -80,6 +110,7 @@ blm_pdev_object_created_notification(struct wlan_objmgr_pdev *pdev,
 						   QDF_STATUS_SUCCESS);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		blm_err("Failed to attach pdev_ctx with pdev");
+		blm_reject_ap_hash_destroy(blm_ctx);
 		qdf_list_destroy(&blm_ctx->reject_ap_list);
 		qdf_mutex_destroy(&blm_ctx->reject_ap_list_lock);
 		qdf_mem_free(blm_ctx);
@@ -102,6 +133,7 @@ blm_pdev_object_destroyed_notification(struct wlan_objmgr_pdev *pdev,
 	}
 	/* Clear away the memory allocated for the bad BSSIDs */
 	blm_flush_reject_ap_list(blm_ctx);
+	blm_reject_ap_hash_destroy(blm_ctx);
 	qdf_list_destroy(&blm_ctx->reject_ap_list);
 	qdf_mutex_destroy(&blm_ctx->reject_ap_list_lock);
 
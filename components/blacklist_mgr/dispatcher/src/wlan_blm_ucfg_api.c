@@ -176,6 +176,6 @@ ucfg_blm_wifi_off(struct wlan_objmgr_pdev *pdev)
 	cfg = &blm_psoc_obj->blm_cfg;
 
 	blm_flush_reject_ap_list(blm_ctx);
-	blm_send_reject_ap_list_to_fw(pdev, &blm_ctx->reject_ap_list, cfg);
+	blm_send_reject_ap_list_to_fw(pdev, blm_ctx, cfg);
 	qdf_mutex_release(&blm_ctx->reject_ap_list_lock);
 }
@@ -672,6 +672,19 @@ QDF_STATUS policy_mgr_get_pcl(struct wlan_objmgr_psoc *psoc,
 		uint8_t *pcl_channels, uint32_t *len,
 		uint8_t *pcl_weight, uint32_t weight_len);
 
+/**
+ * policy_mgr_pcl_cache_invalidate() - Drop all the memoized PCLs
+ * @psoc: PSOC object information
+ *
+ * policy_mgr_get_pcl() serves repeated requests from a cache which is
+ * keyed by the connection table and channel list generations. Entities
+ * changing an input of the PCL computation outside of policy manager
+ * (e.g. the valid channel list of SME) use this to force a recompute.
+ *
+ * Return: None
+ */
+void policy_mgr_pcl_cache_invalidate(struct wlan_objmgr_psoc *psoc);
+
 /**
  * policy_mgr_init_chan_avoidance() - init channel avoidance in policy manager.
  * @psoc: PSOC object information
@@ -1109,6 +1122,39 @@ enum policy_mgr_pcl_type policy_mgr_get_pcl_from_second_conn_table(
 enum policy_mgr_pcl_type policy_mgr_get_pcl_from_third_conn_table(
 	enum policy_mgr_two_connection_mode idx, enum policy_mgr_con_mode type,
 	enum policy_mgr_conc_priority_mode sys_pref, uint8_t dbs_capable);
+
+/**
+ * struct policy_mgr_packed_tables_ut_result - Packed table check result
+ * @num_lookups: number of table entries compared
+ * @num_mismatch: number of entries the packed tables disagree on
+ * @orig_lookup_us: time taken by the PCL lookups in the original tables
+ * @packed_lookup_us: time taken by the same lookups in the packed tables
+ * @orig_size: size of the original PCL and next action tables in use
+ * @packed_size: size of the packed tables
+ */
+struct policy_mgr_packed_tables_ut_result {
+	uint32_t num_lookups;
+	uint32_t num_mismatch;
+	uint64_t orig_lookup_us;
+	uint64_t packed_lookup_us;
+	uint32_t orig_size;
+	uint32_t packed_size;
+};
+
+/**
+ * policy_mgr_packed_tables_ut() - Check the packed concurrency tables
+ * @iterations: number of timed passes over all PCL table entries
+ * @result: filled with the result of the check
+ *
+ * Enumerates every entry of the second and third connection PCL tables,
+ * with and without DBS, and of the next action tables in use, compares
+ * the original tables against their packed form and times the lookups.
+ *
+ * Return: QDF_STATUS_SUCCESS if all entries match
+ */
+QDF_STATUS
+policy_mgr_packed_tables_ut(uint32_t iterations,
+			    struct policy_mgr_packed_tables_ut_result *result);
 #else
 static inline QDF_STATUS policy_mgr_incr_connection_count_utfw(
 		struct wlan_objmgr_psoc *psoc, uint32_t vdev_id,
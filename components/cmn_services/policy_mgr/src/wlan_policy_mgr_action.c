@@ -724,32 +724,36 @@ DONE:
  * @vdev_id: vdev Id
  * @channel: channel of vdev.
  * @reason: reason of request
+ * @orig: filled with the original table the packed one is built from
  *
  * Get the action table based on current HW Caps and INI user preference.
  * This function will be called by policy_mgr_current_connections_update during
  * DBS action decision.
  *
- * return : action table address
+ * return : packed action table address
  */
-static policy_mgr_next_action_two_connection_table_type *
+static const struct policy_mgr_packed_action_table *
 policy_mgr_get_second_conn_action_table(
 	struct wlan_objmgr_psoc *psoc,
 	uint32_t vdev_id,
 	uint8_t channel,
-	enum policy_mgr_conn_update_reason reason)
+	enum policy_mgr_conn_update_reason reason,
+	policy_mgr_next_action_two_connection_table_type **orig)
 {
 	enum policy_mgr_conc_next_action preferred_action;
 
+	*orig = next_action_two_connection_table;
 	if (!policy_mgr_is_2x2_1x1_dbs_capable(psoc))
-		return next_action_two_connection_table;
+		return &pm_packed_tables.next_action_two;
 
 	preferred_action = policy_mgr_get_preferred_dbs_action_table(
 				psoc, vdev_id, channel, reason);
 	switch (preferred_action) {
 	case PM_DBS2:
-		return next_action_two_connection_2x2_2g_1x1_5g_table;
+		*orig = next_action_two_connection_2x2_2g_1x1_5g_table;
+		return &pm_packed_tables.next_action_two_2g_1x1_5g;
 	default:
-		return next_action_two_connection_table;
+		return &pm_packed_tables.next_action_two;
 	}
 }
 
@@ -759,32 +763,36 @@ policy_mgr_get_second_conn_action_table(
  * @vdev_id: vdev Id
  * @channel: channel of vdev.
  * @reason: reason of request
+ * @orig: filled with the original table the packed one is built from
  *
  * Get the action table based on current HW Caps and INI user preference.
  * This function will be called by policy_mgr_current_connections_update during
  * DBS action decision.
  *
- * return : action table address
+ * return : packed action table address
  */
-static policy_mgr_next_action_three_connection_table_type *
+static const struct policy_mgr_packed_action_table *
 policy_mgr_get_third_conn_action_table(
 	struct wlan_objmgr_psoc *psoc,
 	uint32_t vdev_id,
 	uint8_t channel,
-	enum policy_mgr_conn_update_reason reason)
+	enum policy_mgr_conn_update_reason reason,
+	policy_mgr_next_action_three_connection_table_type **orig)
 {
 	enum policy_mgr_conc_next_action preferred_action;
 
+	*orig = next_action_three_connection_table;
 	if (!policy_mgr_is_2x2_1x1_dbs_capable(psoc))
-		return next_action_three_connection_table;
+		return &pm_packed_tables.next_action_three;
 
 	preferred_action = policy_mgr_get_preferred_dbs_action_table(
 				psoc, vdev_id, channel, reason);
 	switch (preferred_action) {
 	case PM_DBS2:
-		return next_action_three_connection_2x2_2g_1x1_5g_table;
+		*orig = next_action_three_connection_2x2_2g_1x1_5g_table;
+		return &pm_packed_tables.next_action_three_2g_1x1_5g;
 	default:
-		return next_action_three_connection_table;
+		return &pm_packed_tables.next_action_three;
 	}
 }
 
@@ -798,8 +806,10 @@ policy_mgr_get_next_action(struct wlan_objmgr_psoc *psoc,
 	uint32_t num_connections = 0;
 	enum policy_mgr_one_connection_mode second_index = 0;
 	enum policy_mgr_two_connection_mode third_index = 0;
-	policy_mgr_next_action_two_connection_table_type *second_conn_table;
-	policy_mgr_next_action_three_connection_table_type *third_conn_table;
+	const struct policy_mgr_packed_action_table *second_conn_table;
+	const struct policy_mgr_packed_action_table *third_conn_table;
+	policy_mgr_next_action_two_connection_table_type *second_orig_table;
+	policy_mgr_next_action_three_connection_table_type *third_orig_table;
 	enum policy_mgr_band band;
 	struct policy_mgr_psoc_priv_obj *pm_ctx;
 	enum QDF_OPMODE new_conn_mode = QDF_MAX_NO_OF_MODE;
@@ -845,8 +855,13 @@ policy_mgr_get_next_action(struct wlan_objmgr_psoc *psoc,
 			return QDF_STATUS_E_FAILURE;
 		}
 		second_conn_table = policy_mgr_get_second_conn_action_table(
-			psoc, session_id, channel, reason);
-		*next_action = (*second_conn_table)[second_index][band];
+			psoc, session_id, channel, reason, &second_orig_table);
+		if (qdf_likely(second_conn_table->valid))
+			*next_action = policy_mgr_packed_action_get(
+					second_conn_table, second_index, band);
+		else
+			*next_action =
+				(*second_orig_table)[second_index][band];
 		break;
 	case 2:
 		third_index =
@@ -857,8 +872,12 @@ policy_mgr_get_next_action(struct wlan_objmgr_psoc *psoc,
 			return QDF_STATUS_E_FAILURE;
 		}
 		third_conn_table = policy_mgr_get_third_conn_action_table(
-			psoc, session_id, channel, reason);
-		*next_action = (*third_conn_table)[third_index][band];
+			psoc, session_id, channel, reason, &third_orig_table);
+		if (qdf_likely(third_conn_table->valid))
+			*next_action = policy_mgr_packed_action_get(
+					third_conn_table, third_index, band);
+		else
+			*next_action = (*third_orig_table)[third_index][band];
 		break;
 	default:
 		policy_mgr_err("unexpected num_connections value %d",
@@ -619,6 +619,7 @@ void policy_mgr_update_conc_list(struct wlan_objmgr_psoc *psoc,
 	pm_conc_connection_list[conn_index].original_nss = original_nss;
 	pm_conc_connection_list[conn_index].vdev_id = vdev_id;
 	pm_conc_connection_list[conn_index].in_use = in_use;
+	policy_mgr_pcl_cache_conn_changed(pm_ctx);
 	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
 
 	/*
@@ -856,6 +857,7 @@ void policy_mgr_restore_deleted_conn_info(struct wlan_objmgr_psoc *psoc,
 	qdf_mem_copy(&pm_conc_connection_list[conn_index], info,
 			num_cxn_del * sizeof(*info));
 	pm_ctx->no_of_active_sessions[info->mode] += num_cxn_del;
+	policy_mgr_pcl_cache_conn_changed(pm_ctx);
 	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
 
 	policy_mgr_debug("Restored the deleleted conn info, vdev:%d, index:%d",
@@ -912,6 +914,7 @@ void policy_mgr_update_hw_mode_conn_info(struct wlan_objmgr_psoc *psoc,
 					vdev_mac_map[i].mac_id);
 		}
 	}
+	policy_mgr_pcl_cache_conn_changed(pm_ctx);
 	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
 	policy_mgr_dump_connection_status_info(psoc);
 }
@@ -3104,6 +3107,7 @@ QDF_STATUS policy_mgr_reset_sap_mandatory_channels(
 	pm_ctx->sap_mandatory_channels_len = 0;
 	qdf_mem_zero(pm_ctx->sap_mandatory_channels,
 		QDF_ARRAY_SIZE(pm_ctx->sap_mandatory_channels));
+	policy_mgr_pcl_cache_chan_changed(pm_ctx);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -3128,6 +3132,7 @@ void policy_mgr_add_sap_mandatory_chan(struct wlan_objmgr_psoc *psoc,
 	policy_mgr_debug("chan %hu", chan);
 	pm_ctx->sap_mandatory_channels[pm_ctx->sap_mandatory_channels_len++]
 		= chan;
+	policy_mgr_pcl_cache_chan_changed(pm_ctx);
 }
 
 uint32_t policy_mgr_get_sap_mandatory_chan_list_len(
@@ -3174,6 +3179,7 @@ void  policy_mgr_init_sap_mandatory_2g_chan(struct wlan_objmgr_psoc *psoc)
 				chan_list[i];
 		}
 	}
+	policy_mgr_pcl_cache_chan_changed(pm_ctx);
 }
 
 void policy_mgr_remove_sap_mandatory_chan(struct wlan_objmgr_psoc *psoc,
@@ -3206,4 +3212,5 @@ void policy_mgr_remove_sap_mandatory_chan(struct wlan_objmgr_psoc *psoc,
 			pm_ctx->sap_mandatory_channels_len);
 	qdf_mem_copy(pm_ctx->sap_mandatory_channels, chan_list, num_chan);
 	pm_ctx->sap_mandatory_channels_len = num_chan;
+	policy_mgr_pcl_cache_chan_changed(pm_ctx);
 }
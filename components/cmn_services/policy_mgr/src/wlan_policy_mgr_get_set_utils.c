@@ -104,6 +104,7 @@ QDF_STATUS policy_mgr_set_dual_mac_feature(struct wlan_objmgr_psoc *psoc,
 	}
 
 	pm_ctx->cfg.dual_mac_feature = dual_mac_feature;
+	policy_mgr_pcl_cache_cfg_changed(pm_ctx);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -297,6 +298,7 @@ QDF_STATUS policy_mgr_set_sys_pref(struct wlan_objmgr_psoc *psoc,
 		return QDF_STATUS_E_FAILURE;
 	}
 	pm_ctx->cfg.sys_pref = sys_pref;
+	policy_mgr_pcl_cache_cfg_changed(pm_ctx);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -357,6 +359,7 @@ QDF_STATUS policy_mgr_set_ch_select_plcy(struct wlan_objmgr_psoc *psoc,
 		return QDF_STATUS_E_FAILURE;
 	}
 	pm_ctx->cfg.chnl_select_plcy = ch_select_policy;
+	policy_mgr_pcl_cache_cfg_changed(pm_ctx);
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -465,6 +468,7 @@ void policy_mgr_update_hw_mode_index(struct wlan_objmgr_psoc *psoc,
 		pm_ctx->old_hw_mode_index = pm_ctx->new_hw_mode_index;
 		pm_ctx->new_hw_mode_index = new_hw_mode_index;
 	}
+	policy_mgr_pcl_cache_conn_changed(pm_ctx);
 	policy_mgr_debug("Updated: old_hw_mode_index:%d new_hw_mode_index:%d",
 		pm_ctx->old_hw_mode_index, pm_ctx->new_hw_mode_index);
 }
@@ -685,6 +689,8 @@ QDF_STATUS policy_mgr_update_hw_mode_list(struct wlan_objmgr_psoc *psoc,
 			mac1_ss_bw_info, i, tmp->hw_mode_id, dbs_mode,
 			sbs_mode);
 	}
+	policy_mgr_pcl_cache_cfg_changed(pm_ctx);
+
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -712,6 +718,7 @@ void policy_mgr_init_dbs_hw_mode(struct wlan_objmgr_psoc *psoc,
 		ev_wlan_dbs_hw_mode_list,
 		(sizeof(*pm_ctx->hw_mode.hw_mode_list) *
 		pm_ctx->num_dbs_hw_modes));
+	policy_mgr_pcl_cache_cfg_changed(pm_ctx);
 }
 
 void policy_mgr_dump_dbs_hw_mode(struct wlan_objmgr_psoc *psoc)
@@ -802,6 +809,7 @@ done:
 		pm_ctx->dual_mac_cfg.cur_scan_config;
 	pm_ctx->dual_mac_cfg.prev_fw_mode_config =
 		pm_ctx->dual_mac_cfg.cur_fw_mode_config;
+	policy_mgr_pcl_cache_cfg_changed(pm_ctx);
 
 	policy_mgr_debug("cur_scan_config:%x cur_fw_mode_config:%x",
 		pm_ctx->dual_mac_cfg.cur_scan_config,
@@ -838,6 +846,7 @@ void policy_mgr_update_dbs_fw_config(struct wlan_objmgr_psoc *psoc)
 		pm_ctx->dual_mac_cfg.cur_fw_mode_config;
 	pm_ctx->dual_mac_cfg.cur_fw_mode_config =
 		pm_ctx->dual_mac_cfg.req_fw_mode_config;
+	policy_mgr_pcl_cache_cfg_changed(pm_ctx);
 }
 
 void policy_mgr_update_dbs_req_config(struct wlan_objmgr_psoc *psoc,
@@ -1955,6 +1964,7 @@ QDF_STATUS policy_mgr_decr_connection_count(struct wlan_objmgr_psoc *psoc,
 	/* clean up the entry */
 	qdf_mem_zero(&pm_conc_connection_list[next_conn_index - 1],
 		sizeof(*pm_conc_connection_list));
+	policy_mgr_pcl_cache_conn_changed(pm_ctx);
 	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
 
 	return QDF_STATUS_SUCCESS;
@@ -2519,6 +2529,7 @@ QDF_STATUS policy_mgr_set_user_cfg(struct wlan_objmgr_psoc *psoc,
 	}
 
 	pm_ctx->user_cfg = *user_cfg;
+	policy_mgr_pcl_cache_conn_changed(pm_ctx);
 	policy_mgr_debug("dbs_selection_plcy 0x%x",
 			 pm_ctx->cfg.dbs_selection_plcy);
 	policy_mgr_debug("vdev_priority_list 0x%x",
@@ -3099,6 +3110,11 @@ void policy_mgr_dump_connection_status_info(struct wlan_objmgr_psoc *psoc)
 				pm_conc_connection_list[i].bw);
 	}
 	qdf_mutex_release(&pm_ctx->qdf_conc_list_lock);
+
+	qdf_spin_lock_bh(&pm_ctx->pcl_cache.lock);
+	policy_mgr_debug("PCL cache hits:%u misses:%u",
+			 pm_ctx->pcl_cache.hits, pm_ctx->pcl_cache.misses);
+	qdf_spin_unlock_bh(&pm_ctx->pcl_cache.lock);
 }
 
 bool policy_mgr_is_any_mode_active_on_band_along_with_session(
@@ -3523,6 +3539,7 @@ void policy_mgr_set_cur_conc_system_pref(struct wlan_objmgr_psoc *psoc,
 
 	policy_mgr_debug("conc_system_pref %hu", conc_system_pref);
 	pm_ctx->cur_conc_system_pref = conc_system_pref;
+	policy_mgr_pcl_cache_conn_changed(pm_ctx);
 }
 
 uint8_t policy_mgr_get_cur_conc_system_pref(struct wlan_objmgr_psoc *psoc)
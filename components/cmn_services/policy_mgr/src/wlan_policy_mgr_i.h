@@ -23,6 +23,7 @@
 #include "qdf_event.h"
 #include "qdf_mc_timer.h"
 #include "qdf_lock.h"
+#include "qdf_atomic.h"
 #include "qdf_defer.h"
 #include "wlan_reg_services_api.h"
 
@@ -211,6 +212,115 @@ extern enum policy_mgr_conc_next_action
 	(*policy_mgr_get_current_pref_hw_mode_ptr)
 	(struct wlan_objmgr_psoc *psoc);
 
+/*
+ * Packed form of the PCL and next action tables. A PCL row holds the PCL
+ * type of every system preference, PM_PACKED_PCL_BITS each, and identical
+ * rows are stored only once. A next action entry holds the action of both
+ * bands, PM_PACKED_ACTION_BITS each.
+ */
+#define PM_PACKED_PCL_BITS		5
+#define PM_PACKED_PCL_MASK		((1 << PM_PACKED_PCL_BITS) - 1)
+#define PM_PACKED_PCL_MAX_ROWS		256
+#define PM_PACKED_ACTION_BITS		4
+#define PM_PACKED_ACTION_MASK		((1 << PM_PACKED_ACTION_BITS) - 1)
+
+/**
+ * struct policy_mgr_packed_pcl_table - Deduplicated, bit packed PCL table
+ * @valid: table is packed, else the original table has to be used
+ * @num_rows: number of unique rows in @rows
+ * @rows: unique rows, PCL type of system preference n at bit
+ *        n * PM_PACKED_PCL_BITS
+ * @row_idx: index into @rows of [connection index][new connection mode]
+ */
+struct policy_mgr_packed_pcl_table {
+	bool valid;
+	uint16_t num_rows;
+	uint16_t rows[PM_PACKED_PCL_MAX_ROWS];
+	uint8_t row_idx[PM_MAX_TWO_CONNECTION_MODE][PM_MAX_NUM_OF_MODE];
+};
+
+/**
+ * struct policy_mgr_packed_action_table - Bit packed next action table
+ * @valid: table is packed, else the original table has to be used
+ * @action: next action of band n at bit n * PM_PACKED_ACTION_BITS
+ */
+struct policy_mgr_packed_action_table {
+	bool valid;
+	uint8_t action[PM_MAX_TWO_CONNECTION_MODE];
+};
+
+/**
+ * struct policy_mgr_packed_tables - Packed form of the concurrency tables
+ * @second_pcl: second connection PCL table, indexed by DBS capability
+ * @third_pcl: third connection PCL table, indexed by DBS capability
+ * @next_action_two: next_action_two_connection_table
+ * @next_action_three: next_action_three_connection_table
+ * @next_action_two_2g_1x1_5g: next_action_two_connection_2x2_2g_1x1_5g_table
+ * @next_action_three_2g_1x1_5g:
+ *	next_action_three_connection_2x2_2g_1x1_5g_table
+ *
+ * Built from the tables selected for the HW capability every time policy
+ * manager is enabled, see policy_mgr_packed_tables_init().
+ */
+struct policy_mgr_packed_tables {
+	struct policy_mgr_packed_pcl_table second_pcl[2];
+	struct policy_mgr_packed_pcl_table third_pcl[2];
+	struct policy_mgr_packed_action_table next_action_two;
+	struct policy_mgr_packed_action_table next_action_three;
+	struct policy_mgr_packed_action_table next_action_two_2g_1x1_5g;
+	struct policy_mgr_packed_action_table next_action_three_2g_1x1_5g;
+};
+
+extern struct policy_mgr_packed_tables pm_packed_tables;
+
+/**
+ * policy_mgr_packed_pcl_get() - Look up a packed PCL table
+ * @table: packed table
+ * @idx: connection index of the table
+ * @mode: new connection mode
+ * @sys_pref: system preference
+ *
+ * Return: PCL type
+ */
+static inline enum policy_mgr_pcl_type
+policy_mgr_packed_pcl_get(const struct policy_mgr_packed_pcl_table *table,
+			  uint32_t idx, enum policy_mgr_con_mode mode,
+			  enum policy_mgr_conc_priority_mode sys_pref)
+{
+	uint16_t row = table->rows[table->row_idx[idx][mode]];
+
+	return (row >> (sys_pref * PM_PACKED_PCL_BITS)) & PM_PACKED_PCL_MASK;
+}
+
+/**
+ * policy_mgr_packed_action_get() - Look up a packed next action table
+ * @table: packed table
+ * @idx: connection index of the table
+ * @band: band of the new connection
+ *
+ * Return: next action
+ */
+static inline enum policy_mgr_conc_next_action
+policy_mgr_packed_action_get(
+		const struct policy_mgr_packed_action_table *table,
+		uint32_t idx, enum policy_mgr_band band)
+{
+	return (table->action[idx] >> (band * PM_PACKED_ACTION_BITS)) &
+		PM_PACKED_ACTION_MASK;
+}
+
+/**
+ * policy_mgr_packed_tables_init() - Build the packed concurrency tables
+ *
+ * Must be called after the table pointers are selected for the HW
+ * capability and after any runtime overwrite of those tables. A table
+ * which cannot be packed is left invalid and its lookups fall back to the
+ * original table.
+ *
+ * Return: None
+ */
+void policy_mgr_packed_tables_init(void);
+
 /**
  * struct sta_ap_intf_check_work_ctx - sta_ap_intf_check_work
  * related info
@@ -268,6 +378,52 @@ struct policy_mgr_cfg {
 	uint8_t go_force_scc;
 };
 
+/**
+ * struct policy_mgr_pcl_cache_entry - Memoized PCL of one connection mode
+ * @valid: entry holds a PCL
+ * @conn_gen: connection table generation the PCL was computed for
+ * @chan_gen: regulatory/NOL/unsafe channel generation the PCL was
+ *            computed for
+ * @weight_len: weight list length requested by the caller
+ * @len: number of channels in @pcl_channels
+ * @pcl_channels: PCL before the DNBS filtering
+ * @pcl_weight: weights of @pcl_channels
+ */
+struct policy_mgr_pcl_cache_entry {
+	bool valid;
+	uint32_t conn_gen;
+	uint32_t chan_gen;
+	uint32_t weight_len;
+	uint32_t len;
+	uint8_t pcl_channels[QDF_MAX_NUM_CHAN];
+	uint8_t pcl_weight[QDF_MAX_NUM_CHAN];
+};
+
+/**
+ * struct policy_mgr_pcl_cache - PCL cache of policy manager
+ * @lock: protects @entry and the counters
+ * @conn_gen: bumped whenever the connection table, HW mode or the
+ *            concurrency system preference changes
+ * @chan_gen: bumped whenever the regulatory channel list, NOL, unsafe
+ *            channel list or SAP mandatory channel list changes
+ * @entry: per connection mode cache entries
+ * @hits: number of PCL requests served from the cache
+ * @misses: number of PCL requests which had to be computed
+ *
+ * A cached PCL is only returned when both generations still match the
+ * ones it was computed for, so any of the update paths above implicitly
+ * invalidates it. The DNBS filtering depends on per vdev state outside
+ * of policy manager and is always applied on top of the cached list.
+ */
+struct policy_mgr_pcl_cache {
+	qdf_spinlock_t lock;
+	qdf_atomic_t conn_gen;
+	qdf_atomic_t chan_gen;
+	struct policy_mgr_pcl_cache_entry entry[PM_MAX_NUM_OF_MODE];
+	uint32_t hits;
+	uint32_t misses;
+};
+
 /**
  * struct policy_mgr_psoc_priv_obj - Policy manager private data
  * @psoc: pointer to PSOC object information
@@ -318,6 +474,7 @@ struct policy_mgr_cfg {
  * @opportunistic_update_done_evt: qdf event to synchronize host
  *                               & FW HW mode
  * @dynamic_mcc_adaptive_sched: disable/enable mcc adaptive scheduler feature
+ * @pcl_cache: memoized PCL per connection mode
  */
 struct policy_mgr_psoc_priv_obj {
 	struct wlan_objmgr_psoc *psoc;
@@ -356,6 +513,7 @@ struct policy_mgr_psoc_priv_obj {
 	uint32_t user_config_sap_channel;
 	struct policy_mgr_cfg cfg;
 	bool dynamic_mcc_adaptive_sched;
+	struct policy_mgr_pcl_cache pcl_cache;
 };
 
 /**
@@ -375,6 +533,45 @@ struct policy_mgr_mac_ss_bw_info {
 
 struct policy_mgr_psoc_priv_obj *policy_mgr_get_context(
 		struct wlan_objmgr_psoc *psoc);
+/**
+ * policy_mgr_pcl_cache_conn_changed() - Invalidate the PCL cache after a
+ * connection table change
+ * @pm_ctx: policy manager context
+ *
+ * Return: None
+ */
+static inline void
+policy_mgr_pcl_cache_conn_changed(struct policy_mgr_psoc_priv_obj *pm_ctx)
+{
+	qdf_atomic_inc(&pm_ctx->pcl_cache.conn_gen);
+}
+
+/**
+ * policy_mgr_pcl_cache_cfg_changed() - Invalidate the PCL cache after a
+ * change of the DBS capability or of a concurrency policy the PCL reads
+ * @pm_ctx: policy manager context
+ *
+ * Return: None
+ */
+static inline void
+policy_mgr_pcl_cache_cfg_changed(struct policy_mgr_psoc_priv_obj *pm_ctx)
+{
+	qdf_atomic_inc(&pm_ctx->pcl_cache.conn_gen);
+}
+
+/**
+ * policy_mgr_pcl_cache_chan_changed() - Invalidate the PCL cache after a
+ * regulatory, NOL or unsafe channel change
+ * @pm_ctx: policy manager context
+ *
+ * Return: None
+ */
+static inline void
+policy_mgr_pcl_cache_chan_changed(struct policy_mgr_psoc_priv_obj *pm_ctx)
+{
+	qdf_atomic_inc(&pm_ctx->pcl_cache.chan_gen);
+}
+
 QDF_STATUS policy_mgr_get_updated_scan_config(
 		struct wlan_objmgr_psoc *psoc,
 		uint32_t *scan_config,
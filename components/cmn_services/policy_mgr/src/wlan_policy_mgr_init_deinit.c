@@ -331,9 +331,12 @@ QDF_STATUS policy_mgr_psoc_open(struct wlan_objmgr_psoc *psoc)
 		return QDF_STATUS_E_FAILURE;
 	}
 
+	qdf_spinlock_create(&pm_ctx->pcl_cache.lock);
+
 	pm_ctx->sta_ap_intf_check_work_info = qdf_mem_malloc(
 		sizeof(struct sta_ap_intf_check_work_ctx));
 	if (!pm_ctx->sta_ap_intf_check_work_info) {
+		qdf_spinlock_destroy(&pm_ctx->pcl_cache.lock);
 		qdf_mutex_destroy(&pm_ctx->qdf_conc_list_lock);
 		policy_mgr_err("Failed to alloc sta_ap_intf_check_work_info");
 		return QDF_STATUS_E_FAILURE;
@@ -363,6 +366,8 @@ QDF_STATUS policy_mgr_psoc_close(struct wlan_objmgr_psoc *psoc)
 		return QDF_STATUS_E_FAILURE;
 	}
 
+	qdf_spinlock_destroy(&pm_ctx->pcl_cache.lock);
+
 	if (pm_ctx->hw_mode.hw_mode_list) {
 		qdf_mem_free(pm_ctx->hw_mode.hw_mode_list);
 		pm_ctx->hw_mode.hw_mode_list = NULL;
@@ -525,6 +530,12 @@ QDF_STATUS policy_mgr_psoc_enable(struct wlan_objmgr_psoc *psoc)
 		next_action_three_connection_table =
 		&pm_next_action_three_connection_dbs_1x1_table;
 	}
+
+	policy_mgr_packed_tables_init();
+
+	/* PCL tables changed, drop whatever was memoized before */
+	policy_mgr_pcl_cache_invalidate(psoc);
+
 	policy_mgr_debug("is DBS Capable %d, is SBS Capable %d",
 			 policy_mgr_is_hw_dbs_capable(psoc),
 			 policy_mgr_is_hw_sbs_capable(psoc));
@@ -31,6 +31,7 @@
 #include "qdf_types.h"
 #include "qdf_trace.h"
 #include "qdf_str.h"
+#include "qdf_time.h"
 #include "wlan_objmgr_global_obj.h"
 #include "wlan_utility.h"
 #include "wlan_mlme_ucfg_api.h"
@@ -64,6 +65,374 @@ policy_mgr_next_action_two_connection_table_type
 policy_mgr_next_action_three_connection_table_type
 		*next_action_three_connection_2x2_2g_1x1_5g_table;
 
+struct policy_mgr_packed_tables pm_packed_tables;
+
+/**
+ * policy_mgr_pack_pcl_table() - Build a packed PCL table
+ * @packed: packed table to build
+ * @table: first element of the [idx][mode][sys_pref] PCL table
+ * @num_idx: number of connection indexes of @table
+ *
+ * Return: None
+ */
+static void
+policy_mgr_pack_pcl_table(struct policy_mgr_packed_pcl_table *packed,
+			  const enum policy_mgr_pcl_type *table,
+			  uint32_t num_idx)
+{
+	uint32_t idx, mode, pref, row_id;
+	uint16_t row;
+
+	qdf_mem_zero(packed, sizeof(*packed));
+	if (!table || num_idx > PM_MAX_TWO_CONNECTION_MODE)
+		return;
+
+	for (idx = 0; idx < num_idx; idx++) {
+		for (mode = 0; mode < PM_MAX_NUM_OF_MODE; mode++) {
+			row = 0;
+			for (pref = 0; pref < PM_MAX_CONC_PRIORITY_MODE;
+			     pref++, table++)
+				row |= *table << (pref * PM_PACKED_PCL_BITS);
+
+			for (row_id = 0; row_id < packed->num_rows; row_id++)
+				if (packed->rows[row_id] == row)
+					break;
+
+			if (row_id == packed->num_rows) {
+				if (row_id == PM_PACKED_PCL_MAX_ROWS) {
+					policy_mgr_err("PCL table has too many unique rows");
+					return;
+				}
+				packed->rows[packed->num_rows++] = row;
+			}
+			packed->row_idx[idx][mode] = row_id;
+		}
+	}
+
+	packed->valid = true;
+}
+
+/**
+ * policy_mgr_pack_action_table() - Build a packed next action table
+ * @packed: packed table to build
+ * @table: first element of the [idx][band] next action table
+ * @num_idx: number of connection indexes of @table
+ *
+ * Return: None
+ */
+static void
+policy_mgr_pack_action_table(struct policy_mgr_packed_action_table *packed,
+			     const enum policy_mgr_conc_next_action *table,
+			     uint32_t num_idx)
+{
+	uint32_t idx, band;
+
+	qdf_mem_zero(packed, sizeof(*packed));
+	if (!table || num_idx > PM_MAX_TWO_CONNECTION_MODE)
+		return;
+
+	for (idx = 0; idx < num_idx; idx++)
+		for (band = 0; band < POLICY_MGR_MAX_BAND; band++, table++)
+			packed->action[idx] |=
+				*table << (band * PM_PACKED_ACTION_BITS);
+
+	packed->valid = true;
+}
+
+void policy_mgr_packed_tables_init(void)
+{
+	struct policy_mgr_packed_tables *packed = &pm_packed_tables;
+
+	BUILD_BUG_ON(PM_MAX_PCL_TYPE > PM_PACKED_PCL_MASK);
+	BUILD_BUG_ON(PM_MAX_CONC_PRIORITY_MODE * PM_PACKED_PCL_BITS > 16);
+	BUILD_BUG_ON(PM_MAX_CONC_NEXT_ACTION - 1 > PM_PACKED_ACTION_MASK);
+	BUILD_BUG_ON(POLICY_MGR_MAX_BAND * PM_PACKED_ACTION_BITS > 8);
+
+	policy_mgr_pack_pcl_table(&packed->second_pcl[false],
+				  &second_connection_pcl_nodbs_table[0][0][0],
+				  PM_MAX_ONE_CONNECTION_MODE);
+	policy_mgr_pack_pcl_table(&packed->second_pcl[true],
+				  second_connection_pcl_dbs_table ?
+				  &(*second_connection_pcl_dbs_table)[0][0][0] :
+				  NULL,
+				  PM_MAX_ONE_CONNECTION_MODE);
+	policy_mgr_pack_pcl_table(&packed->third_pcl[false],
+				  &third_connection_pcl_nodbs_table[0][0][0],
+				  PM_MAX_TWO_CONNECTION_MODE);
+	policy_mgr_pack_pcl_table(&packed->third_pcl[true],
+				  third_connection_pcl_dbs_table ?
+				  &(*third_connection_pcl_dbs_table)[0][0][0] :
+				  NULL,
+				  PM_MAX_TWO_CONNECTION_MODE);
+
+	policy_mgr_pack_action_table(&packed->next_action_two,
+				     next_action_two_connection_table ?
+				     &(*next_action_two_connection_table)[0][0] :
+				     NULL,
+				     PM_MAX_ONE_CONNECTION_MODE);
+	policy_mgr_pack_action_table(&packed->next_action_three,
+				     next_action_three_connection_table ?
+				     &(*next_action_three_connection_table)[0][0] :
+				     NULL,
+				     PM_MAX_TWO_CONNECTION_MODE);
+	policy_mgr_pack_action_table(&packed->next_action_two_2g_1x1_5g,
+		next_action_two_connection_2x2_2g_1x1_5g_table ?
+		&(*next_action_two_connection_2x2_2g_1x1_5g_table)[0][0] :
+		NULL,
+		PM_MAX_ONE_CONNECTION_MODE);
+	policy_mgr_pack_action_table(&packed->next_action_three_2g_1x1_5g,
+		next_action_three_connection_2x2_2g_1x1_5g_table ?
+		&(*next_action_three_connection_2x2_2g_1x1_5g_table)[0][0] :
+		NULL,
+		PM_MAX_TWO_CONNECTION_MODE);
+
+	policy_mgr_debug("packed PCL rows: 2nd %u/%u 3rd %u/%u (nodbs/dbs)",
+			 packed->second_pcl[false].num_rows,
+			 packed->second_pcl[true].num_rows,
+			 packed->third_pcl[false].num_rows,
+			 packed->third_pcl[true].num_rows);
+}
+
+#ifdef MPC_UT_FRAMEWORK
+/**
+ * policy_mgr_packed_action_ut() - Compare a next action table with its
+ * packed form
+ * @table: first element of the [idx][band] next action table
+ * @packed: packed table
+ * @num_idx: number of connection indexes of @table
+ * @result: result to update
+ *
+ * Return: None
+ */
+static void
+policy_mgr_packed_action_ut(const enum policy_mgr_conc_next_action *table,
+			    const struct policy_mgr_packed_action_table *packed,
+			    uint32_t num_idx,
+			    struct policy_mgr_packed_tables_ut_result *result)
+{
+	uint32_t idx, band;
+
+	if (!table)
+		return;
+
+	result->orig_size += num_idx * POLICY_MGR_MAX_BAND * sizeof(*table);
+	for (idx = 0; idx < num_idx; idx++) {
+		for (band = 0; band < POLICY_MGR_MAX_BAND; band++, table++) {
+			result->num_lookups++;
+			if (!packed->valid ||
+			    policy_mgr_packed_action_get(packed, idx, band) !=
+			    *table) {
+				policy_mgr_err("next action mismatch idx %d band %d",
+					       idx, band);
+				result->num_mismatch++;
+			}
+		}
+	}
+}
+
+#define PM_UT_PCL_ROW (PM_MAX_NUM_OF_MODE * PM_MAX_CONC_PRIORITY_MODE)
+
+/**
+ * policy_mgr_packed_pcl_ut() - Compare a PCL table with its packed form
+ * @second: second connection table, else third connection table
+ * @dbs: DBS table, else non DBS table
+ * @result: result to update
+ *
+ * Return: None
+ */
+static void
+policy_mgr_packed_pcl_ut(bool second, bool dbs,
+			 struct policy_mgr_packed_tables_ut_result *result)
+{
+	const struct policy_mgr_packed_pcl_table *packed;
+	enum policy_mgr_pcl_type orig;
+	uint32_t i, num, idx, mode, pref;
+
+	packed = second ? &pm_packed_tables.second_pcl[dbs] :
+			  &pm_packed_tables.third_pcl[dbs];
+	num = (second ? PM_MAX_ONE_CONNECTION_MODE :
+			PM_MAX_TWO_CONNECTION_MODE) * PM_UT_PCL_ROW;
+
+	for (i = 0; i < num; i++) {
+		idx = i / PM_UT_PCL_ROW;
+		mode = (i / PM_MAX_CONC_PRIORITY_MODE) % PM_MAX_NUM_OF_MODE;
+		pref = i % PM_MAX_CONC_PRIORITY_MODE;
+		if (second)
+			orig = policy_mgr_get_pcl_from_second_conn_table(
+					idx, mode, pref, dbs);
+		else
+			orig = policy_mgr_get_pcl_from_third_conn_table(
+					idx, mode, pref, dbs);
+
+		result->num_lookups++;
+		if (orig == policy_mgr_packed_pcl_get(packed, idx, mode, pref))
+			continue;
+
+		policy_mgr_err("%s PCL mismatch idx %d mode %d pref %d dbs %d",
+			       second ? "2nd" : "3rd", idx, mode, pref, dbs);
+		result->num_mismatch++;
+	}
+}
+
+/**
+ * policy_mgr_pcl_lookup_pass() - Look up every third connection PCL entry
+ * @packed: use the packed tables instead of the original ones
+ *
+ * Return: sum of the PCL types, to keep the lookups from being optimized
+ */
+static uint32_t policy_mgr_pcl_lookup_pass(bool packed)
+{
+	const struct policy_mgr_packed_pcl_table *table;
+	uint32_t i, idx, mode, pref, dbs, sum = 0;
+
+	for (dbs = 0; dbs < 2; dbs++) {
+		table = &pm_packed_tables.third_pcl[dbs];
+		for (i = 0; i < PM_MAX_TWO_CONNECTION_MODE * PM_UT_PCL_ROW;
+		     i++) {
+			idx = i / PM_UT_PCL_ROW;
+			mode = (i / PM_MAX_CONC_PRIORITY_MODE) %
+				PM_MAX_NUM_OF_MODE;
+			pref = i % PM_MAX_CONC_PRIORITY_MODE;
+			if (packed)
+				sum += policy_mgr_packed_pcl_get(table, idx,
+								 mode, pref);
+			else if (dbs)
+				sum += (*third_connection_pcl_dbs_table)
+						[idx][mode][pref];
+			else
+				sum += third_connection_pcl_nodbs_table
+						[idx][mode][pref];
+		}
+	}
+
+	return sum;
+}
+
+QDF_STATUS
+policy_mgr_packed_tables_ut(uint32_t iterations,
+			    struct policy_mgr_packed_tables_ut_result *result)
+{
+	struct policy_mgr_packed_tables *packed = &pm_packed_tables;
+	uint32_t dbs, i;
+	volatile uint32_t sink = 0;
+	uint64_t start_us;
+
+	qdf_mem_zero(result, sizeof(*result));
+	if (!second_connection_pcl_dbs_table ||
+	    !third_connection_pcl_dbs_table ||
+	    !packed->second_pcl[true].valid || !packed->third_pcl[true].valid ||
+	    !packed->second_pcl[false].valid ||
+	    !packed->third_pcl[false].valid) {
+		policy_mgr_err("PCL tables are not initialized or not packed");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	for (dbs = 0; dbs < 2; dbs++) {
+		policy_mgr_packed_pcl_ut(true, dbs, result);
+		policy_mgr_packed_pcl_ut(false, dbs, result);
+	}
+
+	result->orig_size = sizeof(second_connection_pcl_nodbs_table) +
+			    sizeof(*second_connection_pcl_dbs_table) +
+			    sizeof(third_connection_pcl_nodbs_table) +
+			    sizeof(*third_connection_pcl_dbs_table);
+
+	if (next_action_two_connection_table)
+		policy_mgr_packed_action_ut(
+			&(*next_action_two_connection_table)[0][0],
+			&packed->next_action_two,
+			PM_MAX_ONE_CONNECTION_MODE, result);
+	if (next_action_three_connection_table)
+		policy_mgr_packed_action_ut(
+			&(*next_action_three_connection_table)[0][0],
+			&packed->next_action_three,
+			PM_MAX_TWO_CONNECTION_MODE, result);
+	if (next_action_two_connection_2x2_2g_1x1_5g_table)
+		policy_mgr_packed_action_ut(
+			&(*next_action_two_connection_2x2_2g_1x1_5g_table)[0][0],
+			&packed->next_action_two_2g_1x1_5g,
+			PM_MAX_ONE_CONNECTION_MODE, result);
+	if (next_action_three_connection_2x2_2g_1x1_5g_table)
+		policy_mgr_packed_action_ut(
+			&(*next_action_three_connection_2x2_2g_1x1_5g_table)[0][0],
+			&packed->next_action_three_2g_1x1_5g,
+			PM_MAX_TWO_CONNECTION_MODE, result);
+	result->packed_size = sizeof(*packed);
+
+	start_us = qdf_get_log_timestamp_usecs();
+	for (i = 0; i < iterations; i++)
+		sink += policy_mgr_pcl_lookup_pass(false);
+	result->orig_lookup_us = qdf_get_log_timestamp_usecs() - start_us;
+
+	start_us = qdf_get_log_timestamp_usecs();
+	for (i = 0; i < iterations; i++)
+		sink += policy_mgr_pcl_lookup_pass(true);
+	result->packed_lookup_us = qdf_get_log_timestamp_usecs() - start_us;
+
+	policy_mgr_debug("lookups %u mismatch %u orig %llu us packed %llu us orig size %u packed size %u sum %u",
+			 result->num_lookups, result->num_mismatch,
+			 result->orig_lookup_us, result->packed_lookup_us,
+			 result->orig_size, result->packed_size, sink);
+
+	return result->num_mismatch ? QDF_STATUS_E_FAILURE :
+				      QDF_STATUS_SUCCESS;
+}
+#endif
+
+/**
+ * policy_mgr_second_conn_pcl() - Get PCL type for a second connection
+ * @idx: index of the existing connection
+ * @mode: new connection mode
+ * @sys_pref: system preference
+ * @dbs: use the DBS table
+ *
+ * Return: PCL type
+ */
+static enum policy_mgr_pcl_type
+policy_mgr_second_conn_pcl(enum policy_mgr_one_connection_mode idx,
+			   enum policy_mgr_con_mode mode,
+			   enum policy_mgr_conc_priority_mode sys_pref,
+			   bool dbs)
+{
+	const struct policy_mgr_packed_pcl_table *packed =
+				&pm_packed_tables.second_pcl[dbs];
+
+	if (qdf_likely(packed->valid))
+		return policy_mgr_packed_pcl_get(packed, idx, mode, sys_pref);
+
+	if (dbs)
+		return (*second_connection_pcl_dbs_table)[idx][mode][sys_pref];
+
+	return second_connection_pcl_nodbs_table[idx][mode][sys_pref];
+}
+
+/**
+ * policy_mgr_third_conn_pcl() - Get PCL type for a third connection
+ * @idx: index of the two existing connections
+ * @mode: new connection mode
+ * @sys_pref: system preference
+ * @dbs: use the DBS table
+ *
+ * Return: PCL type
+ */
+static enum policy_mgr_pcl_type
+policy_mgr_third_conn_pcl(enum policy_mgr_two_connection_mode idx,
+			  enum policy_mgr_con_mode mode,
+			  enum policy_mgr_conc_priority_mode sys_pref,
+			  bool dbs)
+{
+	const struct policy_mgr_packed_pcl_table *packed =
+				&pm_packed_tables.third_pcl[dbs];
+
+	if (qdf_likely(packed->valid))
+		return policy_mgr_packed_pcl_get(packed, idx, mode, sys_pref);
+
+	if (dbs)
+		return (*third_connection_pcl_dbs_table)[idx][mode][sys_pref];
+
+	return third_connection_pcl_nodbs_table[idx][mode][sys_pref];
+}
+
 QDF_STATUS policy_mgr_get_pcl_for_existing_conn(struct wlan_objmgr_psoc *psoc,
 		enum policy_mgr_con_mode mode,
 		uint8_t *pcl_ch, uint32_t *len,
@@ -154,6 +523,9 @@ void policy_mgr_reg_chan_change_callback(struct wlan_objmgr_psoc *psoc,
 		return;
 	}
 
+	/* Valid channels, NOL or the unsafe channels may have changed */
+	policy_mgr_pcl_cache_chan_changed(pm_ctx);
+
 	if (!avoid_freq_ind) {
 		policy_mgr_debug("avoid_freq_ind NULL");
 		return;
@@ -194,6 +566,7 @@ QDF_STATUS policy_mgr_init_chan_avoidance(struct wlan_objmgr_psoc *psoc,
 
 	for (i = 0; i < pm_ctx->unsafe_channel_count; i++)
 		pm_ctx->unsafe_channel_list[i] = chan_list[i];
+	policy_mgr_pcl_cache_chan_changed(pm_ctx);
 
 	policy_mgr_debug("Channel list init, received %d avoided channels",
 			 pm_ctx->unsafe_channel_count);
@@ -669,6 +1042,101 @@ static QDF_STATUS policy_mgr_mode_specific_modification_on_pcl(
 	return status;
 }
 
+/**
+ * policy_mgr_pcl_cache_lookup() - Fetch a memoized PCL
+ * @pm_ctx: policy manager context
+ * @mode: connection mode
+ * @conn_gen: current connection table generation
+ * @chan_gen: current channel list generation
+ * @pcl_channels: buffer to fill the PCL channels in
+ * @len: filled with the number of PCL channels
+ * @pcl_weight: buffer to fill the PCL weights in
+ * @weight_len: length of @pcl_weight
+ *
+ * Return: true if the PCL was served from the cache
+ */
+static bool
+policy_mgr_pcl_cache_lookup(struct policy_mgr_psoc_priv_obj *pm_ctx,
+			    enum policy_mgr_con_mode mode,
+			    uint32_t conn_gen, uint32_t chan_gen,
+			    uint8_t *pcl_channels, uint32_t *len,
+			    uint8_t *pcl_weight, uint32_t weight_len)
+{
+	struct policy_mgr_pcl_cache *cache = &pm_ctx->pcl_cache;
+	struct policy_mgr_pcl_cache_entry *entry = &cache->entry[mode];
+	bool hit;
+
+	qdf_spin_lock_bh(&cache->lock);
+	hit = entry->valid && entry->conn_gen == conn_gen &&
+	      entry->chan_gen == chan_gen && entry->weight_len == weight_len;
+	if (hit) {
+		qdf_mem_copy(pcl_channels, entry->pcl_channels, entry->len);
+		qdf_mem_copy(pcl_weight, entry->pcl_weight,
+			     QDF_MIN(entry->len, weight_len));
+		*len = entry->len;
+		cache->hits++;
+	} else {
+		cache->misses++;
+	}
+	qdf_spin_unlock_bh(&cache->lock);
+
+	return hit;
+}
+
+/**
+ * policy_mgr_pcl_cache_store() - Memoize a computed PCL
+ * @pm_ctx: policy manager context
+ * @mode: connection mode
+ * @conn_gen: connection table generation sampled before the computation
+ * @chan_gen: channel list generation sampled before the computation
+ * @pcl_channels: PCL channels
+ * @len: number of PCL channels
+ * @pcl_weight: PCL weights
+ * @weight_len: length of @pcl_weight
+ *
+ * The generations are sampled before the PCL is computed, so a PCL which
+ * raced with an update is stored stale and never matches a lookup.
+ *
+ * Return: None
+ */
+static void
+policy_mgr_pcl_cache_store(struct policy_mgr_psoc_priv_obj *pm_ctx,
+			   enum policy_mgr_con_mode mode,
+			   uint32_t conn_gen, uint32_t chan_gen,
+			   uint8_t *pcl_channels, uint32_t len,
+			   uint8_t *pcl_weight, uint32_t weight_len)
+{
+	struct policy_mgr_pcl_cache *cache = &pm_ctx->pcl_cache;
+	struct policy_mgr_pcl_cache_entry *entry = &cache->entry[mode];
+
+	if (len > QDF_MAX_NUM_CHAN || weight_len > QDF_MAX_NUM_CHAN)
+		return;
+
+	qdf_spin_lock_bh(&cache->lock);
+	qdf_mem_copy(entry->pcl_channels, pcl_channels, len);
+	qdf_mem_copy(entry->pcl_weight, pcl_weight, QDF_MIN(len, weight_len));
+	entry->len = len;
+	entry->weight_len = weight_len;
+	entry->conn_gen = conn_gen;
+	entry->chan_gen = chan_gen;
+	entry->valid = true;
+	qdf_spin_unlock_bh(&cache->lock);
+}
+
+void policy_mgr_pcl_cache_invalidate(struct wlan_objmgr_psoc *psoc)
+{
+	struct policy_mgr_psoc_priv_obj *pm_ctx;
+
+	pm_ctx = policy_mgr_get_context(psoc);
+	if (!pm_ctx) {
+		policy_mgr_err("Invalid Context");
+		return;
+	}
+
+	policy_mgr_pcl_cache_conn_changed(pm_ctx);
+	policy_mgr_pcl_cache_chan_changed(pm_ctx);
+}
+
 QDF_STATUS policy_mgr_get_pcl(struct wlan_objmgr_psoc *psoc,
 			enum policy_mgr_con_mode mode,
 			uint8_t *pcl_channels, uint32_t *len,
@@ -683,6 +1151,7 @@ QDF_STATUS policy_mgr_get_pcl(struct wlan_objmgr_psoc *psoc,
 	enum policy_mgr_conc_priority_mode conc_system_pref = 0;
 	struct policy_mgr_psoc_priv_obj *pm_ctx;
 	enum QDF_OPMODE qdf_mode;
+	uint32_t conn_gen, chan_gen;
 	pm_ctx = policy_mgr_get_context(psoc);
 	if (!pm_ctx) {
 		policy_mgr_err("context is NULL");
@@ -694,6 +1163,13 @@ QDF_STATUS policy_mgr_get_pcl(struct wlan_objmgr_psoc *psoc,
 		return status;
 	}
 
+	conn_gen = qdf_atomic_read(&pm_ctx->pcl_cache.conn_gen);
+	chan_gen = qdf_atomic_read(&pm_ctx->pcl_cache.chan_gen);
+	if (policy_mgr_pcl_cache_lookup(pm_ctx, mode, conn_gen, chan_gen,
+					pcl_channels, len,
+					pcl_weight, weight_len))
+		goto dnbs;
+
 	/* find the current connection state from pm_conc_connection_list*/
 	num_connections = policy_mgr_get_connection_count(psoc);
 	policy_mgr_debug("connections:%d pref:%d requested mode:%d",
@@ -732,15 +1208,11 @@ QDF_STATUS policy_mgr_get_pcl(struct wlan_objmgr_psoc *psoc,
 		if (qdf_mode == QDF_MAX_NO_OF_MODE)
 			return status;
 
-		if (policy_mgr_is_hw_dbs_capable(psoc) == true &&
-		    policy_mgr_is_dbs_allowed_for_concurrency(
-							psoc, qdf_mode)) {
-			pcl = (*second_connection_pcl_dbs_table)
-				[second_index][mode][conc_system_pref];
-		} else {
-			pcl = second_connection_pcl_nodbs_table
-				[second_index][mode][conc_system_pref];
-		}
+		pcl = policy_mgr_second_conn_pcl(
+			second_index, mode, conc_system_pref,
+			policy_mgr_is_hw_dbs_capable(psoc) &&
+			policy_mgr_is_dbs_allowed_for_concurrency(psoc,
+								  qdf_mode));
 
 		break;
 	case 2:
@@ -751,13 +1223,9 @@ QDF_STATUS policy_mgr_get_pcl(struct wlan_objmgr_psoc *psoc,
 				"couldn't find index for 3rd connection pcl table");
 			return status;
 		}
-		if (policy_mgr_is_hw_dbs_capable(psoc) == true) {
-			pcl = (*third_connection_pcl_dbs_table)
-				[third_index][mode][conc_system_pref];
-		} else {
-			pcl = third_connection_pcl_nodbs_table
-				[third_index][mode][conc_system_pref];
-		}
+		pcl = policy_mgr_third_conn_pcl(
+			third_index, mode, conc_system_pref,
+			policy_mgr_is_hw_dbs_capable(psoc));
 		break;
 	default:
 		policy_mgr_err("unexpected num_connections value %d",
@@ -780,6 +1248,10 @@ QDF_STATUS policy_mgr_get_pcl(struct wlan_objmgr_psoc *psoc,
 	policy_mgr_mode_specific_modification_on_pcl(
 		psoc, pcl_channels, pcl_weight, len, mode);
 
+	policy_mgr_pcl_cache_store(pm_ctx, mode, conn_gen, chan_gen,
+				   pcl_channels, *len, pcl_weight, weight_len);
+
+dnbs:
 	status = policy_mgr_modify_pcl_based_on_dnbs(psoc, pcl_channels,
 						pcl_weight, len);
 
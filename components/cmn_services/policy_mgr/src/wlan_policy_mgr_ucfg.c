@@ -64,6 +64,8 @@ static QDF_STATUS policy_mgr_init_cfg(struct wlan_objmgr_psoc *psoc)
 		cfg_get(psoc, CFG_MARK_INDOOR_AS_DISABLE_FEATURE);
 	cfg->prefer_5g_scc_to_dbs = cfg_get(psoc, CFG_PREFER_5G_SCC_TO_DBS);
 	cfg->go_force_scc = cfg_get(psoc, CFG_P2P_GO_ENABLE_FORCE_SCC);
+	/* sta_sap_scc_on_dfs/lte_coex_chnl have no setter, only this load */
+	policy_mgr_pcl_cache_cfg_changed(pm_ctx);
 
 	return QDF_STATUS_SUCCESS;
 }
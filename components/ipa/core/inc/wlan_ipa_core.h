@@ -59,6 +59,29 @@ bool wlan_ipa_is_rt_debugging_enabled(struct wlan_ipa_config *ipa_cfg)
 					  WLAN_IPA_REAL_TIME_DEBUGGING);
 }
 
+/**
+ * wlan_ipa_latency_hist_update() - Account a wait time in a histogram
+ * @hist: histogram of WLAN_IPA_LATENCY_HIST_MAX buckets
+ * @wait_ms: wait time in ms
+ *
+ * Bucket 0 counts waits below 1 ms and bucket n counts waits in
+ * [2^(n - 1), 2^n) ms, the last bucket also counts all longer waits.
+ *
+ * Return: None
+ */
+static inline void wlan_ipa_latency_hist_update(uint64_t *hist,
+						uint32_t wait_ms)
+{
+	uint32_t bucket = 0;
+
+	while (wait_ms && bucket < WLAN_IPA_LATENCY_HIST_MAX - 1) {
+		wait_ms >>= 1;
+		bucket++;
+	}
+
+	hist[bucket]++;
+}
+
 /**
  * wlan_ipa_setup - IPA initialize and setup
  * @ipa_ctx: IPA priv obj
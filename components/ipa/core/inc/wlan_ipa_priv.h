@@ -34,6 +34,7 @@
 
 #include <qdf_net_types.h>
 #include <qdf_mc_timer.h>
+#include <qdf_timer.h>
 #include <qdf_list.h>
 #include <qdf_defer.h>
 #include "qdf_delayed_work.h"
@@ -71,6 +72,9 @@
 
 #define WLAN_IPA_MAX_PENDING_EVENT_COUNT    20
 
+/* Buckets of power of two ms, the last one collects the longer waits */
+#define WLAN_IPA_LATENCY_HIST_MAX           12
+
 #define IPA_WLAN_RX_SOFTIRQ_THRESH 32
 
 #define WLAN_IPA_UC_BW_MONITOR_LEVEL        3
@@ -266,11 +270,13 @@ struct wlan_ipa_rx_hdr {
  * @exception: Exception packet
  * @iface_context: Interface context
  * @ipa_tx_desc: IPA TX descriptor
+ * @enqueue_us: Time the packet was added to the PM queue
  */
 struct wlan_ipa_pm_tx_cb {
 	bool exception;
 	struct wlan_ipa_iface_context *iface_context;
 	qdf_ipa_rx_data_t *ipa_tx_desc;
+	uint64_t enqueue_us;
 };
 
 /**
@@ -292,6 +298,13 @@ struct wlan_ipa_sys_pipe {
  * @num_tx_err: Number of TX packet errors
  * @num_tx_cac_drop: Number of TX packet drop due to CAC
  * @num_rx_ipa_excep: Number of RX IPA exception packets
+ * @num_tx_batch: Number of TX batches submitted to TL
+ * @num_tx_batch_pkts: Number of TX packets submitted in batches
+ * @num_tx_batch_timeout: Number of TX batches flushed by the batch timer
+ * @tx_batch_max: Largest TX batch submitted
+ * @tx_batch_latency_us: Sum of the time the first packet of each batch
+ *	waited before the batch was flushed
+ * @tx_batch_latency_max_us: Largest time a batch waited before flush
  */
 struct wlan_ipa_iface_stats {
 	uint64_t num_tx;
@@ -299,6 +312,12 @@ struct wlan_ipa_iface_stats {
 	uint64_t num_tx_err;
 	uint64_t num_tx_cac_drop;
 	uint64_t num_rx_ipa_excep;
+	uint64_t num_tx_batch;
+	uint64_t num_tx_batch_pkts;
+	uint64_t num_tx_batch_timeout;
+	uint32_t tx_batch_max;
+	uint64_t tx_batch_latency_us;
+	uint64_t tx_batch_latency_max_us;
 };
 
 /* IPA private context structure */
@@ -320,6 +339,10 @@ struct wlan_ipa_priv;
  * @ifa_address: Interface address
  * @stats: Interface stats
  * @bssid: BSSID. valid only for sta iface ctx;
+ * @tx_batch_q: IPA to WLAN packets waiting to be submitted to TL as a batch,
+ *	protected by @interface_lock
+ * @tx_batch_timer: Timer bounding the time a packet waits in @tx_batch_q
+ * @tx_batch_start_us: Time the first packet of the current batch was queued
  */
 struct wlan_ipa_iface_context {
 	struct wlan_ipa_priv *ipa_ctx;
@@ -337,6 +360,9 @@ struct wlan_ipa_iface_context {
 	uint32_t ifa_address;
 	struct wlan_ipa_iface_stats stats;
 	struct qdf_mac_addr bssid;
+	qdf_nbuf_queue_t tx_batch_q;
+	qdf_timer_t tx_batch_timer;
+	uint64_t tx_batch_start_us;
 };
 
 /**
@@ -358,6 +384,13 @@ struct wlan_ipa_iface_context {
  * @num_rx_excep: Number of RX IPA exception packets
  * @num_tx_fwd_ok: Number of TX forward packet success
  * @num_tx_fwd_err: Number of TX forward packet failures
+ * @num_pm_drop_full: Number of oldest packets dropped from a full PM queue
+ * @num_pm_drop_sojourn: Number of packets dropped from the PM queue after
+ *	waiting longer than the max sojourn time
+ * @max_pm_sojourn_ms: Longest time a packet spent in the PM queue
+ * @pm_sojourn_hist: Histogram of PM queue sojourn times
+ * @max_rm_grant_wait_ms: Longest time a deferred RM grant took
+ * @rm_grant_wait_hist: Histogram of deferred RM grant wait times
  */
 struct wlan_ipa_stats {
 	uint32_t event[QDF_IPA_WLAN_EVENT_MAX];
@@ -378,6 +411,12 @@ struct wlan_ipa_stats {
 	uint64_t num_rx_excep;
 	uint64_t num_tx_fwd_ok;
 	uint64_t num_tx_fwd_err;
+	uint64_t num_pm_drop_full;
+	uint64_t num_pm_drop_sojourn;
+	uint32_t max_pm_sojourn_ms;
+	uint64_t pm_sojourn_hist[WLAN_IPA_LATENCY_HIST_MAX];
+	uint32_t max_rm_grant_wait_ms;
+	uint64_t rm_grant_wait_hist[WLAN_IPA_LATENCY_HIST_MAX];
 };
 
 /**
@@ -603,6 +642,8 @@ struct wlan_ipa_priv {
 	 * an warning if spin_lock_bh is used while IRQ is disabled
 	 */
 	qdf_spinlock_t rm_lock;
+	/* Time the pending RM grant was requested */
+	uint64_t rm_grant_req_us;
 	struct uc_rm_work_struct uc_rm_work;
 	struct uc_op_work_struct uc_op_work[WLAN_IPA_UC_OPCODE_MAX];
 	qdf_wake_lock_t wake_lock;
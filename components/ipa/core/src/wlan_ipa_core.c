@@ -184,6 +184,139 @@ struct wlan_ipa_priv *wlan_ipa_get_obj_context(void)
 	return gp_ipa;
 }
 
+/**
+ * wlan_ipa_pm_queue_free() - Free packets dropped from the PM queue
+ * @ipa_ctx: IPA context
+ * @drop_q: dropped packets, each carrying a wlan_ipa_pm_tx_cb
+ *
+ * Must be called without pm_lock held.
+ *
+ * Return: None
+ */
+static void wlan_ipa_pm_queue_free(struct wlan_ipa_priv *ipa_ctx,
+				   qdf_nbuf_queue_t *drop_q)
+{
+	struct wlan_ipa_pm_tx_cb *pm_tx_cb;
+	bool try_release = false;
+	qdf_nbuf_t skb;
+
+	while ((skb = qdf_nbuf_queue_remove(drop_q))) {
+		pm_tx_cb = (struct wlan_ipa_pm_tx_cb *)skb->cb;
+		if (pm_tx_cb->exception) {
+			dev_kfree_skb_any(skb);
+		} else {
+			ipa_free_skb(pm_tx_cb->ipa_tx_desc);
+			try_release = true;
+		}
+	}
+
+	if (try_release)
+		wlan_ipa_wdi_rm_try_release(ipa_ctx);
+}
+
+/**
+ * wlan_ipa_pm_queue_expire() - Drop packets held longer than max sojourn
+ * @ipa_ctx: IPA context
+ * @now_us: current time
+ * @drop_q: queue collecting the dropped packets
+ *
+ * The PM queue is ordered by enqueue time so only its head is checked.
+ * Must be called with pm_lock held.
+ *
+ * Return: None
+ */
+static void wlan_ipa_pm_queue_expire(struct wlan_ipa_priv *ipa_ctx,
+				     uint64_t now_us,
+				     qdf_nbuf_queue_t *drop_q)
+{
+	uint64_t max_sojourn_us;
+	struct wlan_ipa_pm_tx_cb *pm_tx_cb;
+	qdf_nbuf_t skb;
+
+	if (!ipa_ctx->config->pm_queue_max_sojourn)
+		return;
+
+	max_sojourn_us = (uint64_t)ipa_ctx->config->pm_queue_max_sojourn * 1000;
+	while ((skb = qdf_nbuf_queue_first(&ipa_ctx->pm_queue_head))) {
+		pm_tx_cb = (struct wlan_ipa_pm_tx_cb *)skb->cb;
+		if (now_us - pm_tx_cb->enqueue_us <= max_sojourn_us)
+			break;
+
+		skb = qdf_nbuf_queue_remove(&ipa_ctx->pm_queue_head);
+		qdf_nbuf_queue_add(drop_q, skb);
+		ipa_ctx->stats.num_pm_drop_sojourn++;
+	}
+}
+
+/**
+ * wlan_ipa_pm_queue_add() - Hold a packet until the host resumes
+ * @ipa_ctx: IPA context
+ * @skb: packet whose cb carries a wlan_ipa_pm_tx_cb
+ * @drop_q: queue collecting the packets dropped to bound the PM queue
+ *
+ * Packets which exceeded the max sojourn time are dropped first. If the
+ * queue is still full the oldest packet is dropped, as it is the one
+ * least likely to be useful after resume.
+ * Must be called with pm_lock held.
+ *
+ * Return: None
+ */
+static void wlan_ipa_pm_queue_add(struct wlan_ipa_priv *ipa_ctx,
+				  qdf_nbuf_t skb,
+				  qdf_nbuf_queue_t *drop_q)
+{
+	struct wlan_ipa_pm_tx_cb *pm_tx_cb;
+	uint64_t now_us = qdf_get_log_timestamp_usecs();
+	uint32_t limit = ipa_ctx->config->pm_queue_limit;
+	qdf_nbuf_t old_skb;
+
+	wlan_ipa_pm_queue_expire(ipa_ctx, now_us, drop_q);
+
+	if (limit && qdf_nbuf_queue_len(&ipa_ctx->pm_queue_head) >= limit) {
+		old_skb = qdf_nbuf_queue_remove(&ipa_ctx->pm_queue_head);
+		qdf_nbuf_queue_add(drop_q, old_skb);
+		ipa_ctx->stats.num_pm_drop_full++;
+	}
+
+	pm_tx_cb = (struct wlan_ipa_pm_tx_cb *)skb->cb;
+	pm_tx_cb->enqueue_us = now_us;
+	qdf_nbuf_queue_add(&ipa_ctx->pm_queue_head, skb);
+	ipa_ctx->stats.num_tx_queued++;
+}
+
+/**
+ * wlan_ipa_pm_queue_remove() - Take the next packet to send after resume
+ * @ipa_ctx: IPA context
+ * @drop_q: queue collecting the packets which exceeded max sojourn time
+ *
+ * Must be called with pm_lock held.
+ *
+ * Return: packet or NULL if the PM queue is empty
+ */
+static qdf_nbuf_t wlan_ipa_pm_queue_remove(struct wlan_ipa_priv *ipa_ctx,
+					   qdf_nbuf_queue_t *drop_q)
+{
+	struct wlan_ipa_pm_tx_cb *pm_tx_cb;
+	uint64_t now_us = qdf_get_log_timestamp_usecs();
+	uint32_t sojourn_ms;
+	qdf_nbuf_t skb;
+
+	wlan_ipa_pm_queue_expire(ipa_ctx, now_us, drop_q);
+
+	skb = qdf_nbuf_queue_remove(&ipa_ctx->pm_queue_head);
+	if (!skb)
+		return NULL;
+
+	pm_tx_cb = (struct wlan_ipa_pm_tx_cb *)skb->cb;
+	sojourn_ms = qdf_do_div(now_us - pm_tx_cb->enqueue_us, 1000);
+	wlan_ipa_latency_hist_update(ipa_ctx->stats.pm_sojourn_hist,
+				     sojourn_ms);
+	if (sojourn_ms > ipa_ctx->stats.max_pm_sojourn_ms)
+		ipa_ctx->stats.max_pm_sojourn_ms = sojourn_ms;
+
+	return skb;
+}
+
 /**
  * wlan_ipa_send_pkt_to_tl() - Send an IPA packet to TL
  * @iface_context: interface-specific IPA context
@@ -251,6 +384,9 @@ static void wlan_ipa_send_pkt_to_tl(
 		return;
 	}
 
+	/* Terminate the (single-element) list of tx frames */
+	qdf_nbuf_set_next(skb, NULL);
+
 	skb = cdp_ipa_tx_send_data_frame(cds_get_context(QDF_MODULE_ID_SOC),
 			(struct cdp_vdev *)iface_context->tl_context,
 			QDF_IPA_RX_DATA_SKB(ipa_tx_desc));
@@ -265,6 +401,317 @@ static void wlan_ipa_send_pkt_to_tl(
 	iface_context->stats.num_tx++;
 }
 
+/**
+ * wlan_ipa_tx_batch_submit() - Submit a list of IPA packets to TL
+ * @iface_context: interface-specific IPA context
+ * @head: NULL terminated list of packets
+ *
+ * Return: number of packets accepted by TL
+ */
+#ifdef IPA_TX_LIST_SUPPORT
+static uint32_t
+wlan_ipa_tx_batch_submit(struct wlan_ipa_iface_context *iface_context,
+			 qdf_nbuf_t head)
+{
+	qdf_nbuf_t next;
+	uint32_t num_err = 0;
+	uint32_t num_pkts = 0;
+
+	for (next = head; next; next = qdf_nbuf_next(next))
+		num_pkts++;
+
+	head = cdp_ipa_tx_send_data_frame(cds_get_context(QDF_MODULE_ID_SOC),
+			(struct cdp_vdev *)iface_context->tl_context, head);
+	while (head) {
+		next = qdf_nbuf_next(head);
+		qdf_nbuf_set_next(head, NULL);
+		qdf_nbuf_free(head);
+		num_err++;
+		head = next;
+	}
+
+	iface_context->stats.num_tx_err += num_err;
+
+	return num_pkts - num_err;
+}
+#else
+static uint32_t
+wlan_ipa_tx_batch_submit(struct wlan_ipa_iface_context *iface_context,
+			 qdf_nbuf_t head)
+{
+	void *soc = cds_get_context(QDF_MODULE_ID_SOC);
+	qdf_nbuf_t next, skb;
+	uint32_t num_sent = 0;
+
+	while (head) {
+		next = qdf_nbuf_next(head);
+		qdf_nbuf_set_next(head, NULL);
+		skb = cdp_ipa_tx_send_data_frame(soc,
+				(struct cdp_vdev *)iface_context->tl_context,
+				head);
+		if (skb) {
+			qdf_nbuf_free(skb);
+			iface_context->stats.num_tx_err++;
+		} else {
+			num_sent++;
+		}
+		head = next;
+	}
+
+	return num_sent;
+}
+#endif
+
+/**
+ * wlan_ipa_tx_batch_flush() - Submit the packets of a TX batch to TL
+ * @iface_context: interface-specific IPA context
+ * @batch_q: packets of the batch, each carrying a wlan_ipa_pm_tx_cb
+ * @start_us: time the first packet of the batch was queued
+ *
+ * The per-interface and descriptor queue locks are taken once for the whole
+ * batch instead of once per packet as done by wlan_ipa_send_pkt_to_tl().
+ *
+ * Return: None
+ */
+static void
+wlan_ipa_tx_batch_flush(struct wlan_ipa_iface_context *iface_context,
+			qdf_nbuf_queue_t *batch_q, uint64_t start_us)
+{
+	struct wlan_ipa_priv *ipa_ctx = iface_context->ipa_ctx;
+	struct wlan_ipa_iface_stats *stats = &iface_context->stats;
+	struct wlan_ipa_pm_tx_cb *pm_tx_cb;
+	struct wlan_ipa_tx_desc *tx_desc;
+	qdf_ipa_rx_data_t *ipa_tx_desc;
+	qdf_nbuf_queue_t drop_q;
+	qdf_nbuf_t skb, head = NULL, tail = NULL;
+	uint32_t num_pkts, num_sent;
+	uint64_t latency_us;
+	bool cac_block = false;
+
+	num_pkts = qdf_nbuf_queue_len(batch_q);
+	if (!num_pkts)
+		return;
+
+	latency_us = qdf_get_log_timestamp_usecs() - start_us;
+	stats->num_tx_batch++;
+	stats->num_tx_batch_pkts += num_pkts;
+	stats->tx_batch_latency_us += latency_us;
+	if (num_pkts > stats->tx_batch_max)
+		stats->tx_batch_max = num_pkts;
+	if (latency_us > stats->tx_batch_latency_max_us)
+		stats->tx_batch_latency_max_us = latency_us;
+
+	qdf_nbuf_queue_init(&drop_q);
+
+	qdf_spin_lock_bh(&ipa_ctx->pm_lock);
+	/*
+	 * Host started suspending while the batch was filling up, hand the
+	 * packets to the PM queue so that they are sent after resume.
+	 */
+	if (ipa_ctx->suspended) {
+		while ((skb = qdf_nbuf_queue_remove(batch_q)))
+			wlan_ipa_pm_queue_add(ipa_ctx, skb, &drop_q);
+		qdf_spin_unlock_bh(&ipa_ctx->pm_lock);
+		wlan_ipa_pm_queue_free(ipa_ctx, &drop_q);
+		return;
+	}
+	qdf_spin_unlock_bh(&ipa_ctx->pm_lock);
+
+	qdf_spin_lock_bh(&iface_context->interface_lock);
+	/*
+	 * During CAC period, data packets shouldn't be sent over the air so
+	 * drop all the packets here
+	 */
+	if (iface_context->device_mode == QDF_SAP_MODE ||
+	    iface_context->device_mode == QDF_P2P_GO_MODE)
+		cac_block = ipa_ctx->dfs_cac_block_tx;
+	qdf_spin_unlock_bh(&iface_context->interface_lock);
+
+	if (cac_block) {
+		stats->num_tx_cac_drop += num_pkts;
+		drop_q = *batch_q;
+		qdf_nbuf_queue_init(batch_q);
+	}
+
+	qdf_spin_lock_bh(&ipa_ctx->q_lock);
+	while ((skb = qdf_nbuf_queue_remove(batch_q))) {
+		/* get free Tx desc and assign ipa_tx_desc pointer */
+		if (!ipa_ctx->tx_desc_free_list.count ||
+		    qdf_list_remove_front(&ipa_ctx->tx_desc_free_list,
+					  (qdf_list_node_t **)&tx_desc) !=
+							QDF_STATUS_SUCCESS) {
+			ipa_ctx->stats.num_tx_desc_error++;
+			qdf_nbuf_queue_add(&drop_q, skb);
+			continue;
+		}
+
+		pm_tx_cb = (struct wlan_ipa_pm_tx_cb *)skb->cb;
+		ipa_tx_desc = pm_tx_cb->ipa_tx_desc;
+		tx_desc->ipa_tx_desc_ptr = ipa_tx_desc;
+		ipa_ctx->stats.num_tx_desc_q_cnt++;
+
+		qdf_mem_zero(skb->cb, sizeof(skb->cb));
+
+		/* Store IPA Tx buffer ownership into SKB CB */
+		qdf_nbuf_ipa_owned_set(skb);
+		if (wlan_ipa_uc_sta_is_enabled(ipa_ctx->config)) {
+			qdf_nbuf_mapped_paddr_set(skb,
+					QDF_IPA_RX_DATA_DMA_ADDR(ipa_tx_desc)
+					+ WLAN_IPA_WLAN_FRAG_HEADER
+					+ WLAN_IPA_WLAN_IPA_HEADER);
+			QDF_IPA_RX_DATA_SKB_LEN(ipa_tx_desc) -=
+				WLAN_IPA_WLAN_FRAG_HEADER +
+				WLAN_IPA_WLAN_IPA_HEADER;
+		} else {
+			qdf_nbuf_mapped_paddr_set(skb, ipa_tx_desc->dma_addr);
+		}
+
+		/* Store Tx Desc index into SKB CB */
+		QDF_NBUF_CB_TX_IPA_PRIV(skb) = tx_desc->id;
+
+		qdf_nbuf_set_next(skb, NULL);
+		if (tail)
+			qdf_nbuf_set_next(tail, skb);
+		else
+			head = skb;
+		tail = skb;
+	}
+	qdf_spin_unlock_bh(&ipa_ctx->q_lock);
+
+	if (!qdf_nbuf_is_queue_empty(&drop_q)) {
+		while ((skb = qdf_nbuf_queue_remove(&drop_q))) {
+			pm_tx_cb = (struct wlan_ipa_pm_tx_cb *)skb->cb;
+			ipa_free_skb(pm_tx_cb->ipa_tx_desc);
+		}
+		wlan_ipa_wdi_rm_try_release(ipa_ctx);
+	}
+
+	if (!head)
+		return;
+
+	num_sent = wlan_ipa_tx_batch_submit(iface_context, head);
+
+	atomic_add(num_sent, &ipa_ctx->tx_ref_cnt);
+
+	stats->num_tx += num_sent;
+}
+
+/**
+ * wlan_ipa_tx_batch_timer_cb() - Flush a TX batch which did not fill up
+ * @ctx: interface-specific IPA context
+ *
+ * Return: None
+ */
+static void wlan_ipa_tx_batch_timer_cb(void *ctx)
+{
+	struct wlan_ipa_iface_context *iface_context = ctx;
+	qdf_nbuf_queue_t batch_q;
+	uint64_t start_us;
+
+	qdf_spin_lock_bh(&iface_context->interface_lock);
+	batch_q = iface_context->tx_batch_q;
+	start_us = iface_context->tx_batch_start_us;
+	qdf_nbuf_queue_init(&iface_context->tx_batch_q);
+	qdf_spin_unlock_bh(&iface_context->interface_lock);
+
+	if (qdf_nbuf_is_queue_empty(&batch_q))
+		return;
+
+	iface_context->stats.num_tx_batch_timeout++;
+	wlan_ipa_tx_batch_flush(iface_context, &batch_q, start_us);
+}
+
+/**
+ * wlan_ipa_tx_batch_add() - Add an IPA packet to the interface TX batch
+ * @iface_context: interface-specific IPA context
+ * @ipa_tx_desc: packet data descriptor
+ *
+ * The batch is submitted to TL once it holds tx_batch_size packets or
+ * tx_batch_timeout ms after its first packet was queued, whichever comes
+ * first. With a batch size of 1 the packet is sent right away.
+ *
+ * Return: None
+ */
+static void wlan_ipa_tx_batch_add(struct wlan_ipa_iface_context *iface_context,
+				  qdf_ipa_rx_data_t *ipa_tx_desc)
+{
+	struct wlan_ipa_priv *ipa_ctx = iface_context->ipa_ctx;
+	struct wlan_ipa_pm_tx_cb *pm_tx_cb;
+	qdf_nbuf_queue_t batch_q;
+	qdf_nbuf_t skb;
+	uint64_t start_us = 0;
+	bool first, full;
+
+	if (ipa_ctx->config->tx_batch_size <= 1)
+		return wlan_ipa_send_pkt_to_tl(iface_context, ipa_tx_desc);
+
+	skb = QDF_IPA_RX_DATA_SKB(ipa_tx_desc);
+	qdf_mem_zero(skb->cb, sizeof(skb->cb));
+	pm_tx_cb = (struct wlan_ipa_pm_tx_cb *)skb->cb;
+	pm_tx_cb->iface_context = iface_context;
+	pm_tx_cb->ipa_tx_desc = ipa_tx_desc;
+
+	qdf_nbuf_queue_init(&batch_q);
+
+	qdf_spin_lock_bh(&iface_context->interface_lock);
+	first = qdf_nbuf_is_queue_empty(&iface_context->tx_batch_q);
+	if (first)
+		iface_context->tx_batch_start_us =
+					qdf_get_log_timestamp_usecs();
+	qdf_nbuf_queue_add(&iface_context->tx_batch_q, skb);
+	full = qdf_nbuf_queue_len(&iface_context->tx_batch_q) >=
+					ipa_ctx->config->tx_batch_size;
+	if (full) {
+		batch_q = iface_context->tx_batch_q;
+		start_us = iface_context->tx_batch_start_us;
+		qdf_nbuf_queue_init(&iface_context->tx_batch_q);
+	}
+	qdf_spin_unlock_bh(&iface_context->interface_lock);
+
+	if (full) {
+		qdf_timer_stop(&iface_context->tx_batch_timer);
+		wlan_ipa_tx_batch_flush(iface_context, &batch_q, start_us);
+	} else if (first) {
+		qdf_timer_mod(&iface_context->tx_batch_timer,
+			      ipa_ctx->config->tx_batch_timeout);
+	}
+}
+
+/**
+ * wlan_ipa_tx_batch_drain() - Submit the pending TX batch of an interface
+ * @iface_context: interface-specific IPA context
+ *
+ * Called before the TL context of the interface goes away.
+ *
+ * Return: None
+ */
+static void
+wlan_ipa_tx_batch_drain(struct wlan_ipa_iface_context *iface_context)
+{
+	qdf_timer_sync_cancel(&iface_context->tx_batch_timer);
+	wlan_ipa_tx_batch_timer_cb(iface_context);
+}
+
+/**
+ * wlan_ipa_tx_batch_purge() - Free the packets of the pending TX batch
+ * @iface_context: interface-specific IPA context
+ *
+ * Return: None
+ */
+static void
+wlan_ipa_tx_batch_purge(struct wlan_ipa_iface_context *iface_context)
+{
+	struct wlan_ipa_pm_tx_cb *pm_tx_cb;
+	qdf_nbuf_t skb;
+
+	qdf_spin_lock_bh(&iface_context->interface_lock);
+	while ((skb = qdf_nbuf_queue_remove(&iface_context->tx_batch_q))) {
+		pm_tx_cb = (struct wlan_ipa_pm_tx_cb *)skb->cb;
+		ipa_free_skb(pm_tx_cb->ipa_tx_desc);
+	}
+	qdf_spin_unlock_bh(&iface_context->interface_lock);
+}
+
 /**
  * wlan_ipa_forward() - handle packet forwarding to wlan tx
  * @ipa_ctx: pointer to ipa ipa context
@@ -282,6 +729,7 @@ static void wlan_ipa_forward(struct wlan_ipa_priv *ipa_ctx,
 			     qdf_nbuf_t skb)
 {
 	struct wlan_ipa_pm_tx_cb *pm_tx_cb;
+	qdf_nbuf_queue_t drop_q;
 
 	qdf_spin_lock_bh(&ipa_ctx->pm_lock);
 
@@ -296,10 +744,11 @@ static void wlan_ipa_forward(struct wlan_ipa_priv *ipa_ctx,
 		pm_tx_cb = (struct wlan_ipa_pm_tx_cb *)skb->cb;
 		pm_tx_cb->exception = true;
 		pm_tx_cb->iface_context = iface_ctx;
+		qdf_nbuf_queue_init(&drop_q);
 		qdf_spin_lock_bh(&ipa_ctx->pm_lock);
-		qdf_nbuf_queue_add(&ipa_ctx->pm_queue_head, skb);
+		wlan_ipa_pm_queue_add(ipa_ctx, skb, &drop_q);
 		qdf_spin_unlock_bh(&ipa_ctx->pm_lock);
-		ipa_ctx->stats.num_tx_queued++;
+		wlan_ipa_pm_queue_free(ipa_ctx, &drop_q);
 	} else {
 		/* Resume, put packet into WLAN TX */
 		qdf_spin_unlock_bh(&ipa_ctx->pm_lock);
@@ -545,12 +994,14 @@ static void wlan_ipa_pm_flush(void *data)
 {
 	struct wlan_ipa_priv *ipa_ctx = (struct wlan_ipa_priv *)data;
 	struct wlan_ipa_pm_tx_cb *pm_tx_cb = NULL;
+	qdf_nbuf_queue_t drop_q;
 	qdf_nbuf_t skb;
 	uint32_t dequeued = 0;
 
+	qdf_nbuf_queue_init(&drop_q);
+
 	qdf_spin_lock_bh(&ipa_ctx->pm_lock);
-	while (((skb = qdf_nbuf_queue_remove(&ipa_ctx->pm_queue_head)) !=
-	       NULL)) {
+	while ((skb = wlan_ipa_pm_queue_remove(ipa_ctx, &drop_q))) {
 		qdf_spin_unlock_bh(&ipa_ctx->pm_lock);
 
 		pm_tx_cb = (struct wlan_ipa_pm_tx_cb *)skb->cb;
@@ -574,6 +1025,8 @@ static void wlan_ipa_pm_flush(void *data)
 	}
 	qdf_spin_unlock_bh(&ipa_ctx->pm_lock);
 
+	wlan_ipa_pm_queue_free(ipa_ctx, &drop_q);
+
 	ipa_ctx->stats.num_tx_dequeued += dequeued;
 	if (dequeued > ipa_ctx->stats.num_max_pm_queue)
 		ipa_ctx->stats.num_max_pm_queue = dequeued;
@@ -790,14 +1243,16 @@ static void wlan_ipa_pm_flush(void *data)
 {
 	struct wlan_ipa_priv *ipa_ctx = (struct wlan_ipa_priv *)data;
 	struct wlan_ipa_pm_tx_cb *pm_tx_cb = NULL;
+	qdf_nbuf_queue_t drop_q;
 	qdf_nbuf_t skb;
 	uint32_t dequeued = 0;
 
 	qdf_wake_lock_acquire(&ipa_ctx->wake_lock,
 			      WIFI_POWER_EVENT_WAKELOCK_IPA);
+	qdf_nbuf_queue_init(&drop_q);
+
 	qdf_spin_lock_bh(&ipa_ctx->pm_lock);
-	while (((skb = qdf_nbuf_queue_remove(&ipa_ctx->pm_queue_head)) !=
-	       NULL)) {
+	while ((skb = wlan_ipa_pm_queue_remove(ipa_ctx, &drop_q))) {
 		qdf_spin_unlock_bh(&ipa_ctx->pm_lock);
 
 		pm_tx_cb = (struct wlan_ipa_pm_tx_cb *)skb->cb;
@@ -823,6 +1278,8 @@ static void wlan_ipa_pm_flush(void *data)
 	qdf_wake_lock_release(&ipa_ctx->wake_lock,
 			      WIFI_POWER_EVENT_WAKELOCK_IPA);
 
+	wlan_ipa_pm_queue_free(ipa_ctx, &drop_q);
+
 	ipa_ctx->stats.num_tx_dequeued += dequeued;
 	if (dequeued > ipa_ctx->stats.num_max_pm_queue)
 		ipa_ctx->stats.num_max_pm_queue = dequeued;
@@ -1116,6 +1573,7 @@ static void __wlan_ipa_i2w_cb(void *priv, qdf_ipa_dp_evt_type_t evt,
 	struct wlan_ipa_iface_context *iface_context;
 	qdf_nbuf_t skb;
 	struct wlan_ipa_pm_tx_cb *pm_tx_cb = NULL;
+	qdf_nbuf_queue_t drop_q;
 
 	iface_context = (struct wlan_ipa_iface_context *)priv;
 	ipa_tx_desc = (qdf_ipa_rx_data_t *)data;
@@ -1151,10 +1609,11 @@ static void __wlan_ipa_i2w_cb(void *priv, qdf_ipa_dp_evt_type_t evt,
 		pm_tx_cb = (struct wlan_ipa_pm_tx_cb *)skb->cb;
 		pm_tx_cb->iface_context = iface_context;
 		pm_tx_cb->ipa_tx_desc = ipa_tx_desc;
-		qdf_nbuf_queue_add(&ipa_ctx->pm_queue_head, skb);
-		ipa_ctx->stats.num_tx_queued++;
+		qdf_nbuf_queue_init(&drop_q);
+		wlan_ipa_pm_queue_add(ipa_ctx, skb, &drop_q);
 
 		qdf_spin_unlock_bh(&ipa_ctx->pm_lock);
+		wlan_ipa_pm_queue_free(ipa_ctx, &drop_q);
 		return;
 	}
 
@@ -1166,7 +1625,7 @@ static void __wlan_ipa_i2w_cb(void *priv, qdf_ipa_dp_evt_type_t evt,
 	 */
 	qdf_flush_work(&ipa_ctx->pm_work);
 
-	return wlan_ipa_send_pkt_to_tl(iface_context, ipa_tx_desc);
+	return wlan_ipa_tx_batch_add(iface_context, ipa_tx_desc);
 }
 
 /**
@@ -1443,6 +1902,8 @@ static void wlan_ipa_cleanup_iface(struct wlan_ipa_iface_context *iface_context)
 	if (!iface_context->tl_context)
 		return;
 
+	wlan_ipa_tx_batch_drain(iface_context);
+
 	cdp_ipa_cleanup_iface(ipa_ctx->dp_soc,
 			      iface_context->dev->name,
 			      wlan_ipa_is_ipv6_enabled(ipa_ctx->config));
@@ -3051,6 +3512,10 @@ QDF_STATUS wlan_ipa_setup(struct wlan_ipa_priv *ipa_ctx,
 		iface_context->device_mode = QDF_MAX_NO_OF_MODE;
 		iface_context->tl_context = NULL;
 		qdf_spinlock_create(&iface_context->interface_lock);
+		qdf_nbuf_queue_init(&iface_context->tx_batch_q);
+		qdf_timer_init(NULL, &iface_context->tx_batch_timer,
+			       wlan_ipa_tx_batch_timer_cb, iface_context,
+			       QDF_TIMER_TYPE_SW);
 	}
 
 	qdf_create_work(0, &ipa_ctx->pm_work, wlan_ipa_pm_flush, ipa_ctx);
@@ -3130,6 +3595,7 @@ fail_setup_rm:
 	qdf_spinlock_destroy(&ipa_ctx->enable_disable_lock);
 	for (i = 0; i < WLAN_IPA_MAX_IFACE; i++) {
 		iface_context = &ipa_ctx->iface_context[i];
+		qdf_timer_free(&iface_context->tx_batch_timer);
 		qdf_spinlock_destroy(&iface_context->interface_lock);
 	}
 	qdf_mutex_destroy(&ipa_ctx->event_lock);
@@ -3187,6 +3653,12 @@ QDF_STATUS wlan_ipa_cleanup(struct wlan_ipa_priv *ipa_ctx)
 
 	wlan_ipa_wdi_destroy_rm(ipa_ctx);
 
+	for (i = 0; i < WLAN_IPA_MAX_IFACE; i++) {
+		iface_context = &ipa_ctx->iface_context[i];
+		qdf_timer_free(&iface_context->tx_batch_timer);
+		wlan_ipa_tx_batch_purge(iface_context);
+	}
+
 	wlan_ipa_flush(ipa_ctx);
 
 	qdf_spinlock_destroy(&ipa_ctx->pm_lock);
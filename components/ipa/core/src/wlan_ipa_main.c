@@ -651,6 +651,14 @@ void ipa_component_config_update(struct wlan_objmgr_psoc *psoc)
 		cfg_get(psoc, CFG_DP_BUS_BANDWIDTH_LOW_THRESHOLD);
 	g_ipa_config->ipa_force_voting =
 		cfg_get(psoc, CFG_DP_IPA_ENABLE_FORCE_VOTING);
+	g_ipa_config->tx_batch_size =
+		cfg_get(psoc, CFG_DP_IPA_TX_BATCH_SIZE);
+	g_ipa_config->tx_batch_timeout =
+		cfg_get(psoc, CFG_DP_IPA_TX_BATCH_TIMEOUT);
+	g_ipa_config->pm_queue_limit =
+		cfg_get(psoc, CFG_DP_IPA_PM_QUEUE_LIMIT);
+	g_ipa_config->pm_queue_max_sojourn =
+		cfg_get(psoc, CFG_DP_IPA_PM_QUEUE_MAX_SOJOURN);
 }
 
 uint32_t ipa_get_tx_buf_count(void)
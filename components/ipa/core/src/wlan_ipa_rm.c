@@ -119,6 +119,26 @@ static int wlan_ipa_rm_cons_release(void)
 	return 0;
 }
 
+/**
+ * wlan_ipa_rm_grant_wait_update() - Account the wait for a pending RM grant
+ * @ipa_ctx: IPA context
+ *
+ * Must be called with rm_lock held when the pending grant completes.
+ *
+ * Return: None
+ */
+static void wlan_ipa_rm_grant_wait_update(struct wlan_ipa_priv *ipa_ctx)
+{
+	uint32_t wait_ms;
+
+	wait_ms = qdf_do_div(qdf_get_log_timestamp_usecs() -
+			     ipa_ctx->rm_grant_req_us, 1000);
+	wlan_ipa_latency_hist_update(ipa_ctx->stats.rm_grant_wait_hist,
+				     wait_ms);
+	if (wait_ms > ipa_ctx->stats.max_rm_grant_wait_ms)
+		ipa_ctx->stats.max_rm_grant_wait_ms = wait_ms;
+}
+
 /**
  * wlan_ipa_wdi_rm_request() - Request resource from IPA
  * @ipa_ctx: IPA context
@@ -143,6 +163,7 @@ QDF_STATUS wlan_ipa_wdi_rm_request(struct wlan_ipa_priv *ipa_ctx)
 		return QDF_STATUS_E_PENDING;
 	case WLAN_IPA_RM_RELEASED:
 		ipa_ctx->rm_state = WLAN_IPA_RM_GRANT_PENDING;
+		ipa_ctx->rm_grant_req_us = qdf_get_log_timestamp_usecs();
 		break;
 	}
 
@@ -153,6 +174,8 @@ QDF_STATUS wlan_ipa_wdi_rm_request(struct wlan_ipa_priv *ipa_ctx)
 
 	qdf_spin_lock_bh(&ipa_ctx->rm_lock);
 	if (ret == 0) {
+		if (ipa_ctx->rm_state == WLAN_IPA_RM_GRANT_PENDING)
+			wlan_ipa_rm_grant_wait_update(ipa_ctx);
 		ipa_ctx->rm_state = WLAN_IPA_RM_GRANTED;
 		ipa_ctx->stats.num_rm_grant_imm++;
 	}
@@ -380,6 +403,8 @@ static void wlan_ipa_rm_notify(void *user_data, qdf_ipa_rm_event_t event,
 			break;
 		}
 		qdf_spin_lock_bh(&ipa_ctx->rm_lock);
+		if (ipa_ctx->rm_state == WLAN_IPA_RM_GRANT_PENDING)
+			wlan_ipa_rm_grant_wait_update(ipa_ctx);
 		ipa_ctx->rm_state = WLAN_IPA_RM_GRANTED;
 		qdf_spin_unlock_bh(&ipa_ctx->rm_lock);
 		ipa_ctx->stats.num_rm_grant++;
@@ -552,6 +552,26 @@ static void wlan_ipa_print_session_info(struct wlan_ipa_priv *ipa_ctx)
 	}
 }
 
+/**
+ * wlan_ipa_print_latency_hist() - Print a wait time histogram
+ * @name: histogram name
+ * @hist: histogram of WLAN_IPA_LATENCY_HIST_MAX buckets
+ *
+ * Return: None
+ */
+static void wlan_ipa_print_latency_hist(const char *name, uint64_t *hist)
+{
+	int i;
+
+	ipa_info("%s: <1ms:%llu", name, hist[0]);
+	for (i = 1; i < WLAN_IPA_LATENCY_HIST_MAX - 1; i++)
+		ipa_info("%s: %u-%ums:%llu", name, 1 << (i - 1), 1 << i,
+			 hist[i]);
+	ipa_info("%s: >=%ums:%llu", name,
+		 1 << (WLAN_IPA_LATENCY_HIST_MAX - 2),
+		 hist[WLAN_IPA_LATENCY_HIST_MAX - 1]);
+}
+
 /**
  * wlan_ipa_print_txrx_stats - Print IPA IPA TX/RX stats
  * @ipa_ctx: IPA context
@@ -579,6 +599,10 @@ static void wlan_ipa_print_txrx_stats(struct wlan_ipa_priv *ipa_ctx)
 		"NUM TX QUEUED: %llu\n"
 		"NUM TX DEQUEUED: %llu\n"
 		"NUM MAX PM QUEUE: %llu\n"
+		"NUM PM DROP FULL: %llu\n"
+		"NUM PM DROP SOJOURN: %llu\n"
+		"MAX PM SOJOURN: %ums\n"
+		"MAX RM GRANT WAIT: %ums\n"
 		"TX REF CNT: %d\n"
 		"SUSPENDED: %d\n"
 		"PEND DESC HEAD: %pK\n"
@@ -598,11 +622,20 @@ static void wlan_ipa_print_txrx_stats(struct wlan_ipa_priv *ipa_ctx)
 		ipa_ctx->stats.num_tx_queued,
 		ipa_ctx->stats.num_tx_dequeued,
 		ipa_ctx->stats.num_max_pm_queue,
+		ipa_ctx->stats.num_pm_drop_full,
+		ipa_ctx->stats.num_pm_drop_sojourn,
+		ipa_ctx->stats.max_pm_sojourn_ms,
+		ipa_ctx->stats.max_rm_grant_wait_ms,
 		ipa_ctx->tx_ref_cnt.counter,
 		ipa_ctx->suspended,
 		&ipa_ctx->pend_desc_head,
 		&ipa_ctx->tx_desc_free_list);
 
+	wlan_ipa_print_latency_hist("PM QUEUE SOJOURN",
+				    ipa_ctx->stats.pm_sojourn_hist);
+	wlan_ipa_print_latency_hist("RM GRANT WAIT",
+				    ipa_ctx->stats.rm_grant_wait_hist);
+
 	for (i = 0; i < WLAN_IPA_MAX_IFACE; i++) {
 
 		iface_context = &ipa_ctx->iface_context[i];
@@ -616,6 +649,22 @@ static void wlan_ipa_print_txrx_stats(struct wlan_ipa_priv *ipa_ctx)
 			 iface_context->stats.num_tx_err,
 			 iface_context->stats.num_tx_cac_drop,
 			 iface_context->stats.num_rx_ipa_excep);
+
+		if (!iface_context->stats.num_tx_batch)
+			continue;
+
+		ipa_info("IFACE[%d]: TX BATCH:%llu, TX BATCH PKTS:%llu,"
+			 " AVG BATCH:%llu, MAX BATCH:%u, BATCH TIMEOUT:%llu,"
+			 " AVG LATENCY:%lluus, MAX LATENCY:%lluus",
+			 i, iface_context->stats.num_tx_batch,
+			 iface_context->stats.num_tx_batch_pkts,
+			 qdf_do_div(iface_context->stats.num_tx_batch_pkts,
+				    iface_context->stats.num_tx_batch),
+			 iface_context->stats.tx_batch_max,
+			 iface_context->stats.num_tx_batch_timeout,
+			 qdf_do_div(iface_context->stats.tx_batch_latency_us,
+				    iface_context->stats.num_tx_batch),
+			 iface_context->stats.tx_batch_latency_max_us);
 	}
 }
 
@@ -198,6 +198,109 @@
 		512, \
 		CFG_VALUE_OR_DEFAULT, "IPA tx buffer count")
 
+/*
+ * <ini>
+ * gIPATxBatchSize - IPA to WLAN TX batch size
+ * @Min: 1
+ * @Max: 64
+ * @Default: 1
+ *
+ * This ini specifies the number of IPA to WLAN exception packets which are
+ * accumulated per interface and submitted to the WLAN TX path as one list.
+ * A value of 1 submits every packet on its own.
+ *
+ * Related: gIPATxBatchTimeout
+ *
+ * Supported Feature: IPA
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_IPA_TX_BATCH_SIZE \
+		CFG_INI_UINT("gIPATxBatchSize", \
+		1, \
+		64, \
+		1, \
+		CFG_VALUE_OR_DEFAULT, "IPA tx batch size")
+
+/*
+ * <ini>
+ * gIPATxBatchTimeout - IPA to WLAN TX batch timeout
+ * @Min: 1
+ * @Max: 10
+ * @Default: 1
+ *
+ * This ini specifies the maximum time in milliseconds a packet waits for
+ * its batch to fill before the batch is submitted to the WLAN TX path.
+ *
+ * Related: gIPATxBatchSize
+ *
+ * Supported Feature: IPA
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_IPA_TX_BATCH_TIMEOUT \
+		CFG_INI_UINT("gIPATxBatchTimeout", \
+		1, \
+		10, \
+		1, \
+		CFG_VALUE_OR_DEFAULT, "IPA tx batch timeout")
+
+/*
+ * <ini>
+ * gIPAPmQueueLimit - IPA PM queue limit
+ * @Min: 0
+ * @Max: 8192
+ * @Default: 1024
+ *
+ * This ini specifies the maximum number of IPA packets held while the host
+ * is suspending. When the queue is full the oldest packet is dropped to
+ * make room for the new one. 0 means the queue is not bounded.
+ *
+ * Related: gIPAPmQueueMaxSojourn
+ *
+ * Supported Feature: IPA
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_IPA_PM_QUEUE_LIMIT \
+		CFG_INI_UINT("gIPAPmQueueLimit", \
+		0, \
+		8192, \
+		1024, \
+		CFG_VALUE_OR_DEFAULT, "IPA PM queue limit")
+
+/*
+ * <ini>
+ * gIPAPmQueueMaxSojourn - IPA PM queue max sojourn time
+ * @Min: 0
+ * @Max: 10000
+ * @Default: 500
+ *
+ * This ini specifies the maximum time in ms an IPA packet is held while
+ * the host is suspending. Older packets are dropped instead of being sent
+ * after resume. 0 means packets are held until resume.
+ *
+ * Related: gIPAPmQueueLimit
+ *
+ * Supported Feature: IPA
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_IPA_PM_QUEUE_MAX_SOJOURN \
+		CFG_INI_UINT("gIPAPmQueueMaxSojourn", \
+		0, \
+		10000, \
+		500, \
+		CFG_VALUE_OR_DEFAULT, "IPA PM queue max sojourn")
+
 #define CFG_IPA \
 	CFG(CFG_DP_IPA_OFFLOAD_CONFIG) \
 	CFG(CFG_DP_IPA_DESC_SIZE) \
@@ -205,6 +308,10 @@
 	CFG(CFG_DP_IPA_MEDIUM_BANDWIDTH_MBPS) \
 	CFG(CFG_DP_IPA_LOW_BANDWIDTH_MBPS) \
 	CFG(CFG_DP_IPA_ENABLE_FORCE_VOTING) \
-	CFG(CFG_DP_IPA_UC_TX_BUF_COUNT)
+	CFG(CFG_DP_IPA_UC_TX_BUF_COUNT) \
+	CFG(CFG_DP_IPA_TX_BATCH_SIZE) \
+	CFG(CFG_DP_IPA_TX_BATCH_TIMEOUT) \
+	CFG(CFG_DP_IPA_PM_QUEUE_LIMIT) \
+	CFG(CFG_DP_IPA_PM_QUEUE_MAX_SOJOURN)
 
 #endif /* _CFG_IPA_H_ */
@@ -39,6 +39,11 @@
  * @ipa_bw_medium: IPA bandwidth medium threshold
  * @ipa_bw_low: IPA bandwidth low threshold
  * @ipa_force_voting: support force bw voting
+ * @tx_batch_size: Number of IPA to WLAN packets submitted to TL at once
+ * @tx_batch_timeout: Max time in ms a packet waits for its batch to fill
+ * @pm_queue_limit: Max number of packets held while host is suspended
+ * @pm_queue_max_sojourn: Max time in ms a packet is held while host is
+ *	suspended
  */
 struct wlan_ipa_config {
 	uint32_t ipa_config;
@@ -51,6 +56,10 @@ struct wlan_ipa_config {
 	uint32_t ipa_bw_medium;
 	uint32_t ipa_bw_low;
 	bool ipa_force_voting;
+	uint32_t tx_batch_size;
+	uint32_t tx_batch_timeout;
+	uint32_t pm_queue_limit;
+	uint32_t pm_queue_max_sojourn;
 };
 
 /**
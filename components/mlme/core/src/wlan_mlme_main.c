@@ -1569,6 +1569,8 @@ static void mlme_init_lfr_cfg(struct wlan_objmgr_psoc *psoc,
 		cfg_get(psoc, CFG_LFR_MAWC_ROAM_ENABLED);
 	lfr->enable_fast_roam_in_concurrency =
 		cfg_get(psoc, CFG_LFR_ENABLE_FAST_ROAM_IN_CONCURRENCY);
+	lfr->host_roam_candidate_scoring =
+		cfg_get(psoc, CFG_LFR_HOST_ROAM_CANDIDATE_SCORING);
 	lfr->early_stop_scan_enable =
 		cfg_get(psoc, CFG_LFR_EARLY_STOP_SCAN_ENABLE);
 	lfr->enable_5g_band_pref =
@@ -233,6 +233,33 @@
 	1, \
 	"Enable LFR roaming on STA during concurrency")
 
+/*
+ * <ini>
+ * host_roam_candidate_scoring - Score host roaming candidates
+ * @Min: 0
+ * @Max: 1
+ * @Default: 0
+ *
+ * This ini is used to order the candidates of host (LFR2) roaming by a score
+ * built from their RSSI, band and channel congestion, weighted with
+ * rssi_weightage, chan_band_weightage and channel_congestion_weightage.
+ * When disabled, candidates are tried in the scan result order, which is
+ * sorted by RSSI.
+ *
+ * Related: rssi_weightage, chan_band_weightage,
+ * channel_congestion_weightage, band_weight_per_index
+ *
+ * Supported Feature: Roaming
+ *
+ * Usage: External
+ *
+ * </ini>
+ */
+#define CFG_LFR_HOST_ROAM_CANDIDATE_SCORING CFG_INI_BOOL( \
+	"host_roam_candidate_scoring", \
+	0, \
+	"Score host roaming candidates")
+
 /*
  * <ini>
  * gEnableEarlyStopScan - Set early stop scan
@@ -2705,6 +2732,7 @@
 	CFG(CFG_LFR_ROAM_RSSI_ABS_THRESHOLD) \
 	CFG(CFG_LFR_5G_RSSI_THRESHOLD_OFFSET) \
 	CFG(CFG_LFR_ENABLE_FAST_ROAM_IN_CONCURRENCY) \
+	CFG(CFG_LFR_HOST_ROAM_CANDIDATE_SCORING) \
 	CFG(CFG_LFR_EARLY_STOP_SCAN_ENABLE) \
 	CFG(CFG_LFR_EARLY_STOP_SCAN_MIN_THRESHOLD) \
 	CFG(CFG_LFR_EARLY_STOP_SCAN_MAX_THRESHOLD) \
@@ -1404,6 +1404,7 @@ struct bss_load_trigger {
 /*
  * @mawc_roam_enabled:              Enable/Disable MAWC during roaming
  * @enable_fast_roam_in_concurrency:Enable LFR roaming on STA during concurrency
+ * @host_roam_candidate_scoring:   Order host roaming candidates by score
  * @lfr3_roaming_offload:           Enable/disable roam offload feature
  * @enable_self_bss_roam:               enable roaming to connected BSSID
  * @enable_disconnect_roam_offload: enable disassoc/deauth roam scan.
@@ -1511,6 +1512,7 @@ struct bss_load_trigger {
 struct wlan_mlme_lfr_cfg {
 	bool mawc_roam_enabled;
 	bool enable_fast_roam_in_concurrency;
+	bool host_roam_candidate_scoring;
 #ifdef WLAN_FEATURE_ROAM_OFFLOAD
 	bool lfr3_roaming_offload;
 	bool enable_self_bss_roam;
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: Declare capture filter APIs which shall be used internally only
+ * in pkt_capture component. The filter is evaluated on the original
+ * frame, before it is copied and converted for the monitor interface,
+ * so that unmatched traffic costs only the rule evaluation.
+ *
+ * Note: These APIs should be never accessed out of pkt_capture component.
+ */
+
+#ifndef _WLAN_PKT_CAPTURE_FILTER_H_
+#define _WLAN_PKT_CAPTURE_FILTER_H_
+
+#include <qdf_nbuf.h>
+#include "wlan_pkt_capture_priv.h"
+
+/**
+ * pkt_capture_filter_init() - Initialize packet capture filter of a vdev
+ * @vdev_priv: pointer to packet capture vdev priv obj
+ *
+ * Return: None
+ */
+void pkt_capture_filter_init(struct pkt_capture_vdev_priv *vdev_priv);
+
+/**
+ * pkt_capture_filter_deinit() - De-initialize packet capture filter
+ * @vdev_priv: pointer to packet capture vdev priv obj
+ *
+ * Return: None
+ */
+void pkt_capture_filter_deinit(struct pkt_capture_vdev_priv *vdev_priv);
+
+/**
+ * pkt_capture_set_filter() - Install a packet capture filter
+ * @vdev: pointer to vdev object
+ * @filter: filter to install, a filter without rules clears the filter
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS pkt_capture_set_filter(struct wlan_objmgr_vdev *vdev,
+				  struct pkt_capture_filter *filter);
+
+/**
+ * pkt_capture_get_filter_stats() - Get packet capture filter statistics
+ * @vdev: pointer to vdev object
+ * @stats: buffer to fill the statistics in
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS pkt_capture_get_filter_stats(struct wlan_objmgr_vdev *vdev,
+					struct pkt_capture_filter_stats *stats);
+
+/**
+ * pkt_capture_filter_ether_buf() - Run capture filter on a raw 802.3 frame
+ * @data: pointer to the ethernet header
+ * @len: length of the frame
+ * @tid: tid of the frame
+ *
+ * Used on the offload paths to drop a frame before a netbuf is allocated
+ * and the frame is copied into it.
+ *
+ * Return: true if the frame is to be captured, false otherwise
+ */
+bool pkt_capture_filter_ether_buf(uint8_t *data, uint32_t len, uint8_t tid);
+
+/**
+ * pkt_capture_filter_80211_buf() - Run capture filter on a raw 802.11 frame
+ * @data: pointer to the 802.11 header
+ * @len: length of the frame
+ *
+ * Return: true if the frame is to be captured, false otherwise
+ */
+bool pkt_capture_filter_80211_buf(uint8_t *data, uint32_t len);
+
+/**
+ * pkt_capture_filter_ether_pkt() - Run capture filter on a 802.3 data frame
+ * @nbuf: netbuf pointing to the ethernet header
+ * @tid: tid of the frame
+ *
+ * Return: true if the frame is to be captured, false otherwise
+ */
+bool pkt_capture_filter_ether_pkt(qdf_nbuf_t nbuf, uint8_t tid);
+
+/**
+ * pkt_capture_filter_80211_pkt() - Run capture filter on a 802.11 frame
+ * @nbuf: netbuf pointing to the 802.11 header
+ *
+ * Return: true if the frame is to be captured, false otherwise
+ */
+bool pkt_capture_filter_80211_pkt(qdf_nbuf_t nbuf);
+#endif /* _WLAN_PKT_CAPTURE_FILTER_H_ */
@@ -51,6 +51,16 @@ struct pkt_capture_cb_context {
 	enum pkt_capture_mode pkt_capture_mode;
 };
 
+/**
+ * struct pkt_capture_filter_stats - packet capture filter statistics
+ * @accepted: frames which matched the filter and were captured
+ * @rejected: frames which were dropped by the filter before being copied
+ */
+struct pkt_capture_filter_stats {
+	uint32_t accepted;
+	uint32_t rejected;
+};
+
 /**
  * struct pkt_capture_vdev_priv - Private object to be stored in vdev
  * @vdev: pointer to vdev object
@@ -58,6 +68,9 @@ struct pkt_capture_cb_context {
  * @cb_ctx: pointer to packet capture mon callback context
  * @rx_ops: rx ops
  * @tx_ops: tx ops
+ * @filter_lock: lock protecting @filter
+ * @filter: capture filter applied before frames are copied
+ * @filter_stats: capture filter statistics
  */
 struct pkt_capture_vdev_priv {
 	struct wlan_objmgr_vdev *vdev;
@@ -65,6 +78,9 @@ struct pkt_capture_vdev_priv {
 	struct pkt_capture_cb_context *cb_ctx;
 	struct wlan_pkt_capture_rx_ops rx_ops;
 	struct wlan_pkt_capture_tx_ops tx_ops;
+	qdf_spinlock_t filter_lock;
+	struct pkt_capture_filter filter;
+	struct pkt_capture_filter_stats filter_stats;
 };
 
 /**
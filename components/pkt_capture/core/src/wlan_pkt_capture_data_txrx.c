@@ -23,6 +23,7 @@
 
 #include <wlan_pkt_capture_data_txrx.h>
 #include <wlan_pkt_capture_main.h>
+#include <wlan_pkt_capture_filter.h>
 #include <enet.h>
 #include <htt_internal.h>
 #include <cds_ieee80211_common.h>
@@ -382,6 +383,13 @@ void pkt_capture_msdu_process_pkts(
 	pktcapture_msdu = NULL;
 	loop_msdu = head_msdu;
 	while (loop_msdu) {
+		if (!pkt_capture_filter_ether_pkt(
+				loop_msdu,
+				htt_rx_desc(loop_msdu)->mpdu_start.tid)) {
+			loop_msdu = qdf_nbuf_next(loop_msdu);
+			continue;
+		}
+
 		msdu = qdf_nbuf_copy(loop_msdu);
 
 		if (msdu) {
@@ -820,8 +828,10 @@ void pkt_capture_offload_deliver_indication_handler(
 	uint8_t status;
 	uint8_t tid = 0;
 	bool pkt_format;
+	bool capture;
 	u_int32_t *msg_word = (u_int32_t *)msg;
 	u_int8_t *buf = (u_int8_t *)msg;
+	u_int8_t *mpdu;
 	struct htt_tx_data_hdr_information *txhdr;
 	struct htt_tx_offload_deliver_ind_hdr_t *offload_deliver_msg;
 
@@ -831,6 +841,18 @@ void pkt_capture_offload_deliver_indication_handler(
 		(msg_word + 1);
 
 	nbuf_len = offload_deliver_msg->tx_mpdu_bytes;
+	mpdu = buf + sizeof(struct htt_tx_offload_deliver_ind_hdr_t);
+	pkt_format = offload_deliver_msg->format;
+	tid = offload_deliver_msg->tid_num;
+
+	/* drop unmatched frames before copying them out of the message */
+	if (pkt_format == TXRX_PKTCAPTURE_PKT_FORMAT_8023)
+		capture = pkt_capture_filter_ether_buf(mpdu, nbuf_len, tid);
+	else
+		capture = pkt_capture_filter_80211_buf(mpdu, nbuf_len);
+
+	if (!capture)
+		return;
 
 	netbuf = qdf_nbuf_alloc(NULL,
 				roundup(nbuf_len + RESERVE_BYTES, 4),
@@ -841,9 +863,7 @@ void pkt_capture_offload_deliver_indication_handler(
 
 	qdf_nbuf_put_tail(netbuf, nbuf_len);
 
-	qdf_mem_copy(qdf_nbuf_data(netbuf),
-		     buf + sizeof(struct htt_tx_offload_deliver_ind_hdr_t),
-		     nbuf_len);
+	qdf_mem_copy(qdf_nbuf_data(netbuf), mpdu, nbuf_len);
 
 	qdf_nbuf_push_head(
 			netbuf,
@@ -853,8 +873,6 @@ void pkt_capture_offload_deliver_indication_handler(
 		     sizeof(struct htt_tx_data_hdr_information));
 
 	status = offload_deliver_msg->status;
-	pkt_format = offload_deliver_msg->format;
-	tid = offload_deliver_msg->tid_num;
 
 	pkt_capture_datapkt_process(
 			vdev_id,
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: Implement the packet capture filter which is evaluated before
+ * data and mgmt frames are copied for the monitor interface.
+ */
+
+#include "wlan_pkt_capture_main.h"
+#include "wlan_pkt_capture_filter.h"
+#include "wlan_pkt_capture_mgmt_txrx.h"
+#include <enet.h>
+#include <cds_ieee80211_common.h>
+
+#define PKT_CAPTURE_FC0_TYPE_SHIFT	2
+#define PKT_CAPTURE_FILTER_MAX_ADDR	3
+
+/**
+ * struct pkt_capture_filter_frame - frame fields the filter matches on
+ * @type: 802.11 frame type
+ * @subtype: 802.11 frame subtype
+ * @num_addr: number of valid entries in @addr
+ * @addr: addresses carried by the frame
+ * @ethertype: ethertype, 0 if not known
+ * @tid: tid, WLAN_INVALID_TID if not known
+ */
+struct pkt_capture_filter_frame {
+	uint8_t type;
+	uint8_t subtype;
+	uint8_t num_addr;
+	uint8_t *addr[PKT_CAPTURE_FILTER_MAX_ADDR];
+	uint16_t ethertype;
+	uint8_t tid;
+};
+
+void pkt_capture_filter_init(struct pkt_capture_vdev_priv *vdev_priv)
+{
+	qdf_spinlock_create(&vdev_priv->filter_lock);
+	qdf_mem_zero(&vdev_priv->filter, sizeof(vdev_priv->filter));
+	qdf_mem_zero(&vdev_priv->filter_stats,
+		     sizeof(vdev_priv->filter_stats));
+}
+
+void pkt_capture_filter_deinit(struct pkt_capture_vdev_priv *vdev_priv)
+{
+	qdf_spinlock_destroy(&vdev_priv->filter_lock);
+}
+
+QDF_STATUS pkt_capture_set_filter(struct wlan_objmgr_vdev *vdev,
+				  struct pkt_capture_filter *filter)
+{
+	struct pkt_capture_vdev_priv *vdev_priv;
+
+	if (!vdev || !filter) {
+		pkt_capture_err("vdev or filter is NULL");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	if (filter->num_rules > PKT_CAPTURE_FILTER_MAX_RULES) {
+		pkt_capture_err("Invalid number of rules %u",
+				filter->num_rules);
+		return QDF_STATUS_E_INVAL;
+	}
+
+	vdev_priv = pkt_capture_vdev_get_priv(vdev);
+	if (!vdev_priv) {
+		pkt_capture_err("vdev priv is NULL");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	qdf_spin_lock_bh(&vdev_priv->filter_lock);
+	qdf_mem_copy(&vdev_priv->filter, filter, sizeof(*filter));
+	qdf_mem_zero(&vdev_priv->filter_stats,
+		     sizeof(vdev_priv->filter_stats));
+	qdf_spin_unlock_bh(&vdev_priv->filter_lock);
+
+	pkt_capture_debug("Installed capture filter with %u rules",
+			  filter->num_rules);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+QDF_STATUS pkt_capture_get_filter_stats(struct wlan_objmgr_vdev *vdev,
+					struct pkt_capture_filter_stats *stats)
+{
+	struct pkt_capture_vdev_priv *vdev_priv;
+
+	if (!vdev || !stats) {
+		pkt_capture_err("vdev or stats is NULL");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	vdev_priv = pkt_capture_vdev_get_priv(vdev);
+	if (!vdev_priv) {
+		pkt_capture_err("vdev priv is NULL");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	qdf_spin_lock_bh(&vdev_priv->filter_lock);
+	qdf_mem_copy(stats, &vdev_priv->filter_stats, sizeof(*stats));
+	qdf_spin_unlock_bh(&vdev_priv->filter_lock);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * pkt_capture_filter_rule_match() - check if a frame matches a filter rule
+ * @rule: filter rule
+ * @frame: parsed frame fields
+ *
+ * Return: true if all the fields selected by the rule match
+ */
+static bool
+pkt_capture_filter_rule_match(struct pkt_capture_filter_rule *rule,
+			      struct pkt_capture_filter_frame *frame)
+{
+	uint8_t i;
+
+	if ((rule->match_flags & PKT_CAPTURE_FILTER_MATCH_TYPE) &&
+	    rule->type != frame->type)
+		return false;
+
+	if ((rule->match_flags & PKT_CAPTURE_FILTER_MATCH_SUBTYPE) &&
+	    rule->subtype != frame->subtype)
+		return false;
+
+	if ((rule->match_flags & PKT_CAPTURE_FILTER_MATCH_ETHERTYPE) &&
+	    rule->ethertype != frame->ethertype)
+		return false;
+
+	if ((rule->match_flags & PKT_CAPTURE_FILTER_MATCH_TID) &&
+	    rule->tid != frame->tid)
+		return false;
+
+	if (!(rule->match_flags & PKT_CAPTURE_FILTER_MATCH_ADDR))
+		return true;
+
+	for (i = 0; i < frame->num_addr; i++) {
+		if (!qdf_mem_cmp(rule->addr.bytes, frame->addr[i],
+				 QDF_MAC_ADDR_SIZE))
+			return true;
+	}
+
+	return false;
+}
+
+/**
+ * pkt_capture_filter_frame() - run the capture filter on a parsed frame
+ * @frame: parsed frame fields
+ *
+ * A frame is captured when no filter is installed or when any of the
+ * installed rules matches.
+ *
+ * Return: true if the frame is to be captured, false otherwise
+ */
+static bool pkt_capture_filter_frame(struct pkt_capture_filter_frame *frame)
+{
+	struct pkt_capture_vdev_priv *vdev_priv;
+	struct wlan_objmgr_vdev *vdev;
+	bool match = false;
+	uint8_t i;
+
+	vdev = pkt_capture_get_vdev();
+	if (!vdev)
+		return true;
+
+	vdev_priv = pkt_capture_vdev_get_priv(vdev);
+	if (!vdev_priv || !vdev_priv->filter.num_rules)
+		return true;
+
+	qdf_spin_lock_bh(&vdev_priv->filter_lock);
+	for (i = 0; i < vdev_priv->filter.num_rules; i++) {
+		if (pkt_capture_filter_rule_match(&vdev_priv->filter.rules[i],
+						  frame)) {
+			match = true;
+			break;
+		}
+	}
+
+	if (match)
+		vdev_priv->filter_stats.accepted++;
+	else
+		vdev_priv->filter_stats.rejected++;
+	qdf_spin_unlock_bh(&vdev_priv->filter_lock);
+
+	return match;
+}
+
+bool pkt_capture_filter_ether_buf(uint8_t *data, uint32_t len, uint8_t tid)
+{
+	struct pkt_capture_filter_frame frame = {0};
+	struct ethernet_hdr_t *eth_hdr;
+	struct llc_snap_hdr_t *llc_hdr;
+
+	if (!data || len < sizeof(*eth_hdr))
+		return true;
+
+	eth_hdr = (struct ethernet_hdr_t *)data;
+
+	frame.type = IEEE80211_FC0_TYPE_DATA >> PKT_CAPTURE_FC0_TYPE_SHIFT;
+	frame.tid = tid;
+	if (tid != WLAN_INVALID_TID)
+		frame.subtype = QDF_IEEE80211_FC0_SUBTYPE_QOS >>
+					IEEE80211_FC0_SUBTYPE_SHIFT;
+
+	frame.addr[frame.num_addr++] = eth_hdr->dest_addr;
+	frame.addr[frame.num_addr++] = eth_hdr->src_addr;
+
+	frame.ethertype = (eth_hdr->ethertype[0] << 8) |
+			  eth_hdr->ethertype[1];
+	if (frame.ethertype < ETH_P_802_3_MIN) {
+		frame.ethertype = 0;
+		if (len >= sizeof(*eth_hdr) + sizeof(*llc_hdr)) {
+			llc_hdr = (struct llc_snap_hdr_t *)(eth_hdr + 1);
+			frame.ethertype = (llc_hdr->ethertype[0] << 8) |
+					  llc_hdr->ethertype[1];
+		}
+	}
+
+	return pkt_capture_filter_frame(&frame);
+}
+
+bool pkt_capture_filter_80211_buf(uint8_t *data, uint32_t len)
+{
+	struct pkt_capture_filter_frame frame = {0};
+	struct ieee80211_frame *wh;
+
+	if (!data || len < sizeof(*wh))
+		return true;
+
+	wh = (struct ieee80211_frame *)data;
+
+	frame.type = (wh->i_fc[0] & IEEE80211_FC0_TYPE_MASK) >>
+			PKT_CAPTURE_FC0_TYPE_SHIFT;
+	frame.subtype = (wh->i_fc[0] & IEEE80211_FC0_SUBTYPE_MASK) >>
+			IEEE80211_FC0_SUBTYPE_SHIFT;
+	frame.tid = WLAN_INVALID_TID;
+	frame.addr[frame.num_addr++] = wh->i_addr1;
+	frame.addr[frame.num_addr++] = wh->i_addr2;
+	frame.addr[frame.num_addr++] = wh->i_addr3;
+
+	return pkt_capture_filter_frame(&frame);
+}
+
+bool pkt_capture_filter_ether_pkt(qdf_nbuf_t nbuf, uint8_t tid)
+{
+	return pkt_capture_filter_ether_buf(qdf_nbuf_data(nbuf),
+					    qdf_nbuf_len(nbuf), tid);
+}
+
+bool pkt_capture_filter_80211_pkt(qdf_nbuf_t nbuf)
+{
+	return pkt_capture_filter_80211_buf(qdf_nbuf_data(nbuf),
+					    qdf_nbuf_len(nbuf));
+}
@@ -25,6 +25,7 @@
 #include "wlan_pkt_capture_main.h"
 #include "wlan_pkt_capture_priv.h"
 #include "wlan_pkt_capture_mgmt_txrx.h"
+#include "wlan_pkt_capture_filter.h"
 #include "wlan_mlme_main.h"
 #include "wlan_lmac_if_api.h"
 #include "wlan_mgmt_txrx_utils_api.h"
@@ -339,6 +340,9 @@ void pkt_capture_mgmt_tx(struct wlan_objmgr_pdev *pdev,
 		return;
 	}
 
+	if (!pkt_capture_filter_80211_pkt(nbuf))
+		return;
+
 	nbuf_len = qdf_nbuf_len(nbuf);
 	wbuf = qdf_nbuf_alloc(NULL, roundup(nbuf_len + RESERVE_BYTES, 4),
 			      RESERVE_BYTES, 4, false);
@@ -393,6 +397,9 @@ pkt_capture_mgmt_tx_completion(struct wlan_objmgr_pdev *pdev,
 	if (!nbuf)
 		return;
 
+	if (!pkt_capture_filter_80211_pkt(nbuf))
+		return;
+
 	nbuf_len = qdf_nbuf_len(nbuf);
 	wbuf = qdf_nbuf_alloc(NULL, roundup(nbuf_len + RESERVE_BYTES, 4),
 			      RESERVE_BYTES, 4, false);
@@ -435,6 +442,9 @@ pkt_capture_mgmt_rx_data_cb(struct wlan_objmgr_psoc *psoc,
 	if (!(pkt_capture_get_mode(psoc) & PKT_CAPTURE_MODE_MGMT_ONLY))
 		return QDF_STATUS_E_FAILURE;
 
+	if (!pkt_capture_filter_80211_pkt(wbuf))
+		return QDF_STATUS_SUCCESS;
+
 	buf_len = qdf_nbuf_len(wbuf);
 	nbuf = qdf_nbuf_alloc(NULL, roundup(
 				  buf_len + RESERVE_BYTES, 4),
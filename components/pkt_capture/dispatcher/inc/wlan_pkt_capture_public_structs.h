@@ -19,6 +19,8 @@
 #ifndef _WLAN_PKT_CAPTURE_PUBLIC_STRUCTS_H_
 #define _WLAN_PKT_CAPTURE_PUBLIC_STRUCTS_H_
 
+#include <qdf_types.h>
+
 /**
  * enum pkt_capture_mode - packet capture modes
  * @PACKET_CAPTURE_MODE_DISABLE: packet capture mode disable
@@ -33,6 +35,54 @@ enum pkt_capture_mode {
 	PACKET_CAPTURE_MODE_DATA_MGMT,
 };
 
+#define PKT_CAPTURE_FILTER_MAX_RULES 8
+
+/**
+ * enum pkt_capture_filter_match - fields a capture filter rule matches on
+ * @PKT_CAPTURE_FILTER_MATCH_TYPE: 802.11 frame type (mgmt/ctrl/data)
+ * @PKT_CAPTURE_FILTER_MATCH_SUBTYPE: 802.11 frame subtype
+ * @PKT_CAPTURE_FILTER_MATCH_ADDR: any of the frame addresses
+ * @PKT_CAPTURE_FILTER_MATCH_ETHERTYPE: ethertype of a data frame
+ * @PKT_CAPTURE_FILTER_MATCH_TID: TID of a data frame
+ */
+enum pkt_capture_filter_match {
+	PKT_CAPTURE_FILTER_MATCH_TYPE = BIT(0),
+	PKT_CAPTURE_FILTER_MATCH_SUBTYPE = BIT(1),
+	PKT_CAPTURE_FILTER_MATCH_ADDR = BIT(2),
+	PKT_CAPTURE_FILTER_MATCH_ETHERTYPE = BIT(3),
+	PKT_CAPTURE_FILTER_MATCH_TID = BIT(4),
+};
+
+/**
+ * struct pkt_capture_filter_rule - packet capture filter rule
+ * @match_flags: bitmap of enum pkt_capture_filter_match, all fields set
+ *               here must match for the rule to match
+ * @type: 802.11 frame type, IEEE80211_FC0_TYPE_* shifted to bits 0-1
+ * @subtype: 802.11 frame subtype, IEEE80211_FC0_SUBTYPE_* shifted to
+ *           bits 0-3
+ * @addr: mac address compared against the addresses of the frame
+ * @ethertype: ethertype in host byte order
+ * @tid: traffic identifier
+ */
+struct pkt_capture_filter_rule {
+	uint32_t match_flags;
+	uint8_t type;
+	uint8_t subtype;
+	struct qdf_mac_addr addr;
+	uint16_t ethertype;
+	uint8_t tid;
+};
+
+/**
+ * struct pkt_capture_filter - packet capture filter
+ * @num_rules: number of valid rules, 0 means capture everything
+ * @rules: filter rules, a frame is captured if any rule matches
+ */
+struct pkt_capture_filter {
+	uint8_t num_rules;
+	struct pkt_capture_filter_rule rules[PKT_CAPTURE_FILTER_MAX_RULES];
+};
+
 /**
  * struct mgmt_offload_event_params - Management offload event params
  * @tsf_l32: The lower 32 bits of the TSF
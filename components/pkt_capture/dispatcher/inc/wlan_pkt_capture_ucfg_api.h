@@ -267,6 +267,48 @@ void ucfg_pkt_capture_record_channel(struct wlan_objmgr_vdev *vdev);
 int
 ucfg_pkt_capture_register_wma_callbacks(struct wlan_objmgr_psoc *psoc,
 					struct pkt_capture_callbacks *cb_obj);
+
+/**
+ * ucfg_pkt_capture_set_filter() - Install packet capture filter
+ * @vdev: pointer to vdev object
+ * @filter: filter to install, a filter without rules clears the filter
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS ucfg_pkt_capture_set_filter(struct wlan_objmgr_vdev *vdev,
+				       struct pkt_capture_filter *filter);
+
+/**
+ * ucfg_pkt_capture_get_filter_stats() - Get packet capture filter stats
+ * @vdev: pointer to vdev object
+ * @accepted: number of frames which matched the filter
+ * @rejected: number of frames dropped by the filter
+ *
+ * Return: QDF_STATUS
+ */
+QDF_STATUS ucfg_pkt_capture_get_filter_stats(struct wlan_objmgr_vdev *vdev,
+					     uint32_t *accepted,
+					     uint32_t *rejected);
+
+/**
+ * ucfg_pkt_capture_filter_ether_pkt() - Run packet capture filter on a
+ * 802.3 data frame before it is copied for the monitor interface
+ * @nbuf: netbuf pointing to the ethernet header
+ * @tid: tid of the frame
+ *
+ * Return: true if the frame is to be captured, false otherwise
+ */
+bool ucfg_pkt_capture_filter_ether_pkt(qdf_nbuf_t nbuf, uint8_t tid);
+
+/**
+ * ucfg_pkt_capture_filter_80211_buf() - Run packet capture filter on a
+ * 802.11 frame offloaded by firmware, before it is copied into a netbuf
+ * @buf: pointer to the 802.11 header
+ * @len: length of the frame
+ *
+ * Return: true if the frame is to be captured, false otherwise
+ */
+bool ucfg_pkt_capture_filter_80211_buf(uint8_t *buf, uint32_t len);
 #else
 static inline
 QDF_STATUS ucfg_pkt_capture_init(void)
@@ -396,5 +438,32 @@ static inline void
 ucfg_pkt_capture_record_channel(struct wlan_objmgr_vdev *vdev)
 {
 }
+
+static inline QDF_STATUS
+ucfg_pkt_capture_set_filter(struct wlan_objmgr_vdev *vdev,
+			    struct pkt_capture_filter *filter)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+
+static inline QDF_STATUS
+ucfg_pkt_capture_get_filter_stats(struct wlan_objmgr_vdev *vdev,
+				  uint32_t *accepted,
+				  uint32_t *rejected)
+{
+	return QDF_STATUS_E_NOSUPPORT;
+}
+
+static inline bool
+ucfg_pkt_capture_filter_ether_pkt(qdf_nbuf_t nbuf, uint8_t tid)
+{
+	return true;
+}
+
+static inline bool
+ucfg_pkt_capture_filter_80211_buf(uint8_t *buf, uint32_t len)
+{
+	return true;
+}
 #endif /* WLAN_FEATURE_PKT_CAPTURE */
 #endif /* _WLAN_PKT_CAPTURE_UCFG_API_H_ */
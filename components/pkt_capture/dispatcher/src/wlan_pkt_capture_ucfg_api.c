@@ -28,6 +28,7 @@
 #include "target_if_pkt_capture.h"
 #include "wlan_pkt_capture_data_txrx.h"
 #include "wlan_pkt_capture_tgt_api.h"
+#include "wlan_pkt_capture_filter.h"
 
 enum pkt_capture_mode ucfg_pkt_capture_get_mode(struct wlan_objmgr_psoc *psoc)
 {
@@ -307,3 +308,36 @@ ucfg_pkt_capture_register_wma_callbacks(struct wlan_objmgr_psoc *psoc,
 
 	return 0;
 }
+
+QDF_STATUS ucfg_pkt_capture_set_filter(struct wlan_objmgr_vdev *vdev,
+				       struct pkt_capture_filter *filter)
+{
+	return pkt_capture_set_filter(vdev, filter);
+}
+
+QDF_STATUS ucfg_pkt_capture_get_filter_stats(struct wlan_objmgr_vdev *vdev,
+					     uint32_t *accepted,
+					     uint32_t *rejected)
+{
+	struct pkt_capture_filter_stats stats;
+	QDF_STATUS status;
+
+	status = pkt_capture_get_filter_stats(vdev, &stats);
+	if (QDF_IS_STATUS_ERROR(status))
+		return status;
+
+	*accepted = stats.accepted;
+	*rejected = stats.rejected;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+bool ucfg_pkt_capture_filter_ether_pkt(qdf_nbuf_t nbuf, uint8_t tid)
+{
+	return pkt_capture_filter_ether_pkt(nbuf, tid);
+}
+
+bool ucfg_pkt_capture_filter_80211_buf(uint8_t *buf, uint32_t len)
+{
+	return pkt_capture_filter_80211_buf(buf, len);
+}
@@ -133,6 +133,9 @@ target_if_mgmt_offload_data_event_handler(void *handle, uint8_t *data,
 		return -EINVAL;
 	}
 
+	if (!ucfg_pkt_capture_filter_80211_buf(params.buf, params.buf_len))
+		return 0;
+
 	wbuf = qdf_nbuf_alloc(NULL,
 			      roundup(params.buf_len + RESERVE_BYTES, 4),
 			      RESERVE_BYTES, 4, false);
@@ -59,6 +59,16 @@ QDF_STATUS bmi_done(struct ol_context *ol_ctx);
 void bmi_target_ready(struct hif_opaque_softc *scn, void *cfg_ctx);
 QDF_STATUS bmi_download_firmware(struct ol_context *ol_ctx);
 
+/**
+ * ol_fw_cache_flush() - release the verified board data and OTP images
+ *
+ * The images are kept across driver start/stop cycles to avoid reading
+ * and hashing them again, this drops them.
+ *
+ * Return: None
+ */
+void ol_fw_cache_flush(void);
+
 #else /* WLAN_FEATURE_BMI */
 
 static inline QDF_STATUS
@@ -71,6 +81,10 @@ static inline void ol_cds_free(void)
 {
 }
 
+static inline void ol_fw_cache_flush(void)
+{
+}
+
 static inline void
 ol_init_ini_config(struct ol_context *ol_ctx, struct ol_config_info *cfg)
 {
@@ -116,6 +116,7 @@ enum ATH_BIN_FILE {
 	ATH_BOARD_DATA_FILE,
 	ATH_FLASH_FILE,
 	ATH_SETUP_FILE,
+	ATH_BIN_FILE_MAX,
 };
 
 #if defined(QCA_WIFI_3_0_ADRASTEA)
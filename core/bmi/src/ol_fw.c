@@ -42,6 +42,7 @@
 #include "hif_main.h"
 
 #include "i_bmi.h"
+#include "qdf_str.h"
 #include "qwlan_version.h"
 #include "wlan_policy_mgr_api.h"
 #include "dbglog_host.h"
@@ -132,6 +133,202 @@ end:
 }
 #endif
 
+#define OL_FW_CACHE_NAME_LEN	64
+
+/**
+ * struct ol_fw_cache_entry - verified image kept across idle restarts
+ * @fw: firmware entry, released only when the cache is flushed
+ * @name: configured file name the entry was loaded for
+ * @board_id: board id the entry was loaded for
+ *
+ * Board data and OTP images are small, are loaded on every driver start
+ * and do not change while the module is loaded, so the verified images
+ * are kept instead of being read and hashed again on the next start.
+ */
+struct ol_fw_cache_entry {
+	const struct firmware *fw;
+	char name[OL_FW_CACHE_NAME_LEN];
+	uint16_t board_id;
+};
+
+/**
+ * struct ol_fw_file_stats - timing of the last transfer of a file
+ * @size: size of the image
+ * @load_us: time spent fetching the image
+ * @hash_wait_us: time the transfer waited for the hash check to finish
+ * @xfer_us: time spent transferring the image over BMI
+ * @cache_hits: number of transfers served from the image cache
+ */
+struct ol_fw_file_stats {
+	uint32_t size;
+	uint32_t load_us;
+	uint32_t hash_wait_us;
+	uint32_t xfer_us;
+	uint32_t cache_hits;
+};
+
+static struct ol_fw_cache_entry ol_fw_cache[ATH_BIN_FILE_MAX];
+static struct ol_fw_file_stats ol_fw_stats[ATH_BIN_FILE_MAX];
+
+/**
+ * ol_fw_cache_supported() - check if a file type is kept in the cache
+ * @file: file type
+ *
+ * Return: true for board data and OTP images
+ */
+static inline bool ol_fw_cache_supported(enum ATH_BIN_FILE file)
+{
+	return file == ATH_BOARD_DATA_FILE || file == ATH_OTP_FILE;
+}
+
+/**
+ * ol_fw_cache_get() - look up a verified image
+ * @file: file type
+ * @name: configured file name
+ * @board_id: board id
+ *
+ * Return: cached firmware entry, NULL if there is none for @name
+ */
+static const struct firmware *
+ol_fw_cache_get(enum ATH_BIN_FILE file, const char *name, uint16_t board_id)
+{
+	struct ol_fw_cache_entry *entry = &ol_fw_cache[file];
+
+	if (!ol_fw_cache_supported(file) || !entry->fw || !name)
+		return NULL;
+
+	if (entry->board_id != board_id ||
+	    strncmp(entry->name, name, sizeof(entry->name)))
+		return NULL;
+
+	return entry->fw;
+}
+
+/**
+ * ol_fw_cache_put() - keep a verified image for the next start
+ * @file: file type
+ * @name: configured file name
+ * @board_id: board id
+ * @fw: firmware entry, owned by the cache on success
+ *
+ * Return: true if @fw is now owned by the cache
+ */
+static bool ol_fw_cache_put(enum ATH_BIN_FILE file, const char *name,
+			    uint16_t board_id, const struct firmware *fw)
+{
+	struct ol_fw_cache_entry *entry = &ol_fw_cache[file];
+
+	if (!ol_fw_cache_supported(file) || !name ||
+	    strlen(name) >= sizeof(entry->name))
+		return false;
+
+	if (entry->fw)
+		release_firmware(entry->fw);
+
+	entry->fw = fw;
+	entry->board_id = board_id;
+	qdf_str_lcopy(entry->name, name, sizeof(entry->name));
+
+	return true;
+}
+
+void ol_fw_cache_flush(void)
+{
+	int i;
+
+	for (i = 0; i < ATH_BIN_FILE_MAX; i++) {
+		if (ol_fw_cache[i].fw)
+			release_firmware(ol_fw_cache[i].fw);
+		qdf_mem_zero(&ol_fw_cache[i], sizeof(ol_fw_cache[i]));
+	}
+}
+
+#ifdef FEATURE_SECURE_FIRMWARE
+/**
+ * struct ol_fw_hash_ctx - hash check running alongside the BMI transfer
+ * @work: work running the hash check
+ * @dev: device
+ * @data: image to check
+ * @size: size of @data
+ * @file: file type
+ * @ret: result of ol_check_fw_hash
+ */
+struct ol_fw_hash_ctx {
+	qdf_work_t work;
+	struct device *dev;
+	const u8 *data;
+	u32 size;
+	enum ATH_BIN_FILE file;
+	int ret;
+};
+
+static void ol_fw_hash_work(void *arg)
+{
+	struct ol_fw_hash_ctx *hash_ctx = arg;
+
+	hash_ctx->ret = ol_check_fw_hash(hash_ctx->dev, hash_ctx->data,
+					 hash_ctx->size, hash_ctx->file);
+}
+
+/**
+ * ol_fw_hash_start() - start checking the image hash in the background
+ * @hash_ctx: hash context
+ * @qdf_dev: QDF device
+ * @data: image to check
+ * @size: size of @data
+ * @file: file type
+ *
+ * The image is only written to target RAM while the check runs, the
+ * target does not execute anything before ol_fw_hash_wait() returned
+ * success, so a mismatch still aborts the download.
+ *
+ * Return: None
+ */
+static void ol_fw_hash_start(struct ol_fw_hash_ctx *hash_ctx,
+			     qdf_device_t qdf_dev, const u8 *data, u32 size,
+			     enum ATH_BIN_FILE file)
+{
+	hash_ctx->dev = qdf_dev->dev;
+	hash_ctx->data = data;
+	hash_ctx->size = size;
+	hash_ctx->file = file;
+	hash_ctx->ret = 0;
+	qdf_create_work(qdf_dev, &hash_ctx->work, ol_fw_hash_work, hash_ctx);
+	qdf_sched_work(qdf_dev, &hash_ctx->work);
+}
+
+/**
+ * ol_fw_hash_wait() - wait for the background hash check
+ * @hash_ctx: hash context
+ * @qdf_dev: QDF device
+ *
+ * Return: 0 if the image is valid, error otherwise
+ */
+static int ol_fw_hash_wait(struct ol_fw_hash_ctx *hash_ctx,
+			   qdf_device_t qdf_dev)
+{
+	qdf_flush_work(&hash_ctx->work);
+	qdf_destroy_work(qdf_dev, &hash_ctx->work);
+
+	return hash_ctx->ret;
+}
+#else
+struct ol_fw_hash_ctx {
+};
+
+static inline void ol_fw_hash_start(struct ol_fw_hash_ctx *hash_ctx,
+				    qdf_device_t qdf_dev, const u8 *data,
+				    u32 size, enum ATH_BIN_FILE file)
+{
+}
+
+static inline int ol_fw_hash_wait(struct ol_fw_hash_ctx *hash_ctx,
+				  qdf_device_t qdf_dev)
+{
+	return 0;
+}
+#endif
+
 /**
  * ol_board_id_to_filename() - Auto BDF board_id to filename conversion
  * @old_name: name of the default board data file
@@ -186,6 +383,11 @@ __ol_transfer_bin_file(struct ol_context *ol_ctx, enum ATH_BIN_FILE file,
 	uint32_t target_type = tgt_info->target_type;
 	struct bmi_info *bmi_ctx = GET_BMI_CONTEXT(ol_ctx);
 	qdf_device_t qdf_dev = ol_ctx->qdf_dev;
+	struct ol_fw_hash_ctx hash_ctx;
+	struct ol_fw_file_stats *stats;
+	bool hash_pending = false;
+	bool cached = false;
+	uint64_t start_us, xfer_start_us = 0, wait_start_us = 0;
 	int i;
 
 	/*
@@ -302,8 +504,16 @@ __ol_transfer_bin_file(struct ol_context *ol_ctx, enum ATH_BIN_FILE file,
 		break;
 	}
 
-	/* For FTM mode. bd.bin is used if there is no utf.bin */
-	if (file == ATH_BOARD_DATA_FILE) {
+	stats = &ol_fw_stats[file];
+	start_us = qdf_get_log_timestamp_usecs();
+
+	fw_entry = ol_fw_cache_get(file, filename, bmi_ctx->board_id);
+	if (fw_entry) {
+		BMI_DBG("%s: Using cached %s", __func__, filename);
+		cached = true;
+		stats->cache_hits++;
+	} else if (file == ATH_BOARD_DATA_FILE) {
+		/* For FTM mode. bd.bin is used if there is no utf.bin */
 		for (i = 0; i < bd_files; i++) {
 			if (bd_id_filename[i]) {
 				BMI_DBG("%s: Trying to load %s",
@@ -347,14 +557,20 @@ __ol_transfer_bin_file(struct ol_context *ol_ctx, enum ATH_BIN_FILE file,
 	fw_entry_size = fw_entry->size;
 	temp_eeprom = NULL;
 
-#ifdef FEATURE_SECURE_FIRMWARE
-	if (ol_check_fw_hash(qdf_dev->dev, fw_entry->data,
-			     fw_entry_size, file)) {
-		BMI_ERR("Hash Check failed for file:%s", filename);
-		status = -EINVAL;
-		goto end;
+	stats->size = fw_entry_size;
+	stats->hash_wait_us = 0;
+	xfer_start_us = qdf_get_log_timestamp_usecs();
+	stats->load_us = xfer_start_us - start_us;
+
+	/*
+	 * Check the hash while the image is transferred, cached images were
+	 * already verified when they were first loaded.
+	 */
+	if (!cached) {
+		ol_fw_hash_start(&hash_ctx, qdf_dev, fw_entry->data,
+				 fw_entry_size, file);
+		hash_pending = true;
 	}
-#endif
 
 	if (file == ATH_BOARD_DATA_FILE) {
 		uint32_t board_ext_address = 0;
@@ -364,7 +580,7 @@ __ol_transfer_bin_file(struct ol_context *ol_ctx, enum ATH_BIN_FILE file,
 		if (!temp_eeprom) {
 			BMI_ERR("%s: Memory allocation failed", __func__);
 			status = -ENOMEM;
-			goto release_fw;
+			goto end;
 		}
 
 		qdf_mem_copy(temp_eeprom, (uint8_t *) fw_entry->data,
@@ -492,12 +708,32 @@ __ol_transfer_bin_file(struct ol_context *ol_ctx, enum ATH_BIN_FILE file,
 	}
 
 end:
+	wait_start_us = qdf_get_log_timestamp_usecs();
+	/* The transfer may have failed before it was stamped */
+	if (xfer_start_us)
+		stats->xfer_us = wait_start_us - xfer_start_us;
+	if (hash_pending) {
+		if (ol_fw_hash_wait(&hash_ctx, qdf_dev)) {
+			BMI_ERR("Hash Check failed for file:%s", filename);
+			status = -EINVAL;
+		}
+		stats->hash_wait_us = qdf_get_log_timestamp_usecs() -
+				      wait_start_us;
+	}
+
 	if (temp_eeprom)
 		qdf_mem_free(temp_eeprom);
 
+	BMI_INFO("%s: size %u load %u us xfer %u us hash wait %u us cache hits %u",
+		 filename ? filename : " ", stats->size, stats->load_us,
+		 stats->xfer_us, stats->hash_wait_us, stats->cache_hits);
+
 release_fw:
-	if (fw_entry)
-		release_firmware(fw_entry);
+	if (fw_entry && !cached) {
+		if (status || !ol_fw_cache_put(file, filename,
+					       bmi_ctx->board_id, fw_entry))
+			release_firmware(fw_entry);
+	}
 
 	for (i = 0; i < bd_files; i++) {
 		if (bd_id_filename[i]) {
@@ -45,6 +45,7 @@
 #include <cdp_txrx_handle.h>
 #include <wlan_pkt_capture_ucfg_api.h>
 #include <ol_txrx.h>
+#include <ol_txrx_prof.h>
 /*--- target->host HTT message dispatch function ----------------------------*/
 
 #ifndef DEBUG_CREDIT
@@ -813,9 +814,11 @@ void htt_t2h_msg_handler(void *context, HTC_PACKET *pkt)
 			WARN_ON(1);
 			break;
 		}
+		ol_txrx_prof_begin(OL_TXRX_PROF_RX);
 		ol_rx_indication_handler(pdev->txrx_pdev,
 					 htt_t2h_msg, peer_id,
 					 tid, num_mpdu_ranges);
+		ol_txrx_prof_end(OL_TXRX_PROF_RX);
 
 		if (pdev->cfg.is_high_latency)
 			return;
@@ -1020,9 +1023,11 @@ void htt_t2h_msg_handler(void *context, HTC_PACKET *pkt)
 			break;
 		}
 
+		ol_txrx_prof_begin(OL_TXRX_PROF_RX);
 		ol_rx_in_order_indication_handler(pdev->txrx_pdev,
 						  htt_t2h_msg, peer_id,
 						  tid, offload_ind);
+		ol_txrx_prof_end(OL_TXRX_PROF_RX);
 		break;
 	}
 
@@ -1163,8 +1168,10 @@ void htt_t2h_msg_handler_fast(void *context, qdf_nbuf_t *cmpl_msdus,
 				WARN_ON(1);
 				break;
 			}
+			ol_txrx_prof_begin(OL_TXRX_PROF_RX);
 			ol_rx_indication_handler(pdev->txrx_pdev, htt_t2h_msg,
 						 peer_id, tid, num_mpdu_ranges);
+			ol_txrx_prof_end(OL_TXRX_PROF_RX);
 			break;
 		}
 		case HTT_T2H_MSG_TYPE_TX_COMPL_IND:
@@ -1401,9 +1408,11 @@ void htt_t2h_msg_handler_fast(void *context, qdf_nbuf_t *cmpl_msdus,
 				break;
 			}
 
+			ol_txrx_prof_begin(OL_TXRX_PROF_RX);
 			ol_rx_in_order_indication_handler(
 					pdev->txrx_pdev, htt_t2h_msg,
 					peer_id, tid, offload_ind);
+			ol_txrx_prof_end(OL_TXRX_PROF_RX);
 			break;
 		}
 		default:
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: ol_txrx_prof.h
+ *
+ * Sampling profiler of the per packet cost of the TX and RX datapath.
+ * One packet out of every sample rate packets of a CPU is followed from
+ * its entry point, and the time spent up to each stage boundary it crosses
+ * is added to the histogram of that stage. A boundary is only recorded
+ * the first time the sample crosses it, so for a batch (an RX indication
+ * or a TX list) the first packet reaching a stage is the one accounted.
+ *
+ * The hooks only account in softirq context or with bottom halves
+ * disabled, where the per CPU data can not be raced with. They are skipped
+ * elsewhere, so an RX delivery deferred to the RX thread ends the sample at
+ * the indication and is not accounted.
+ *
+ * The hooks live in the txrx layer only. A TX sample begins when the OS
+ * shim hands the packet to the registered tx op, and the RX delivery is
+ * timed around the registered rx op.
+ */
+
+#ifndef _OL_TXRX_PROF_H_
+#define _OL_TXRX_PROF_H_
+
+#include <qdf_types.h>
+#include <qdf_status.h>
+
+/**
+ * enum ol_txrx_prof_dir - direction of a profiled packet
+ * @OL_TXRX_PROF_TX: from the txrx tx op to the CE enqueue
+ * @OL_TXRX_PROF_RX: from the HTT RX indication to the network stack
+ * @OL_TXRX_PROF_DIR_MAX: number of directions
+ */
+enum ol_txrx_prof_dir {
+	OL_TXRX_PROF_TX,
+	OL_TXRX_PROF_RX,
+	OL_TXRX_PROF_DIR_MAX,
+};
+
+/**
+ * enum ol_txrx_prof_stage - stage boundaries of the datapath
+ * @OL_TXRX_PROF_TX_DESC_ALLOC: TX descriptor allocated
+ * @OL_TXRX_PROF_TX_ENCAP: HTT/HTC headers and fragments filled
+ * @OL_TXRX_PROF_TX_CE_ENQUEUE: packet posted to the CE ring
+ * @OL_TXRX_PROF_RX_INDICATION: MSDUs popped from the RX ring
+ * @OL_TXRX_PROF_RX_REORDER: MSDUs released by the reorder buffer
+ * @OL_TXRX_PROF_RX_PN: PN replay check done
+ * @OL_TXRX_PROF_RX_DECAP: MSDU descriptors processed and decapsulated
+ * @OL_TXRX_PROF_RX_DELIVER: packet handed to the OS shim rx op
+ * @OL_TXRX_PROF_STAGE_MAX: number of stages
+ */
+enum ol_txrx_prof_stage {
+	OL_TXRX_PROF_TX_DESC_ALLOC,
+	OL_TXRX_PROF_TX_ENCAP,
+	OL_TXRX_PROF_TX_CE_ENQUEUE,
+	OL_TXRX_PROF_RX_INDICATION,
+	OL_TXRX_PROF_RX_REORDER,
+	OL_TXRX_PROF_RX_PN,
+	OL_TXRX_PROF_RX_DECAP,
+	OL_TXRX_PROF_RX_DELIVER,
+	OL_TXRX_PROF_STAGE_MAX,
+};
+
+/*
+ * Histogram buckets of the stage cost, bucket 0 holds the costs below
+ * OL_TXRX_PROF_HIST_BASE_NS and every following bucket doubles the bound.
+ * The last bucket holds everything above.
+ */
+#define OL_TXRX_PROF_HIST_BUCKETS	12
+#define OL_TXRX_PROF_HIST_BASE_SHIFT	8
+#define OL_TXRX_PROF_HIST_BASE_NS	(1 << OL_TXRX_PROF_HIST_BASE_SHIFT)
+
+#define OL_TXRX_PROF_SAMPLE_RATE_DEFAULT	128
+#define OL_TXRX_PROF_SAMPLE_RATE_MAX		65536
+
+/**
+ * struct ol_txrx_prof_stats - profiler state and histograms of all CPUs
+ * @enabled: profiler is running
+ * @sample_rate: one packet out of @sample_rate is profiled, per CPU
+ * @samples: number of samples begun per direction
+ * @total_ns: sum of the stage costs, in nanoseconds
+ * @hist: stage cost histograms
+ */
+struct ol_txrx_prof_stats {
+	bool enabled;
+	uint32_t sample_rate;
+	uint32_t samples[OL_TXRX_PROF_DIR_MAX];
+	uint64_t total_ns[OL_TXRX_PROF_STAGE_MAX];
+	uint32_t hist[OL_TXRX_PROF_STAGE_MAX][OL_TXRX_PROF_HIST_BUCKETS];
+};
+
+#ifdef WLAN_DP_PKT_PROFILE
+extern bool ol_txrx_prof_enabled;
+
+void __ol_txrx_prof_begin(enum ol_txrx_prof_dir dir);
+void __ol_txrx_prof_mark(enum ol_txrx_prof_stage stage);
+void __ol_txrx_prof_end(enum ol_txrx_prof_dir dir);
+
+/**
+ * ol_txrx_prof_begin() - Enter the datapath, maybe begin a sample
+ * @dir: direction of the packet
+ *
+ * Return: None
+ */
+static inline void ol_txrx_prof_begin(enum ol_txrx_prof_dir dir)
+{
+	if (qdf_unlikely(READ_ONCE(ol_txrx_prof_enabled)))
+		__ol_txrx_prof_begin(dir);
+}
+
+/**
+ * ol_txrx_prof_mark() - Record a stage boundary of the current sample
+ * @stage: stage the packet just completed
+ *
+ * Return: None
+ */
+static inline void ol_txrx_prof_mark(enum ol_txrx_prof_stage stage)
+{
+	if (qdf_unlikely(READ_ONCE(ol_txrx_prof_enabled)))
+		__ol_txrx_prof_mark(stage);
+}
+
+/**
+ * ol_txrx_prof_end() - Leave the datapath and close the current sample
+ * @dir: direction of the packet
+ *
+ * Return: None
+ */
+static inline void ol_txrx_prof_end(enum ol_txrx_prof_dir dir)
+{
+	if (qdf_unlikely(READ_ONCE(ol_txrx_prof_enabled)))
+		__ol_txrx_prof_end(dir);
+}
+
+/**
+ * ol_txrx_prof_set() - Start or stop the profiler
+ * @enable: start the profiler, which also clears the histograms
+ * @sample_rate: profile one packet out of @sample_rate on each CPU
+ *
+ * Return: QDF_STATUS_SUCCESS, QDF_STATUS_E_INVAL for a bad @sample_rate
+ */
+QDF_STATUS ol_txrx_prof_set(bool enable, uint32_t sample_rate);
+
+/**
+ * ol_txrx_prof_get() - Sum the per CPU histograms
+ * @stats: filled with the profiler state and histograms
+ *
+ * Return: None
+ */
+void ol_txrx_prof_get(struct ol_txrx_prof_stats *stats);
+
+/**
+ * ol_txrx_prof_stage_str() - Name of a stage
+ * @stage: stage
+ *
+ * Return: printable name of @stage
+ */
+const char *ol_txrx_prof_stage_str(enum ol_txrx_prof_stage stage);
+
+#ifdef WLAN_DEBUGFS
+/**
+ * ol_txrx_prof_debugfs_init() - Create the pkt_profile debugfs file
+ *
+ * Return: None
+ */
+void ol_txrx_prof_debugfs_init(void);
+
+/**
+ * ol_txrx_prof_debugfs_deinit() - Stop the profiler and remove its file
+ *
+ * Return: None
+ */
+void ol_txrx_prof_debugfs_deinit(void);
+#else
+static inline void ol_txrx_prof_debugfs_init(void)
+{
+}
+
+static inline void ol_txrx_prof_debugfs_deinit(void)
+{
+}
+#endif /* WLAN_DEBUGFS */
+#else
+static inline void ol_txrx_prof_begin(enum ol_txrx_prof_dir dir)
+{
+}
+
+static inline void ol_txrx_prof_mark(enum ol_txrx_prof_stage stage)
+{
+}
+
+static inline void ol_txrx_prof_end(enum ol_txrx_prof_dir dir)
+{
+}
+
+static inline void ol_txrx_prof_debugfs_init(void)
+{
+}
+
+static inline void ol_txrx_prof_debugfs_deinit(void)
+{
+}
+#endif /* WLAN_DP_PKT_PROFILE */
+#endif /* _OL_TXRX_PROF_H_ */
@@ -56,6 +56,7 @@
 #include <pld_common.h>
 #include <htt_internal.h>
 #include <wlan_pkt_capture_ucfg_api.h>
+#include <ol_txrx_prof.h>
 
 #ifndef OL_RX_INDICATION_MAX_RECORDS
 #define OL_RX_INDICATION_MAX_RECORDS 2048
@@ -632,6 +633,7 @@ ol_rx_indication_handler(ol_txrx_pdev_handle pdev,
 							 &head_msdu,
 							 &tail_msdu,
 							 &msdu_count);
+				ol_txrx_prof_mark(OL_TXRX_PROF_RX_INDICATION);
 #ifdef HTT_RX_RESTORE
 				if (htt_pdev->rx_ring.rx_reset) {
 					ol_rx_trigger_restore(htt_pdev,
@@ -1273,6 +1275,8 @@ ol_rx_deliver(struct ol_txrx_vdev_t *vdev,
 	qdf_mem_zero(&info, sizeof(info));
 #endif
 
+	ol_txrx_prof_mark(OL_TXRX_PROF_RX_REORDER);
+
 	msdu = msdu_list;
 	/*
 	 * Check each MSDU to see whether it requires special handling,
@@ -1366,6 +1370,7 @@ DONE:
 			  ol_txrx_frm_dump_tcp_seq | ol_txrx_frm_dump_contents,
 			  0 /* don't print contents */);
 
+	ol_txrx_prof_mark(OL_TXRX_PROF_RX_DECAP);
 	ol_rx_data_process(peer, deliver_list_head);
 }
 #endif
@@ -1499,6 +1504,7 @@ ol_rx_in_order_indication_handler(ol_txrx_pdev_handle pdev,
 	status = htt_rx_amsdu_pop(htt_pdev, rx_ind_msg, &head_msdu,
 				  &tail_msdu, &msdu_count);
 	ol_rx_ind_record_event(status, OL_RX_INDICATION_POP_END);
+	ol_txrx_prof_mark(OL_TXRX_PROF_RX_INDICATION);
 
 	if (qdf_unlikely(0 == status)) {
 		ol_txrx_warn("pop failed");
@@ -1678,6 +1684,7 @@ ol_rx_in_order_deliver(struct ol_txrx_vdev_t *vdev,
 			  ol_txrx_frm_dump_tcp_seq | ol_txrx_frm_dump_contents,
 			  0 /* don't print contents */);
 
+	ol_txrx_prof_mark(OL_TXRX_PROF_RX_DECAP);
 	ol_rx_data_process(peer, msdu_list);
 }
 #endif
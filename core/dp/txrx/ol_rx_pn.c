@@ -25,6 +25,7 @@
 #include <ol_rx_pn.h>           /* our own defs */
 #include <ol_rx_fwd.h>          /* ol_rx_fwd_check */
 #include <ol_rx.h>              /* ol_rx_deliver */
+#include <ol_txrx_prof.h>
 
 /* add the MSDUs from this MPDU to the list of good frames */
 #define ADD_MPDU_TO_LIST(head, tail, mpdu, mpdu_tail) do {		\
@@ -264,7 +265,9 @@ ol_rx_pn_check(struct ol_txrx_vdev_t *vdev,
 	       struct ol_txrx_peer_t *peer, unsigned int tid,
 	       qdf_nbuf_t msdu_list)
 {
+	ol_txrx_prof_mark(OL_TXRX_PROF_RX_REORDER);
 	msdu_list = ol_rx_pn_check_base(vdev, peer, tid, msdu_list, false);
+	ol_txrx_prof_mark(OL_TXRX_PROF_RX_PN);
 	ol_rx_fwd_check(vdev, peer, tid, msdu_list);
 }
 
@@ -273,7 +276,9 @@ ol_rx_pn_check_only(struct ol_txrx_vdev_t *vdev,
 		    struct ol_txrx_peer_t *peer,
 		    unsigned int tid, qdf_nbuf_t msdu_list)
 {
+	ol_txrx_prof_mark(OL_TXRX_PROF_RX_REORDER);
 	msdu_list = ol_rx_pn_check_base(vdev, peer, tid, msdu_list, false);
+	ol_txrx_prof_mark(OL_TXRX_PROF_RX_PN);
 	ol_rx_deliver(vdev, peer, tid, msdu_list);
 }
 
@@ -40,6 +40,7 @@
 #include <ol_txrx_encap.h>      /* OL_TX_ENCAP, etc */
 #include <ol_tx.h>
 #include <cdp_txrx_ipa.h>
+#include <ol_txrx_prof.h>
 
 /**
  * ol_tx_data() - send data frame
@@ -75,7 +76,9 @@ qdf_nbuf_t ol_tx_data(void *data_vdev, qdf_nbuf_t skb)
 
 	/* Terminate the (single-element) list of tx frames */
 	qdf_nbuf_set_next(skb, NULL);
+	ol_txrx_prof_begin(OL_TXRX_PROF_TX);
 	ret = OL_TX_SEND(vdev, skb);
+	ol_txrx_prof_end(OL_TXRX_PROF_TX);
 	if (ret) {
 		ol_txrx_dbg("Failed to tx");
 		return ret;
@@ -88,28 +91,37 @@ qdf_nbuf_t ol_tx_data(void *data_vdev, qdf_nbuf_t skb)
 qdf_nbuf_t ol_tx_send_ipa_data_frame(struct cdp_vdev *vdev, qdf_nbuf_t skb)
 {
 	struct ol_txrx_pdev_t *pdev = cds_get_context(QDF_MODULE_ID_TXRX);
+	bool csum_offload;
+	qdf_nbuf_t msdu;
 	qdf_nbuf_t ret;
 
 	if (qdf_unlikely(!pdev)) {
-		qdf_net_buf_debug_acquire_skb(skb, __FILE__, __LINE__);
+		for (msdu = skb; msdu; msdu = qdf_nbuf_next(msdu))
+			qdf_net_buf_debug_acquire_skb(msdu, __FILE__, __LINE__);
 
 		ol_txrx_err("pdev is NULL");
 		return skb;
 	}
 
-	if ((ol_cfg_is_ip_tcp_udp_checksum_offload_enabled(pdev->ctrl_pdev))
-		&& (qdf_nbuf_get_protocol(skb) == htons(ETH_P_IP))
-		&& (qdf_nbuf_get_ip_summed(skb) == CHECKSUM_PARTIAL))
-		qdf_nbuf_set_ip_summed(skb, CHECKSUM_COMPLETE);
-
-	/* Terminate the (single-element) list of tx frames */
-	qdf_nbuf_set_next(skb, NULL);
+	csum_offload =
+		ol_cfg_is_ip_tcp_udp_checksum_offload_enabled(pdev->ctrl_pdev);
 
 	/*
-	 * Add SKB to internal tracking table before further processing
-	 * in WLAN driver.
+	 * The caller hands over a NULL terminated list of tx frames so that
+	 * a batch of IPA exception packets is sent with a single call.
 	 */
-	qdf_net_buf_debug_acquire_skb(skb, __FILE__, __LINE__);
+	for (msdu = skb; msdu; msdu = qdf_nbuf_next(msdu)) {
+		if (csum_offload &&
+		    (qdf_nbuf_get_protocol(msdu) == htons(ETH_P_IP)) &&
+		    (qdf_nbuf_get_ip_summed(msdu) == CHECKSUM_PARTIAL))
+			qdf_nbuf_set_ip_summed(msdu, CHECKSUM_COMPLETE);
+
+		/*
+		 * Add SKB to internal tracking table before further processing
+		 * in WLAN driver.
+		 */
+		qdf_net_buf_debug_acquire_skb(msdu, __FILE__, __LINE__);
+	}
 
 	ret = OL_TX_SEND((struct ol_txrx_vdev_t *)vdev, skb);
 	if (ret) {
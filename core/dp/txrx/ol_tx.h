@@ -33,11 +33,11 @@
 
 #ifdef IPA_OFFLOAD
 /**
- * ol_tx_send_ipa_data_frame() - send IPA data frame
+ * ol_tx_send_ipa_data_frame() - send IPA data frames
  * @vdev: vdev
- * @skb: skb
+ * @skb: NULL terminated list of skbs
  *
- * Return: skb/ NULL is for success
+ * Return: list of skbs which were not accepted, NULL is for success
  */
 qdf_nbuf_t ol_tx_send_ipa_data_frame(struct cdp_vdev *vdev, qdf_nbuf_t skb);
 #endif
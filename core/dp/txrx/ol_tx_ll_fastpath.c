@@ -47,6 +47,7 @@
 #include <htt_types.h>        /* htc_endpoint */
 #include <cdp_txrx_peer_ops.h>
 #include <cdp_txrx_handle.h>
+#include <ol_txrx_prof.h>
 
 #if defined(HIF_PCI) || defined(HIF_SNOC) || defined(HIF_AHB)
 #include <ce_api.h>
@@ -184,6 +185,8 @@ ol_tx_prepare_ll_fast(struct ol_txrx_pdev_t *pdev,
 	if (qdf_unlikely(!tx_desc))
 		return NULL;
 
+	ol_txrx_prof_mark(OL_TXRX_PROF_TX_DESC_ALLOC);
+
 	tx_desc->netbuf = msdu;
 	if (msdu_info->tso_info.is_tso) {
 		tx_desc->tso_desc = msdu_info->tso_info.curr_seg;
@@ -319,6 +322,8 @@ ol_tx_prepare_ll_fast(struct ol_txrx_pdev_t *pdev,
 	else
 		HTC_TX_DESC_FILL(htc_hdr_vaddr, *pkt_download_len, ep_id, 0);
 
+	ol_txrx_prof_mark(OL_TXRX_PROF_TX_ENCAP);
+
 	return tx_desc;
 }
 
@@ -477,6 +482,7 @@ ol_tx_ll_fast(ol_txrx_vdev_handle vdev, qdf_nbuf_t msdu_list)
 						htt_tx_status_download_fail);
 					return msdu;
 				}
+				ol_txrx_prof_mark(OL_TXRX_PROF_TX_CE_ENQUEUE);
 				if (msdu_info.tso_info.curr_seg)
 					msdu_info.tso_info.curr_seg = next_seg;
 
@@ -588,6 +594,7 @@ ol_tx_ll_fast(ol_txrx_vdev_handle vdev, qdf_nbuf_t msdu_list)
 				ol_tx_desc_free(pdev, tx_desc);
 				return msdu;
 			}
+			ol_txrx_prof_mark(OL_TXRX_PROF_TX_CE_ENQUEUE);
 			msdu = next;
 		} else {
 			TXRX_STATS_MSDU_LIST_INCR(
@@ -618,6 +618,9 @@ ol_tx_pkt_capture_tx_completion_process(
 		nbuf_len = qdf_nbuf_len(tx_desc->netbuf) - extra_frag_len;
 	}
 
+	if (!ucfg_pkt_capture_filter_ether_pkt(tx_desc->netbuf, tid))
+		return;
+
 	qdf_spin_lock_bh(&pdev->peer_ref_mutex);
 	peer = TAILQ_FIRST(&tx_desc->vdev->peer_list);
 	qdf_spin_unlock_bh(&pdev->peer_ref_mutex);
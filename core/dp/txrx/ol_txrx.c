@@ -81,6 +81,7 @@
 #include <ol_txrx_ipa.h>
 #include "wlan_roam_debug.h"
 #include "cfg_ucfg_api.h"
+#include <ol_txrx_prof.h>
 
 
 #define DPT_DEBUGFS_PERMS	(QDF_FILE_USR_READ |	\
@@ -182,11 +183,18 @@ ol_txrx_find_peer_by_addr_and_vdev(struct cdp_pdev *ppdev,
 	struct ol_txrx_vdev_t *vdev = (struct ol_txrx_vdev_t *)pvdev;
 	struct ol_txrx_peer_t *peer;
 
-	peer = ol_txrx_peer_vdev_find_hash(pdev, vdev, peer_addr, 0, 1);
-	if (!peer)
-		return NULL;
-	*peer_id = peer->local_id;
-	ol_txrx_peer_release_ref(peer, PEER_DEBUG_ID_OL_INTERNAL);
+	/*
+	 * As before, no reference is held once this returns: the caller
+	 * gets the same unprotected handle the locked lookup used to hand
+	 * out after dropping its reference. Only the lookup itself is
+	 * covered by the read section.
+	 */
+	ol_txrx_rcu_read_lock();
+	peer = ol_txrx_peer_find_hash_find_rcu(pdev, vdev, peer_addr, 0, 1);
+	if (peer)
+		*peer_id = peer->local_id;
+	ol_txrx_rcu_read_unlock();
+
 	return peer;
 }
 
@@ -251,12 +259,13 @@ void *ol_txrx_find_peer_by_addr(struct cdp_pdev *ppdev,
 	struct ol_txrx_peer_t *peer;
 	struct ol_txrx_pdev_t *pdev = (struct ol_txrx_pdev_t *)ppdev;
 
-	peer = ol_txrx_peer_find_hash_find_get_ref(pdev, peer_addr, 0, 1,
-						   PEER_DEBUG_ID_OL_INTERNAL);
-	if (!peer)
-		return NULL;
-	*peer_id = peer->local_id;
-	ol_txrx_peer_release_ref(peer, PEER_DEBUG_ID_OL_INTERNAL);
+	/* see ol_txrx_find_peer_by_addr_and_vdev */
+	ol_txrx_rcu_read_lock();
+	peer = ol_txrx_peer_find_hash_find_rcu(pdev, NULL, peer_addr, 0, 1);
+	if (peer)
+		*peer_id = peer->local_id;
+	ol_txrx_rcu_read_unlock();
+
 	return peer;
 }
 
@@ -785,6 +794,7 @@ ol_txrx_pdev_attach(ol_txrx_soc_handle soc,
 		pdev->chan_noise_floor = NORMALIZED_TO_NOISE_FLOOR;
 
 	ol_txrx_debugfs_init(pdev);
+	ol_txrx_prof_debugfs_init();
 
 	return (struct cdp_pdev *)pdev;
 
@@ -1606,6 +1616,7 @@ static void ol_txrx_pdev_detach(struct cdp_pdev *ppdev, int force)
 	ol_txrx_pdev_txq_log_destroy(pdev);
 	ol_txrx_pdev_grp_stat_destroy(pdev);
 
+	ol_txrx_prof_debugfs_deinit();
 	ol_txrx_debugfs_exit(pdev);
 
 	qdf_mem_free(pdev);
@@ -2907,6 +2918,20 @@ static void ol_txrx_peer_drop_pending_frames(struct ol_txrx_peer_t *peer)
 		cds_drop_rxpkt_by_staid(sched_ctx, peer->local_id);
 }
 
+/**
+ * ol_txrx_peer_free_rcu() - free the peer once lockless readers are done
+ * @rcu: rcu head embedded in the peer
+ *
+ * Return: None
+ */
+static void ol_txrx_peer_free_rcu(ol_txrx_rcu_head_t *rcu)
+{
+	struct ol_txrx_peer_t *peer;
+
+	peer = qdf_container_of(rcu, struct ol_txrx_peer_t, rcu);
+	qdf_mem_free(peer);
+}
+
 /**
  * ol_txrx_peer_release_ref() - release peer reference
  * @peer: peer handle
@@ -3107,7 +3132,11 @@ int ol_txrx_peer_release_ref(ol_txrx_peer_handle peer,
 		    pdev->self_peer == peer)
 			pdev->self_peer = NULL;
 
-		qdf_mem_free(peer);
+		/*
+		 * RCU readers of the hash table and the peer id map may still
+		 * hold the pointer, defer the free past their read sections.
+		 */
+		ol_txrx_call_rcu(&peer->rcu, ol_txrx_peer_free_rcu);
 	} else {
 		access_list = qdf_atomic_read(&peer->access_list[debug_id]);
 		qdf_spin_unlock_bh(&pdev->peer_ref_mutex);
@@ -4613,6 +4642,7 @@ static void ol_rx_data_handler(struct ol_txrx_pdev_t *pdev,
 		next_buf = qdf_nbuf_queue_next(buf);
 		qdf_nbuf_set_next(buf, NULL);   /* Add NULL terminator */
 		ret = data_rx(osif_dev, buf);
+		ol_txrx_prof_mark(OL_TXRX_PROF_RX_DELIVER);
 		if (ret != QDF_STATUS_SUCCESS) {
 			ol_txrx_err("Frame Rx to HDD failed");
 			if (pdev)
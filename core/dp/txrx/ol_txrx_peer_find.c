@@ -117,16 +117,14 @@ static int ol_txrx_peer_find_hash_attach(struct ol_txrx_pdev_t *pdev)
 
 	pdev->peer_hash.mask = hash_elems - 1;
 	pdev->peer_hash.idx_bits = log2;
-	/* allocate an array of TAILQ peer object lists */
+	/* allocate an array of RCU peer object lists */
 	pdev->peer_hash.bins =
-		qdf_mem_malloc(hash_elems *
-			       sizeof(TAILQ_HEAD(anonymous_tail_q,
-						 ol_txrx_peer_t)));
+		qdf_mem_malloc(hash_elems * sizeof(pdev->peer_hash.bins[0]));
 	if (!pdev->peer_hash.bins)
 		return 1;       /* failure */
 
 	for (i = 0; i < hash_elems; i++)
-		TAILQ_INIT(&pdev->peer_hash.bins[i]);
+		ol_txrx_rcu_list_init(&pdev->peer_hash.bins[i]);
 
 	return 0;               /* success */
 }
@@ -165,15 +163,30 @@ ol_txrx_peer_find_hash_add(struct ol_txrx_pdev_t *pdev,
 	 * the same MAC address are stored, the one added first will be
 	 * found first.
 	 */
-	TAILQ_INSERT_TAIL(&pdev->peer_hash.bins[index], peer, hash_list_elem);
+	ol_txrx_rcu_list_add_tail(&peer->hash_list_elem,
+				  &pdev->peer_hash.bins[index]);
 	qdf_spin_unlock_bh(&pdev->peer_ref_mutex);
 }
 
-struct ol_txrx_peer_t *ol_txrx_peer_vdev_find_hash(struct ol_txrx_pdev_t *pdev,
-						   struct ol_txrx_vdev_t *vdev,
-						   uint8_t *peer_mac_addr,
-						   int mac_addr_is_aligned,
-						   uint8_t check_valid)
+/**
+ * ol_txrx_peer_find_hash_lookup() - walk a hash bin for a peer
+ * @pdev: pdev handle
+ * @vdev: vdev the peer has to belong to, NULL to match any vdev
+ * @peer_mac_addr: peer mac address
+ * @mac_addr_is_aligned: is mac address aligned
+ * @check_valid: only match peers which have not been detached yet
+ *
+ * The caller must either hold peer_ref_mutex or be inside an RCU read-side
+ * critical section.
+ *
+ * Return: peer, or NULL if not found
+ */
+static struct ol_txrx_peer_t *
+ol_txrx_peer_find_hash_lookup(struct ol_txrx_pdev_t *pdev,
+			      struct ol_txrx_vdev_t *vdev,
+			      uint8_t *peer_mac_addr,
+			      int mac_addr_is_aligned,
+			      uint8_t check_valid)
 {
 	union ol_txrx_align_mac_addr_t local_mac_addr_aligned, *mac_addr;
 	unsigned int index;
@@ -187,18 +200,14 @@ struct ol_txrx_peer_t *ol_txrx_peer_vdev_find_hash(struct ol_txrx_pdev_t *pdev,
 		mac_addr = &local_mac_addr_aligned;
 	}
 	index = ol_txrx_peer_find_hash_index(pdev, mac_addr);
-	qdf_spin_lock_bh(&pdev->peer_ref_mutex);
-	TAILQ_FOREACH(peer, &pdev->peer_hash.bins[index], hash_list_elem) {
+	ol_txrx_rcu_list_for_each_entry(peer, &pdev->peer_hash.bins[index],
+					hash_list_elem) {
 		if (ol_txrx_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr) ==
 		    0 && (check_valid == 0 || peer->valid)
-		    && peer->vdev == vdev) {
-			/* found it */
-			ol_txrx_peer_get_ref(peer, PEER_DEBUG_ID_OL_INTERNAL);
-			qdf_spin_unlock_bh(&pdev->peer_ref_mutex);
+		    && (!vdev || peer->vdev == vdev))
 			return peer;
-		}
 	}
-	qdf_spin_unlock_bh(&pdev->peer_ref_mutex);
+
 	return NULL;            /* failure */
 }
 
@@ -210,30 +219,29 @@ struct ol_txrx_peer_t *
 				u8 check_valid,
 				enum peer_debug_id_type dbg_id)
 {
-	union ol_txrx_align_mac_addr_t local_mac_addr_aligned, *mac_addr;
-	unsigned int index;
 	struct ol_txrx_peer_t *peer;
 
-	if (mac_addr_is_aligned) {
-		mac_addr = (union ol_txrx_align_mac_addr_t *)peer_mac_addr;
-	} else {
-		qdf_mem_copy(&local_mac_addr_aligned.raw[0],
-			     peer_mac_addr, QDF_MAC_ADDR_SIZE);
-		mac_addr = &local_mac_addr_aligned;
-	}
-	index = ol_txrx_peer_find_hash_index(pdev, mac_addr);
 	qdf_spin_lock_bh(&pdev->peer_ref_mutex);
-	TAILQ_FOREACH(peer, &pdev->peer_hash.bins[index], hash_list_elem) {
-		if (ol_txrx_peer_find_mac_addr_cmp(mac_addr, &peer->mac_addr) ==
-		    0 && (check_valid == 0 || peer->valid)) {
-			/* found it */
-			ol_txrx_peer_get_ref(peer, dbg_id);
-			qdf_spin_unlock_bh(&pdev->peer_ref_mutex);
-			return peer;
-		}
-	}
+	peer = ol_txrx_peer_find_hash_lookup(pdev, NULL, peer_mac_addr,
+					     mac_addr_is_aligned, check_valid);
+	if (peer)
+		ol_txrx_peer_get_ref(peer, dbg_id);
 	qdf_spin_unlock_bh(&pdev->peer_ref_mutex);
-	return NULL;            /* failure */
+
+	return peer;
+}
+
+struct ol_txrx_peer_t *
+ol_txrx_peer_find_hash_find_rcu(struct ol_txrx_pdev_t *pdev,
+				struct ol_txrx_vdev_t *vdev,
+				uint8_t *peer_mac_addr,
+				int mac_addr_is_aligned,
+				u8 check_valid)
+{
+	ol_txrx_rcu_assert_read_held();
+
+	return ol_txrx_peer_find_hash_lookup(pdev, vdev, peer_mac_addr,
+					     mac_addr_is_aligned, check_valid);
 }
 
 void
@@ -257,8 +265,13 @@ ol_txrx_peer_find_hash_remove(struct ol_txrx_pdev_t *pdev,
 	 * peer ref count is decremented to zero, but just before the peer
 	 * object reference is removed from the hash table.
 	 */
+	/*
+	 * Lockless readers may still be walking through this peer; the
+	 * peer memory itself is only released after an RCU grace period,
+	 * see ol_txrx_peer_release_ref.
+	 */
 	/* qdf_spin_lock_bh(&pdev->peer_ref_mutex); */
-	TAILQ_REMOVE(&pdev->peer_hash.bins[index], peer, hash_list_elem);
+	ol_txrx_rcu_list_del(&peer->hash_list_elem);
 	/* qdf_spin_unlock_bh(&pdev->peer_ref_mutex); */
 }
 
@@ -271,15 +284,16 @@ void ol_txrx_peer_find_hash_erase(struct ol_txrx_pdev_t *pdev)
 	 */
 
 	for (i = 0; i <= pdev->peer_hash.mask; i++) {
-		if (!TAILQ_EMPTY(&pdev->peer_hash.bins[i])) {
+		if (!ol_txrx_rcu_list_empty(&pdev->peer_hash.bins[i])) {
 			struct ol_txrx_peer_t *peer, *peer_next;
 
 			/*
-			 * TAILQ_FOREACH_SAFE must be used here to avoid any
-			 * memory access violation after peer is freed
+			 * the _safe iterator must be used here to avoid
+			 * any memory access violation after peer is freed
 			 */
-			TAILQ_FOREACH_SAFE(peer, &pdev->peer_hash.bins[i],
-					   hash_list_elem, peer_next) {
+			ol_txrx_rcu_list_for_each_entry_safe(peer, peer_next,
+						&pdev->peer_hash.bins[i],
+						hash_list_elem) {
 				/*
 				 * Don't remove the peer from the hash table -
 				 * that would modify the list we are currently
@@ -467,6 +481,8 @@ int ol_txrx_peer_find_attach(struct ol_txrx_pdev_t *pdev)
 
 void ol_txrx_peer_find_detach(struct ol_txrx_pdev_t *pdev)
 {
+	/* wait for the deferred frees of the last peers */
+	ol_txrx_rcu_barrier();
 	ol_txrx_peer_find_map_detach(pdev);
 	ol_txrx_peer_find_hash_detach(pdev);
 }
@@ -825,17 +841,20 @@ void ol_txrx_peer_find_display(ol_txrx_pdev_handle pdev, int indent)
 	QDF_TRACE(QDF_MODULE_ID_TXRX, QDF_TRACE_LEVEL_INFO_LOW,
 		  "%*speer hash table:\n", indent, " ");
 	for (i = 0; i <= pdev->peer_hash.mask; i++) {
-		if (!TAILQ_EMPTY(&pdev->peer_hash.bins[i])) {
+		if (!ol_txrx_rcu_list_empty(&pdev->peer_hash.bins[i])) {
 			struct ol_txrx_peer_t *peer;
 
-			TAILQ_FOREACH(peer, &pdev->peer_hash.bins[i],
-				      hash_list_elem) {
+			ol_txrx_rcu_read_lock();
+			ol_txrx_rcu_list_for_each_entry(peer,
+						&pdev->peer_hash.bins[i],
+						hash_list_elem) {
 				QDF_TRACE(QDF_MODULE_ID_TXRX,
 					  QDF_TRACE_LEVEL_INFO_LOW,
 					  "%*shash idx %d -> %pK ("QDF_MAC_ADDR_STR")\n",
 					indent + 4, " ", i, peer,
 					QDF_MAC_ADDR_ARRAY(peer->mac_addr.raw));
 			}
+			ol_txrx_rcu_read_unlock();
 		}
 	}
 }
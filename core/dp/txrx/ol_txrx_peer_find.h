@@ -77,6 +77,13 @@ struct ol_txrx_peer_t *ol_txrx_peer_find_by_id(struct ol_txrx_pdev_t *pdev,
 	 * will hold NULL rather than a valid peer pointer.
 	 */
 	/* TXRX_ASSERT2(peer); */
+	/*
+	 * No reference is taken here. The deferred RCU free of the peer
+	 * only covers callers inside ol_txrx_rcu_read_lock(); running in
+	 * softirq context alone does not hold off the grace period.
+	 * Callers outside such a section rely on the peer unmap sequence
+	 * with the target, as before.
+	 */
 	/*
 	 * Only return the peer object if it is valid,
 	 * i.e. it has not already been detached.
@@ -102,12 +109,28 @@ struct ol_txrx_peer_t *
 				u8 check_valid,
 				enum peer_debug_id_type dbg_id);
 
-struct
-ol_txrx_peer_t *ol_txrx_peer_vdev_find_hash(struct ol_txrx_pdev_t *pdev,
-					    struct ol_txrx_vdev_t *vdev,
-					    uint8_t *peer_mac_addr,
-					    int mac_addr_is_aligned,
-					    uint8_t check_valid);
+/**
+ * ol_txrx_peer_find_hash_find_rcu() - find a peer without taking a reference
+ * @pdev: pdev handle
+ * @vdev: vdev the peer has to belong to, NULL to match any vdev
+ * @peer_mac_addr: peer mac address
+ * @mac_addr_is_aligned: is mac address aligned
+ * @check_valid: only match peers which have not been detached yet
+ *
+ * Lockless lookup for short read-side sections on the datapath. The caller
+ * must be inside ol_txrx_rcu_read_lock() for as long as it dereferences the
+ * returned peer; the peer memory stays valid until the read section ends,
+ * but the peer may be detached concurrently, so anything which outlives the
+ * read section needs ol_txrx_peer_find_hash_find_get_ref instead.
+ *
+ * Return: peer, or NULL if not found
+ */
+struct ol_txrx_peer_t *
+ol_txrx_peer_find_hash_find_rcu(struct ol_txrx_pdev_t *pdev,
+				struct ol_txrx_vdev_t *vdev,
+				uint8_t *peer_mac_addr,
+				int mac_addr_is_aligned,
+				u8 check_valid);
 
 void
 ol_txrx_peer_find_hash_remove(struct ol_txrx_pdev_t *pdev,
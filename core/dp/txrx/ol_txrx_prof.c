@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <linux/percpu.h>
+#include <linux/preempt.h>
+#include <qdf_mem.h>
+#include <qdf_time.h>
+#include <qdf_debugfs.h>
+#include <ol_txrx_prof.h>
+#include "ol_txrx_internal.h"
+
+#define OL_TXRX_PROF_DEBUGFS_PERMS	(QDF_FILE_USR_READ |	\
+					 QDF_FILE_USR_WRITE |	\
+					 QDF_FILE_GRP_READ |	\
+					 QDF_FILE_OTH_READ)
+
+/**
+ * struct ol_txrx_prof_sample - sample being followed on a CPU
+ * @active: a packet is being profiled
+ * @stage: last stage boundary recorded, -1 if none
+ * @last_ns: time of the sample begin or of the last recorded boundary
+ * @count: packets seen since the last sample
+ */
+struct ol_txrx_prof_sample {
+	bool active;
+	int8_t stage;
+	uint64_t last_ns;
+	uint32_t count;
+};
+
+/**
+ * struct ol_txrx_prof_cpu - per CPU profiler data, only written by its CPU
+ * @gen: profiler run the data belongs to
+ * @sample: sample per direction
+ * @samples: number of samples begun per direction
+ * @total_ns: sum of the stage costs, in nanoseconds
+ * @hist: stage cost histograms
+ */
+struct ol_txrx_prof_cpu {
+	uint32_t gen;
+	struct ol_txrx_prof_sample sample[OL_TXRX_PROF_DIR_MAX];
+	uint32_t samples[OL_TXRX_PROF_DIR_MAX];
+	uint64_t total_ns[OL_TXRX_PROF_STAGE_MAX];
+	uint32_t hist[OL_TXRX_PROF_STAGE_MAX][OL_TXRX_PROF_HIST_BUCKETS];
+};
+
+static DEFINE_PER_CPU(struct ol_txrx_prof_cpu, ol_txrx_prof_cpu);
+
+bool ol_txrx_prof_enabled;
+static uint32_t ol_txrx_prof_sample_rate = OL_TXRX_PROF_SAMPLE_RATE_DEFAULT;
+
+/*
+ * Bumped on every start. A CPU clears its own data when it sees a new run,
+ * so the hooks never race with a clear done from another CPU.
+ */
+static uint32_t ol_txrx_prof_gen;
+
+/**
+ * ol_txrx_prof_this_cpu() - Get the profiler data of the current CPU
+ *
+ * The hooks only run in softirq context or with bottom halves disabled,
+ * where the CPU can not change and no other hook can interrupt them on
+ * this CPU. Elsewhere, e.g. in the RX thread, the hook is skipped.
+ *
+ * Return: profiler data of the current CPU, NULL outside of softirq
+ */
+static struct ol_txrx_prof_cpu *ol_txrx_prof_this_cpu(void)
+{
+	struct ol_txrx_prof_cpu *prof;
+	uint32_t gen;
+
+	if (!in_softirq())
+		return NULL;
+
+	prof = this_cpu_ptr(&ol_txrx_prof_cpu);
+	gen = READ_ONCE(ol_txrx_prof_gen);
+	if (qdf_unlikely(prof->gen != gen)) {
+		qdf_mem_zero(prof, sizeof(*prof));
+		WRITE_ONCE(prof->gen, gen);
+	}
+
+	return prof;
+}
+
+/**
+ * ol_txrx_prof_stage_dir() - Direction a stage belongs to
+ * @stage: stage
+ *
+ * Return: direction of @stage
+ */
+static inline enum ol_txrx_prof_dir
+ol_txrx_prof_stage_dir(enum ol_txrx_prof_stage stage)
+{
+	return stage < OL_TXRX_PROF_RX_INDICATION ?
+		OL_TXRX_PROF_TX : OL_TXRX_PROF_RX;
+}
+
+/**
+ * ol_txrx_prof_bucket() - Histogram bucket of a stage cost
+ * @delta_ns: stage cost in nanoseconds
+ *
+ * Return: bucket index
+ */
+static inline uint32_t ol_txrx_prof_bucket(uint64_t delta_ns)
+{
+	uint32_t bucket;
+
+	bucket = fls64(delta_ns >> OL_TXRX_PROF_HIST_BASE_SHIFT);
+
+	return QDF_MIN(bucket, (uint32_t)OL_TXRX_PROF_HIST_BUCKETS - 1);
+}
+
+void __ol_txrx_prof_begin(enum ol_txrx_prof_dir dir)
+{
+	struct ol_txrx_prof_cpu *prof = ol_txrx_prof_this_cpu();
+	struct ol_txrx_prof_sample *sample;
+
+	if (!prof)
+		return;
+
+	sample = &prof->sample[dir];
+	if (++sample->count < READ_ONCE(ol_txrx_prof_sample_rate)) {
+		sample->active = false;
+		return;
+	}
+
+	sample->count = 0;
+	sample->active = true;
+	sample->stage = -1;
+	sample->last_ns = qdf_get_monotonic_boottime_ns();
+	prof->samples[dir]++;
+}
+
+void __ol_txrx_prof_mark(enum ol_txrx_prof_stage stage)
+{
+	struct ol_txrx_prof_cpu *prof = ol_txrx_prof_this_cpu();
+	struct ol_txrx_prof_sample *sample;
+	uint64_t now, delta;
+
+	if (!prof)
+		return;
+
+	sample = &prof->sample[ol_txrx_prof_stage_dir(stage)];
+	if (!sample->active || (int8_t)stage <= sample->stage)
+		return;
+
+	now = qdf_get_monotonic_boottime_ns();
+	delta = now - sample->last_ns;
+	sample->last_ns = now;
+	sample->stage = stage;
+
+	prof->total_ns[stage] += delta;
+	prof->hist[stage][ol_txrx_prof_bucket(delta)]++;
+}
+
+void __ol_txrx_prof_end(enum ol_txrx_prof_dir dir)
+{
+	struct ol_txrx_prof_cpu *prof = ol_txrx_prof_this_cpu();
+
+	if (prof)
+		prof->sample[dir].active = false;
+}
+
+QDF_STATUS ol_txrx_prof_set(bool enable, uint32_t sample_rate)
+{
+	if (!enable) {
+		WRITE_ONCE(ol_txrx_prof_enabled, false);
+		ol_txrx_info("Packet profiler stopped");
+		return QDF_STATUS_SUCCESS;
+	}
+
+	if (!sample_rate || sample_rate > OL_TXRX_PROF_SAMPLE_RATE_MAX) {
+		ol_txrx_err("Invalid sample rate %u, max %u", sample_rate,
+			    OL_TXRX_PROF_SAMPLE_RATE_MAX);
+		return QDF_STATUS_E_INVAL;
+	}
+
+	/* each CPU drops the data and the sample of the previous run */
+	WRITE_ONCE(ol_txrx_prof_sample_rate, sample_rate);
+	WRITE_ONCE(ol_txrx_prof_gen, ol_txrx_prof_gen + 1);
+	smp_wmb();
+	WRITE_ONCE(ol_txrx_prof_enabled, true);
+	ol_txrx_info("Packet profiler started, sample rate 1/%u", sample_rate);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+void ol_txrx_prof_get(struct ol_txrx_prof_stats *stats)
+{
+	struct ol_txrx_prof_cpu *prof;
+	uint32_t gen = READ_ONCE(ol_txrx_prof_gen);
+	int cpu, stage, bucket, dir;
+
+	qdf_mem_zero(stats, sizeof(*stats));
+	stats->enabled = READ_ONCE(ol_txrx_prof_enabled);
+	stats->sample_rate = READ_ONCE(ol_txrx_prof_sample_rate);
+
+	for_each_possible_cpu(cpu) {
+		prof = per_cpu_ptr(&ol_txrx_prof_cpu, cpu);
+
+		/* no packet of the current run seen on this CPU yet */
+		if (READ_ONCE(prof->gen) != gen)
+			continue;
+
+		for (dir = 0; dir < OL_TXRX_PROF_DIR_MAX; dir++)
+			stats->samples[dir] += READ_ONCE(prof->samples[dir]);
+
+		for (stage = 0; stage < OL_TXRX_PROF_STAGE_MAX; stage++) {
+			stats->total_ns[stage] +=
+				READ_ONCE(prof->total_ns[stage]);
+			for (bucket = 0; bucket < OL_TXRX_PROF_HIST_BUCKETS;
+			     bucket++)
+				stats->hist[stage][bucket] +=
+					READ_ONCE(prof->hist[stage][bucket]);
+		}
+	}
+}
+
+const char *ol_txrx_prof_stage_str(enum ol_txrx_prof_stage stage)
+{
+	switch (stage) {
+	case OL_TXRX_PROF_TX_DESC_ALLOC:
+		return "tx_desc_alloc";
+	case OL_TXRX_PROF_TX_ENCAP:
+		return "tx_encap";
+	case OL_TXRX_PROF_TX_CE_ENQUEUE:
+		return "tx_ce_enqueue";
+	case OL_TXRX_PROF_RX_INDICATION:
+		return "rx_indication";
+	case OL_TXRX_PROF_RX_REORDER:
+		return "rx_reorder";
+	case OL_TXRX_PROF_RX_PN:
+		return "rx_pn";
+	case OL_TXRX_PROF_RX_DECAP:
+		return "rx_decap";
+	case OL_TXRX_PROF_RX_DELIVER:
+		return "rx_deliver";
+	default:
+		return "unknown";
+	}
+}
+
+#ifdef WLAN_DEBUGFS
+static qdf_dentry_t ol_txrx_prof_debugfs_file;
+
+static QDF_STATUS ol_txrx_prof_debugfs_read(qdf_debugfs_file_t file,
+					    void *arg)
+{
+	struct ol_txrx_prof_stats *stats;
+	uint32_t bucket, count;
+	enum ol_txrx_prof_stage stage;
+
+	stats = qdf_mem_malloc(sizeof(*stats));
+	if (!stats)
+		return QDF_STATUS_E_NOMEM;
+
+	ol_txrx_prof_get(stats);
+	qdf_debugfs_printf(file, "enabled: %u sample rate: 1/%u\n"
+				 "tx samples: %u rx samples: %u\n"
+				 "%-14s %9s",
+			   stats->enabled, stats->sample_rate,
+			   stats->samples[OL_TXRX_PROF_TX],
+			   stats->samples[OL_TXRX_PROF_RX],
+			   "stage", "avg(ns)");
+
+	for (bucket = 0; bucket < OL_TXRX_PROF_HIST_BUCKETS - 1; bucket++)
+		qdf_debugfs_printf(file, " <%-7u",
+				   OL_TXRX_PROF_HIST_BASE_NS << bucket);
+	qdf_debugfs_printf(file, " >=%-6u\n",
+			   OL_TXRX_PROF_HIST_BASE_NS <<
+			   (OL_TXRX_PROF_HIST_BUCKETS - 2));
+
+	for (stage = 0; stage < OL_TXRX_PROF_STAGE_MAX; stage++) {
+		count = 0;
+		for (bucket = 0; bucket < OL_TXRX_PROF_HIST_BUCKETS; bucket++)
+			count += stats->hist[stage][bucket];
+
+		qdf_debugfs_printf(file, "%-14s %9llu",
+				   ol_txrx_prof_stage_str(stage),
+				   count ? div_u64(stats->total_ns[stage],
+						   count) : 0);
+		for (bucket = 0; bucket < OL_TXRX_PROF_HIST_BUCKETS; bucket++)
+			qdf_debugfs_printf(file, " %-8u",
+					   stats->hist[stage][bucket]);
+		qdf_debugfs_printf(file, "\n");
+	}
+
+	qdf_mem_free(stats);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static QDF_STATUS ol_txrx_prof_debugfs_write(void *priv, const char *buf,
+					     qdf_size_t len)
+{
+	uint32_t enable, sample_rate = OL_TXRX_PROF_SAMPLE_RATE_DEFAULT;
+
+	if (sscanf(buf, "%u %u", &enable, &sample_rate) < 1) {
+		ol_txrx_err("Usage: echo <0|1> [sample rate] > pkt_profile");
+		return QDF_STATUS_E_INVAL;
+	}
+
+	return ol_txrx_prof_set(!!enable, sample_rate);
+}
+
+static struct qdf_debugfs_fops ol_txrx_prof_debugfs_fops = {
+	.show = ol_txrx_prof_debugfs_read,
+	.write = ol_txrx_prof_debugfs_write,
+};
+
+void ol_txrx_prof_debugfs_init(void)
+{
+	ol_txrx_prof_debugfs_file =
+		qdf_debugfs_create_file("pkt_profile",
+					OL_TXRX_PROF_DEBUGFS_PERMS, NULL,
+					&ol_txrx_prof_debugfs_fops);
+	if (!ol_txrx_prof_debugfs_file)
+		ol_txrx_err("Failed to create the packet profile file");
+}
+
+void ol_txrx_prof_debugfs_deinit(void)
+{
+	ol_txrx_prof_set(false, 0);
+	qdf_debugfs_remove_file(ol_txrx_prof_debugfs_file);
+	ol_txrx_prof_debugfs_file = NULL;
+}
+#endif /* WLAN_DEBUGFS */
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: ol_txrx_rcu.h
+ *
+ * OS abstraction of the RCU primitives used by the txrx peer tables.
+ * QDF does not provide RCU wrappers, so the txrx sources go through
+ * these instead of calling the kernel RCU API directly.
+ */
+
+#ifndef _OL_TXRX_RCU_H_
+#define _OL_TXRX_RCU_H_
+
+#include <linux/rculist.h>
+
+/* node and head of a list walked by RCU readers */
+typedef struct list_head ol_txrx_rcu_list_t;
+
+/* deferred free handle embedded in an RCU protected object */
+typedef struct rcu_head ol_txrx_rcu_head_t;
+
+typedef void (*ol_txrx_rcu_cb_t)(ol_txrx_rcu_head_t *head);
+
+/**
+ * ol_txrx_rcu_read_lock() - Enter an RCU read-side critical section
+ *
+ * Return: None
+ */
+static inline void ol_txrx_rcu_read_lock(void)
+{
+	rcu_read_lock();
+}
+
+/**
+ * ol_txrx_rcu_read_unlock() - Leave an RCU read-side critical section
+ *
+ * Return: None
+ */
+static inline void ol_txrx_rcu_read_unlock(void)
+{
+	rcu_read_unlock();
+}
+
+/**
+ * ol_txrx_rcu_assert_read_held() - Warn when not in a read-side section
+ *
+ * Only checked on lockdep enabled builds.
+ *
+ * Return: None
+ */
+static inline void ol_txrx_rcu_assert_read_held(void)
+{
+	RCU_LOCKDEP_WARN(!rcu_read_lock_held(),
+			 "txrx RCU lookup outside of a read section");
+}
+
+/**
+ * ol_txrx_call_rcu() - Run @func once all current readers are done
+ * @head: deferred free handle embedded in the object
+ * @func: callback, typically freeing the object containing @head
+ *
+ * Return: None
+ */
+static inline void ol_txrx_call_rcu(ol_txrx_rcu_head_t *head,
+				    ol_txrx_rcu_cb_t func)
+{
+	call_rcu(head, func);
+}
+
+/**
+ * ol_txrx_rcu_barrier() - Wait for all pending ol_txrx_call_rcu callbacks
+ *
+ * Return: None
+ */
+static inline void ol_txrx_rcu_barrier(void)
+{
+	rcu_barrier();
+}
+
+/**
+ * ol_txrx_rcu_list_init() - Initialize an empty RCU list
+ * @list: list head
+ *
+ * Return: None
+ */
+static inline void ol_txrx_rcu_list_init(ol_txrx_rcu_list_t *list)
+{
+	INIT_LIST_HEAD(list);
+}
+
+/**
+ * ol_txrx_rcu_list_empty() - Check whether an RCU list is empty
+ * @list: list head
+ *
+ * Return: true if @list has no node
+ */
+static inline bool ol_txrx_rcu_list_empty(ol_txrx_rcu_list_t *list)
+{
+	return list_empty(list);
+}
+
+/**
+ * ol_txrx_rcu_list_add_tail() - Publish a node at the tail of an RCU list
+ * @node: node to add
+ * @list: list head
+ *
+ * Writers must be serialized by the caller.
+ *
+ * Return: None
+ */
+static inline void ol_txrx_rcu_list_add_tail(ol_txrx_rcu_list_t *node,
+					     ol_txrx_rcu_list_t *list)
+{
+	list_add_tail_rcu(node, list);
+}
+
+/**
+ * ol_txrx_rcu_list_del() - Unlink a node from an RCU list
+ * @node: node to remove
+ *
+ * Readers may still be on @node; the object containing it must only be
+ * freed through ol_txrx_call_rcu. Writers must be serialized by the caller.
+ *
+ * Return: None
+ */
+static inline void ol_txrx_rcu_list_del(ol_txrx_rcu_list_t *node)
+{
+	list_del_rcu(node);
+}
+
+/* walk an RCU list, inside a read section or with the writer lock held */
+#define ol_txrx_rcu_list_for_each_entry(pos, list, member) \
+	list_for_each_entry_rcu(pos, list, member)
+
+/* walk an RCU list while freeing its entries, no reader may be left */
+#define ol_txrx_rcu_list_for_each_entry_safe(pos, n, list, member) \
+	list_for_each_entry_safe(pos, n, list, member)
+
+#endif /* _OL_TXRX_RCU_H_ */
@@ -42,6 +42,7 @@
 #include "cdp_txrx_flow_ctrl_v2.h"
 #include "cdp_txrx_peer_ops.h"
 #include <qdf_trace.h>
+#include "ol_txrx_rcu.h"        /* ol_txrx_rcu_list_t */
 
 /*
  * The target may allocate multiple IDs for a peer.
@@ -708,7 +709,11 @@ struct ol_txrx_pdev_t {
 		unsigned int mask;
 		unsigned int idx_bits;
 
-		TAILQ_HEAD(, ol_txrx_peer_t) * bins;
+		/*
+		 * Bins are RCU lists: writers hold peer_ref_mutex, readers
+		 * may walk them inside an RCU read-side critical section.
+		 */
+		ol_txrx_rcu_list_t *bins;
 	} peer_hash;
 
 	/* rx specific processing */
@@ -1315,7 +1320,9 @@ struct ol_txrx_peer_t {
 	/* node in the vdev's list of peers */
 	TAILQ_ENTRY(ol_txrx_peer_t) peer_list_elem;
 	/* node in the hash table bin's list of peers */
-	TAILQ_ENTRY(ol_txrx_peer_t) hash_list_elem;
+	ol_txrx_rcu_list_t hash_list_elem;
+	/* deferred free, once lockless readers are done with the peer */
+	ol_txrx_rcu_head_t rcu;
 
 	/*
 	 * per TID info -
@@ -1335,6 +1335,64 @@ struct dhcp_server {
 			CFG_VALUE_OR_DEFAULT, \
 			"Disable wow feature")
 
+/*
+ * <ini>
+ * sta_stats_cache_age - Maximum age of cached station statistics
+ * @Min: 0
+ * @Max: 10000
+ * @Default: 0
+ *
+ * This ini is used to set the age in ms up to which station statistics
+ * fetched from firmware are returned for get_station requests without a
+ * new firmware request. Statistics past half of this age are refreshed in
+ * the background. 0 disables the cache and every request waits for
+ * firmware.
+ *
+ * Related: None
+ *
+ * Supported Feature: STA, SAP
+ *
+ * Usage: External
+ *
+ * </ini>
+ */
+#define CFG_STA_STATS_CACHE_AGE CFG_INI_UINT( \
+			"sta_stats_cache_age", \
+			0, \
+			10000, \
+			0, \
+			CFG_VALUE_OR_DEFAULT, \
+			"Maximum age of cached station stats in ms")
+
+/*
+ * <ini>
+ * ll_stats_stream_interval - Link layer stats streaming interval
+ * @Min: 0
+ * @Max: 60000
+ * @Default: 0
+ *
+ * This ini is used to set the interval in ms at which the link layer
+ * stats of the peers of a connected STA or started SAP are fetched from
+ * firmware and sent to the WLAN service netlink multicast group, delta
+ * encoded against the previous interval. Intervals below 100 ms are
+ * raised to 100 ms. 0 disables the streaming.
+ *
+ * Related: None
+ *
+ * Supported Feature: STA, SAP
+ *
+ * Usage: External
+ *
+ * </ini>
+ */
+#define CFG_LL_STATS_STREAM_INTERVAL CFG_INI_UINT( \
+			"ll_stats_stream_interval", \
+			0, \
+			60000, \
+			0, \
+			CFG_VALUE_OR_DEFAULT, \
+			"Link layer stats streaming interval in ms")
+
 /*
  * <ini>
  * nb_commands_interval - Used to rate limit nb commands from userspace
@@ -1575,6 +1633,8 @@ enum host_log_level {
 	CFG(CFG_HDD_DOT11_MODE) \
 	CFG(CFG_ENABLE_DISABLE_CHANNEL) \
 	CFG(CFG_SAR_CONVERSION) \
+	CFG(CFG_STA_STATS_CACHE_AGE) \
+	CFG(CFG_LL_STATS_STREAM_INTERVAL) \
 	CFG(CFG_WOW_DISABLE) \
 	CFG(CFG_ENABLE_HOST_MODULE_LOG_LEVEL) \
 	SAR_SAFETY_FEATURE_ALL
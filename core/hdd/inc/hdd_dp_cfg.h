@@ -673,6 +673,63 @@
 		CFG_VALUE_OR_DEFAULT, \
 		"Threshold to trigger GRO flush skip for low T-put")
 
+/*
+ * <ini>
+ * gRpsSteerBigCpuMask - CPU mask of the cores heavy RX flows are pinned to
+ * @Min: 0
+ * @Max: 0xFFFF
+ * @Default: 0
+ *
+ * With dynamic RPS enabled in rx_mode, the RX flows with the highest byte
+ * rate are each pinned to a dedicated core of this mask, as long as the core
+ * is part of the RPS map installed on rx queue 0. The other flows are spread
+ * over the remaining cores of the RPS map. With 0 the cores of the RPS map
+ * with the highest CPU capacity are used, all of them on symmetric CPUs.
+ *
+ * Related: rx_mode, rpsRxQueueCpuMapList, gRpsSteerHeavyFlowThreshold
+ *
+ * Supported Feature: Dynamic RPS
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_RPS_STEER_BIG_CPU_MASK \
+		CFG_INI_UINT( \
+		"gRpsSteerBigCpuMask", \
+		0, \
+		0xFFFF, \
+		0, \
+		CFG_VALUE_OR_DEFAULT, \
+		"CPU mask of the cores heavy RX flows are pinned to")
+
+/*
+ * <ini>
+ * gRpsSteerHeavyFlowThreshold - RX rate in Mbps of a heavy flow
+ * @Min: 1
+ * @Max: 10000
+ * @Default: 100
+ *
+ * An RX flow is pinned to a dedicated core of gRpsSteerBigCpuMask when its
+ * rate over the last bus bandwidth compute interval reaches this threshold.
+ *
+ * Related: gRpsSteerBigCpuMask
+ *
+ * Supported Feature: Dynamic RPS
+ *
+ * Usage: Internal
+ *
+ * </ini>
+ */
+#define CFG_DP_RPS_STEER_HEAVY_FLOW_THRESHOLD \
+		CFG_INI_UINT( \
+		"gRpsSteerHeavyFlowThreshold", \
+		1, \
+		10000, \
+		100, \
+		CFG_VALUE_OR_DEFAULT, \
+		"RX rate in Mbps of a flow pinned to a big core")
+
 #endif /*WLAN_FEATURE_DP_BUS_BANDWIDTH*/
 
 /*
@@ -1209,7 +1266,9 @@
 	CFG(CFG_DP_TCP_DELACK_THRESHOLD_LOW) \
 	CFG(CFG_DP_TCP_DELACK_TIMER_COUNT) \
 	CFG(CFG_DP_TCP_TX_HIGH_TPUT_THRESHOLD) \
-	CFG(CFG_DP_BUS_LOW_BW_CNT_THRESHOLD)
+	CFG(CFG_DP_BUS_LOW_BW_CNT_THRESHOLD) \
+	CFG(CFG_DP_RPS_STEER_BIG_CPU_MASK) \
+	CFG(CFG_DP_RPS_STEER_HEAVY_FLOW_THRESHOLD)
 #else
 #define CFG_HDD_DP_BUS_BANDWIDTH
 #endif
@@ -176,6 +176,8 @@ struct hdd_config {
 	uint32_t tcp_delack_timer_count;
 	bool     enable_tcp_param_update;
 	uint32_t bus_low_cnt_threshold;
+	uint32_t rps_steer_big_cpu_mask;
+	uint32_t rps_steer_heavy_thres;
 #endif /*WLAN_FEATURE_DP_BUS_BANDWIDTH*/
 
 #ifdef QCA_LL_LEGACY_TX_FLOW_CONTROL
@@ -217,6 +219,8 @@ struct hdd_config {
 	uint32_t cfg_wmi_credit_cnt;
 	uint32_t enable_sar_conversion;
 	bool is_wow_disabled;
+	uint32_t sta_stats_cache_age;
+	uint32_t ll_stats_stream_interval;
 #ifdef WLAN_FEATURE_TSF_PLUS
 	uint8_t tsf_ptp_options;
 #endif /* WLAN_FEATURE_TSF_PLUS */
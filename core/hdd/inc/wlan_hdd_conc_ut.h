@@ -37,6 +37,7 @@ void wlan_hdd_two_connections_scenario(struct hdd_context *hdd_ctx,
 void wlan_hdd_three_connections_scenario(struct hdd_context *hdd_ctx,
 	uint8_t first_chnl, uint8_t second_chnl,
 	enum policy_mgr_chain_mode chain_mask, uint8_t use_same_mac);
+void wlan_hdd_packed_tables_scenario(struct hdd_context *hdd_ctx);
 #else
 static inline
 void clean_report(struct hdd_context *hdd_ctx)
@@ -74,5 +75,10 @@ void wlan_hdd_three_connections_scenario(struct hdd_context *hdd_ctx,
 		enum policy_mgr_chain_mode chain_mask, uint8_t use_same_mac)
 {
 }
+
+static inline
+void wlan_hdd_packed_tables_scenario(struct hdd_context *hdd_ctx)
+{
+}
 #endif
 #endif
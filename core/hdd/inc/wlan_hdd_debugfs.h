@@ -28,12 +28,14 @@
  * @HDD_DEBUFS_FILE_ID_CONNECT_INFO: connect_info file id
  * @HDD_DEBUFS_FILE_ID_ROAM_SCAN_STATS_INFO: roam_scan_stats file id
  * @HDD_DEBUFS_FILE_ID_OFFLOAD_INFO: offload_info file id
+ * @HDD_DEBUFS_FILE_ID_RPS_STEER_INFO: rps_steer file id
  * @HDD_DEBUGFS_FILE_ID_MAX: maximum id of csr debugfs file
  */
 enum hdd_debugfs_file_id {
 	HDD_DEBUFS_FILE_ID_CONNECT_INFO = 0,
 	HDD_DEBUFS_FILE_ID_ROAM_SCAN_STATS_INFO = 1,
 	HDD_DEBUFS_FILE_ID_OFFLOAD_INFO = 2,
+	HDD_DEBUFS_FILE_ID_RPS_STEER_INFO = 3,
 
 	HDD_DEBUGFS_FILE_ID_MAX,
 };
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wlan_hdd_debugfs_startup.h
+ *
+ * WLAN Host Device Driver implementation to export the per stage timing
+ * of driver module start through debugfs
+ */
+
+#ifndef _WLAN_HDD_DEBUGFS_STARTUP_H
+#define _WLAN_HDD_DEBUGFS_STARTUP_H
+
+#ifdef WLAN_DEBUGFS
+/**
+ * hdd_debugfs_startup_profile_init() - create the startup profile file
+ * @hdd_ctx: hdd context
+ *
+ * Return: None
+ */
+void hdd_debugfs_startup_profile_init(struct hdd_context *hdd_ctx);
+
+/**
+ * hdd_debugfs_startup_profile_deinit() - remove the startup profile file
+ * @hdd_ctx: hdd context
+ *
+ * Return: None
+ */
+void hdd_debugfs_startup_profile_deinit(struct hdd_context *hdd_ctx);
+#else
+static inline
+void hdd_debugfs_startup_profile_init(struct hdd_context *hdd_ctx)
+{
+}
+
+static inline
+void hdd_debugfs_startup_profile_deinit(struct hdd_context *hdd_ctx)
+{
+}
+#endif /* WLAN_DEBUGFS */
+#endif /* _WLAN_HDD_DEBUGFS_STARTUP_H */
@@ -76,6 +76,7 @@
 #include <qdf_defer.h>
 #include "sap_api.h"
 #include <wlan_hdd_lro.h>
+#include "wlan_hdd_rps_steer.h"
 #include "cdp_txrx_flow_ctrl_legacy.h"
 #include <cdp_txrx_peer_ops.h>
 #include "wlan_hdd_nan_datapath.h"
@@ -457,6 +458,20 @@ struct hdd_tx_rx_histogram {
 	uint64_t qtime;
 };
 
+/**
+ * enum hdd_rx_ol_flow_class - flow classes of the GRO coalescing stats
+ * @HDD_RX_OL_FLOW_TCP4: TCP over IPv4 carrying payload
+ * @HDD_RX_OL_FLOW_TCP6: TCP over IPv6 carrying payload
+ * @HDD_RX_OL_FLOW_TCP_ACK: pure TCP acks
+ * @HDD_RX_OL_FLOW_MAX: number of flow classes
+ */
+enum hdd_rx_ol_flow_class {
+	HDD_RX_OL_FLOW_TCP4,
+	HDD_RX_OL_FLOW_TCP6,
+	HDD_RX_OL_FLOW_TCP_ACK,
+	HDD_RX_OL_FLOW_MAX,
+};
+
 struct hdd_tx_rx_stats {
 	/* start_xmit stats */
 	__u32    tx_called;
@@ -478,6 +493,9 @@ struct hdd_tx_rx_stats {
 	__u32 rx_non_aggregated;
 	__u32 rx_gro_flush_skip;
 	__u32 rx_gro_low_tput_flush;
+	__u32 rx_gro_batch_flush;
+	__u32 rx_gro_pkts[HDD_RX_OL_FLOW_MAX];
+	__u32 rx_gro_merged[HDD_RX_OL_FLOW_MAX];
 
 	/* txflow stats */
 	bool     is_txflow_paused;
@@ -491,6 +509,34 @@ struct hdd_tx_rx_stats {
 	u64 jiffies_last_txtimeout;
 };
 
+#ifdef RECEIVE_OFFLOAD
+/**
+ * struct hdd_rx_ol_cpu_ctx - per-CPU context of the RX offload engine
+ * @napi: NAPI GRO is run on, it is never scheduled
+ * @lock: serializes GRO on @napi with the flush from other CPUs
+ * @held: packets held by GRO on @napi since it was last flushed
+ */
+struct hdd_rx_ol_cpu_ctx {
+	struct napi_struct napi;
+	qdf_spinlock_t lock;
+	uint32_t held;
+};
+
+/**
+ * struct hdd_rx_ol_engine - RX offload engine
+ * @netdev: dummy netdev the per-CPU NAPI contexts are attached to
+ * @cpu_ctx: per-CPU NAPI contexts of the possible CPUs
+ * @lithium: target delivers GRO packets from the DP RX threads
+ * @initialized: NAPI contexts are set up
+ */
+struct hdd_rx_ol_engine {
+	struct net_device *netdev;
+	struct hdd_rx_ol_cpu_ctx __percpu *cpu_ctx;
+	bool lithium;
+	bool initialized;
+};
+#endif
+
 #ifdef WLAN_FEATURE_11W
 /**
  * struct hdd_pmf_stats - Protected Management Frame statistics
@@ -639,6 +685,78 @@ struct hdd_stats {
 #endif
 };
 
+/**
+ * struct hdd_stats_cache - cache of the station stats of an adapter
+ * @refresh_work: work refreshing the cached stats from firmware
+ * @refresh_pending: a refresh request to firmware is in flight
+ * @gen: bumped on invalidation, a refresh started before is not cached
+ * @last_update: time of the last refresh in ms, 0 if the cache is empty
+ * @hits: requests served from a fresh snapshot
+ * @stale_hits: requests served from a snapshot past half of its maximum age,
+ *	which also start a background refresh
+ * @misses: requests which waited for firmware
+ * @coalesced: requests which waited for a refresh already in flight
+ *
+ * The cached stats are the ones saved in struct hdd_stats of the adapter.
+ */
+struct hdd_stats_cache {
+	struct work_struct refresh_work;
+	qdf_atomic_t refresh_pending;
+	qdf_atomic_t gen;
+	qdf_time_t last_update;
+	uint32_t hits;
+	uint32_t stale_hits;
+	uint32_t misses;
+	uint32_t coalesced;
+};
+
+/**
+ * struct hdd_ll_stats_stream_peer - counters of a peer at the last interval
+ * @peer_macaddr: peer mac address
+ * @tx_mpdu: MPDUs transmitted, summed over all rates
+ * @rx_mpdu: MPDUs received, summed over all rates
+ * @mpdu_lost: MPDUs lost, summed over all rates
+ * @retries: MPDU retries, summed over all rates
+ */
+struct hdd_ll_stats_stream_peer {
+	struct qdf_mac_addr peer_macaddr;
+	uint32_t tx_mpdu;
+	uint32_t rx_mpdu;
+	uint32_t mpdu_lost;
+	uint32_t retries;
+};
+
+/**
+ * struct hdd_ll_stats_stream - periodic link layer stats streaming
+ * @work: work fetching the link layer stats every interval
+ * @lock: protects the peer tables against the stats response
+ * @interval_ms: streaming interval, 0 if the streaming is stopped
+ * @armed: stats are fetched every interval, set while the link is up
+ * @ll_stats_enabled: firmware LL stats were enabled by the stream, to be
+ *	disabled again on disarm
+ * @seq: sequence number of the interval being streamed
+ * @prev: peer counters of the previous interval, the delta reference
+ * @num_prev: number of valid entries in @prev
+ * @cur: peer counters of the interval being streamed
+ * @num_cur: number of valid entries in @cur
+ * @num_msgs: netlink messages sent
+ * @num_failures: intervals for which firmware did not answer
+ */
+struct hdd_ll_stats_stream {
+	struct delayed_work work;
+	qdf_spinlock_t lock;
+	uint32_t interval_ms;
+	bool armed;
+	bool ll_stats_enabled;
+	uint16_t seq;
+	struct hdd_ll_stats_stream_peer *prev;
+	uint16_t num_prev;
+	struct hdd_ll_stats_stream_peer *cur;
+	uint16_t num_cur;
+	uint32_t num_msgs;
+	uint32_t num_failures;
+};
+
 /**
  * struct hdd_roaming_info - HDD Internal Roaming Information
  * @bssid: BSSID to which we are connected
@@ -1072,7 +1190,8 @@ struct hdd_multicast_addr_list {
 	uint8_t addr[WLAN_HDD_MAX_MC_ADDR_LIST][ETH_ALEN];
 };
 
-#define WLAN_HDD_MAX_HISTORY_ENTRY 25
+/* netif queue history entries per CPU, must be a power of 2 */
+#define WLAN_HDD_MAX_HISTORY_ENTRY 16
 
 /**
  * struct hdd_netif_queue_stats - netif queue operation statistics
@@ -1087,20 +1206,39 @@ struct hdd_netif_queue_stats {
 
 /**
  * struct hdd_netif_queue_history - netif queue operation history
- * @time: timestamp
+ * @seq: entry sequence, odd while the entry is being written
+ * @time: timestamp in microseconds
  * @netif_action: action type
  * @netif_reason: reason type
  * @pause_map: pause map
+ * @cpu: CPU which recorded the entry
  * @tx_q_state: state of the netdev TX queues
  */
 struct hdd_netif_queue_history {
-	qdf_time_t time;
+	uint32_t seq;
+	uint64_t time;
 	uint16_t netif_action;
 	uint16_t netif_reason;
 	uint32_t pause_map;
+	uint8_t cpu;
 	unsigned long tx_q_state[NUM_TX_QUEUES];
 };
 
+/**
+ * struct hdd_netif_queue_history_ring - per CPU netif queue history
+ * @head: number of entries recorded by the CPU
+ * @entries: history entries, only written by the owning CPU
+ *
+ * Every CPU records into its own ring with interrupts disabled, so no lock
+ * is taken in the queue control path. Readers copy the entries, drop the
+ * ones rewritten meanwhile using @seq, and merge the CPUs by time. The
+ * rings of an adapter are allocated for nr_cpu_ids CPUs with the adapter.
+ */
+struct hdd_netif_queue_history_ring {
+	uint32_t head;
+	struct hdd_netif_queue_history entries[WLAN_HDD_MAX_HISTORY_ENTRY];
+} ____cacheline_aligned_in_smp;
+
 /**
  * struct hdd_chan_change_params - channel related information
  * @chan: operating channel
@@ -1227,6 +1365,7 @@ struct hdd_adapter {
 	struct net_device_stats stats;
 	/** HDD statistics*/
 	struct hdd_stats hdd_stats;
+	struct hdd_stats_cache stats_cache;
 
 	/* estimated link speed */
 	uint32_t estimated_linkspeed;
@@ -1365,9 +1504,12 @@ struct hdd_adapter {
 
 	/* DSCP to UP QoS Mapping */
 	enum sme_qos_wmmuptype dscp_to_up_map[WLAN_MAX_DSCP + 1];
+	/* DSCP to netdev queue map of the TX classifier */
+	struct hdd_wmm_classifier wmm_classifier;
 
 #ifdef WLAN_FEATURE_LINK_LAYER_STATS
 	bool is_link_layer_stats_set;
+	struct hdd_ll_stats_stream ll_stats_stream;
 #endif
 	uint8_t link_status;
 
@@ -1387,9 +1529,8 @@ struct hdd_adapter {
 	qdf_time_t last_time;
 	qdf_time_t total_pause_time;
 	qdf_time_t total_unpause_time;
-	uint8_t history_index;
-	struct hdd_netif_queue_history
-		 queue_oper_history[WLAN_HDD_MAX_HISTORY_ENTRY];
+	uint64_t history_clear_time;
+	struct hdd_netif_queue_history_ring *queue_oper_history;
 	struct hdd_netif_queue_stats queue_oper_stats[WLAN_REASON_TYPE_MAX];
 	ol_txrx_tx_fp tx_fn;
 	/* debugfs entry */
@@ -1704,6 +1845,71 @@ struct hdd_fw_ver_info {
 	uint32_t crmid;
 };
 
+/**
+ * enum hdd_startup_stage - profiled stages of hdd_wlan_start_modules()
+ * @HDD_STARTUP_POWER_ON: pld power on
+ * @HDD_STARTUP_HIF_OPEN: hif open
+ * @HDD_STARTUP_BMI_INIT: ol_cds_init, BMI context creation
+ * @HDD_STARTUP_PSOC_OPEN: legacy component psoc open
+ * @HDD_STARTUP_CONFIG: hdd configuration update
+ * @HDD_STARTUP_WBUFF_INIT: wbuff pool preallocation, runs concurrently
+ *	with @HDD_STARTUP_PSOC_OPEN and @HDD_STARTUP_CONFIG
+ * @HDD_STARTUP_CDS_OPEN: cds open, includes firmware download
+ * @HDD_STARTUP_COMPONENT_CONFIG: component configuration update
+ * @HDD_STARTUP_DP_OPEN: cds dp open
+ * @HDD_STARTUP_REGISTER: hdd callback and notifier registration
+ * @HDD_STARTUP_PRE_ENABLE: cds pre enable
+ * @HDD_STARTUP_CONFIGURE_CDS: cds enable and configuration
+ * @HDD_STARTUP_STAGE_MAX: number of stages
+ */
+enum hdd_startup_stage {
+	HDD_STARTUP_POWER_ON,
+	HDD_STARTUP_HIF_OPEN,
+	HDD_STARTUP_BMI_INIT,
+	HDD_STARTUP_PSOC_OPEN,
+	HDD_STARTUP_CONFIG,
+	HDD_STARTUP_WBUFF_INIT,
+	HDD_STARTUP_CDS_OPEN,
+	HDD_STARTUP_COMPONENT_CONFIG,
+	HDD_STARTUP_DP_OPEN,
+	HDD_STARTUP_REGISTER,
+	HDD_STARTUP_PRE_ENABLE,
+	HDD_STARTUP_CONFIGURE_CDS,
+	HDD_STARTUP_STAGE_MAX,
+};
+
+/**
+ * struct hdd_startup_profile - per stage timing of driver module start
+ * @start_us: timestamp the current start began at
+ * @mark_us: timestamp the previous sequential stage ended at
+ * @stage_us: duration of each stage during the last start
+ * @max_stage_us: longest duration seen for each stage
+ * @total_us: duration of the last successful start
+ * @max_total_us: longest successful start
+ * @count: number of successful starts
+ * @fail_count: number of failed starts
+ * @ini_parse_us: time spent parsing the INI file when the context was created
+ * @mac_parse_us: time spent parsing the MAC address file
+ * @async_work: work running the stage which is overlapped with others
+ * @async_status: status of the overlapped stage
+ * @async_pending: the overlapped stage has been scheduled and not joined
+ */
+struct hdd_startup_profile {
+	uint64_t start_us;
+	uint64_t mark_us;
+	uint32_t stage_us[HDD_STARTUP_STAGE_MAX];
+	uint32_t max_stage_us[HDD_STARTUP_STAGE_MAX];
+	uint32_t total_us;
+	uint32_t max_total_us;
+	uint32_t count;
+	uint32_t fail_count;
+	uint32_t ini_parse_us;
+	uint32_t mac_parse_us;
+	qdf_work_t async_work;
+	QDF_STATUS async_status;
+	bool async_pending;
+};
+
 /**
  * struct hdd_context - hdd shared driver and psoc/device context
  * @psoc: object manager psoc context
@@ -1715,6 +1921,7 @@ struct hdd_fw_ver_info {
  * @psoc_idle_timeout_work: delayed work for psoc idle shutdown
  * @dynamic_nss_chains_support: Per vdev dynamic nss chains update capability
  * @sar_cmd_params: SAR command params to be configured to the FW
+ * @startup_profile: per stage timing of hdd_wlan_start_modules()
  */
 struct hdd_context {
 	struct wlan_objmgr_psoc *psoc;
@@ -1915,6 +2122,9 @@ struct hdd_context {
 	struct qdf_delayed_work psoc_idle_timeout_work;
 	bool rps;
 	bool dynamic_rps;
+#ifdef WLAN_FEATURE_DP_BUS_BANDWIDTH
+	struct hdd_rps_steer rps_steer;
+#endif
 	bool enable_rxthread;
 	/* support for DP RX threads */
 	bool enable_dp_rx_threads;
@@ -1966,6 +2176,9 @@ struct hdd_context {
 	bool is_fils_roaming_supported;
 	QDF_STATUS (*receive_offload_cb)(struct hdd_adapter *,
 					 struct sk_buff *);
+#ifdef RECEIVE_OFFLOAD
+	struct hdd_rx_ol_engine rx_ol;
+#endif
 	qdf_atomic_t vendor_disable_lro_flag;
 
 	/* disable RX offload (GRO/LRO) in concurrency scenarios */
@@ -2026,6 +2239,7 @@ struct hdd_context {
 	uint8_t dutycycle_off_percent;
 #endif
 	bool ll_stats_per_chan_rx_tx_time;
+	struct hdd_startup_profile startup_profile;
 };
 
 /**
@@ -2786,6 +3000,15 @@ void hdd_context_destroy(struct hdd_context *hdd_ctx);
 
 int hdd_wlan_notify_modem_power_state(int state);
 
+/*
+ * Service indication of the streamed link layer stats, defined here until
+ * the common netlink header carries it.
+ */
+#if defined(WLAN_FEATURE_LINK_LAYER_STATS) && \
+	!defined(WLAN_SVC_LL_STATS_STREAM_IND)
+#define WLAN_SVC_LL_STATS_STREAM_IND 0x10
+#endif
+
 void wlan_hdd_send_svc_nlink_msg(int radio, int type, void *data, int len);
 #ifdef FEATURE_WLAN_AUTO_SHUTDOWN
 void wlan_hdd_auto_shutdown_enable(struct hdd_context *hdd_ctx, bool enable);
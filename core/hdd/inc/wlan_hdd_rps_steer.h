@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#ifndef __WLAN_HDD_RPS_STEER_H__
+#define __WLAN_HDD_RPS_STEER_H__
+/**
+ * DOC: wlan_hdd_rps_steer.h
+ *
+ * Flow aware RPS steering. The RX flows are tracked by the flow id the
+ * target computes, and every bus bandwidth interval the heaviest flows are
+ * pinned to dedicated big cores while the other flows are spread over the
+ * remaining cores of the RPS map. A flow is steered by giving its packets
+ * a hash which RPS maps to the chosen core.
+ */
+
+#include <qdf_atomic.h>
+#include <qdf_lock.h>
+#include <qdf_nbuf.h>
+
+struct hdd_context;
+struct hdd_adapter;
+
+#ifdef WLAN_FEATURE_DP_BUS_BANDWIDTH
+
+#define HDD_RPS_STEER_TABLE_SIZE	64
+#define HDD_RPS_STEER_MAX_CPUS		16
+#define HDD_RPS_STEER_CPU_NONE		0xFF
+
+/**
+ * struct hdd_rps_steer_flow - RX flow tracked for RPS steering
+ * @flow_id: flow id computed by the target, 0 if the entry is free
+ * @bytes: bytes received since the last update
+ * @steer_hash: hash given to the packets of the flow, 0 if not steered
+ * @vdev_id: vdev the flow was first seen on
+ * @rate: RX rate in bytes per second over the last interval
+ * @cpu: CPU the flow is steered to
+ * @idle_cnt: consecutive intervals without any packet
+ * @heavy: flow is pinned to a big core
+ *
+ * @flow_id, @bytes, @steer_hash and @cpu are accessed by the RX path
+ * without the lock, the other fields only by the update.
+ */
+struct hdd_rps_steer_flow {
+	qdf_atomic_t flow_id;
+	qdf_atomic_t bytes;
+	qdf_atomic_t steer_hash;
+	uint8_t vdev_id;
+	uint64_t rate;
+	uint8_t cpu;
+	uint8_t idle_cnt;
+	bool heavy;
+};
+
+/**
+ * struct hdd_rps_steer - flow aware RPS steering context
+ * @lock: serializes the update against start, stop and debugfs
+ * @flows: flow table, indexed by flow id
+ * @map_cpus: CPUs of the RPS map installed on rx queue 0, in map order
+ * @map_len: number of valid entries in @map_cpus
+ * @big_mask: CPU mask of the big cores used by the last update
+ * @active: RPS map is installed and the RX flows are being steered
+ * @num_flows: number of tracked flows
+ * @num_heavy: number of flows pinned to a big core
+ * @evictions: flows not tracked as their table entry was busy
+ * @map_mismatches: packets not steered as the live RPS map did not
+ *	resolve their hash to the CPU of their flow
+ */
+struct hdd_rps_steer {
+	qdf_spinlock_t lock;
+	struct hdd_rps_steer_flow flows[HDD_RPS_STEER_TABLE_SIZE];
+	uint8_t map_cpus[HDD_RPS_STEER_MAX_CPUS];
+	uint8_t map_len;
+	uint32_t big_mask;
+	bool active;
+	uint32_t num_flows;
+	uint32_t num_heavy;
+	qdf_atomic_t evictions;
+	qdf_atomic_t map_mismatches;
+};
+
+/**
+ * hdd_rps_steer_init() - Initialize the RPS steering context
+ * @hdd_ctx: HDD context
+ *
+ * Return: none
+ */
+void hdd_rps_steer_init(struct hdd_context *hdd_ctx);
+
+/**
+ * hdd_rps_steer_deinit() - De-initialize the RPS steering context
+ * @hdd_ctx: HDD context
+ *
+ * Return: none
+ */
+void hdd_rps_steer_deinit(struct hdd_context *hdd_ctx);
+
+/**
+ * hdd_rps_steer_start() - Start steering once the RPS map is installed
+ * @hdd_ctx: HDD context
+ *
+ * Return: none
+ */
+void hdd_rps_steer_start(struct hdd_context *hdd_ctx);
+
+/**
+ * hdd_rps_steer_stop() - Stop steering and forget the tracked flows
+ * @hdd_ctx: HDD context
+ *
+ * Return: none
+ */
+void hdd_rps_steer_stop(struct hdd_context *hdd_ctx);
+
+/**
+ * hdd_rps_steer_update() - Rank the flows and assign them to CPUs
+ * @hdd_ctx: HDD context
+ *
+ * Called from the bus bandwidth work once per compute interval.
+ *
+ * Return: none
+ */
+void hdd_rps_steer_update(struct hdd_context *hdd_ctx);
+
+/**
+ * hdd_rps_steer_rx() - Account an RX packet and apply its steering hash
+ * @adapter: adapter the packet is received on
+ * @skb: received packet, after eth_type_trans()
+ *
+ * Lockless, the hash is only applied if the RPS map installed on the rx
+ * queue of @skb resolves it to the CPU of the flow.
+ *
+ * Return: none
+ */
+void hdd_rps_steer_rx(struct hdd_adapter *adapter, struct sk_buff *skb);
+
+/**
+ * hdd_rps_steer_debugfs_show() - Print the CPU assignment of adapter flows
+ * @adapter: adapter whose flows are printed
+ * @buf: output buffer
+ * @buf_avail_len: available buffer length
+ *
+ * Return: No.of bytes copied
+ */
+ssize_t hdd_rps_steer_debugfs_show(struct hdd_adapter *adapter,
+				   uint8_t *buf, ssize_t buf_avail_len);
+#else
+static inline void hdd_rps_steer_init(struct hdd_context *hdd_ctx)
+{
+}
+
+static inline void hdd_rps_steer_deinit(struct hdd_context *hdd_ctx)
+{
+}
+
+static inline void hdd_rps_steer_start(struct hdd_context *hdd_ctx)
+{
+}
+
+static inline void hdd_rps_steer_stop(struct hdd_context *hdd_ctx)
+{
+}
+
+static inline void hdd_rps_steer_update(struct hdd_context *hdd_ctx)
+{
+}
+
+static inline void hdd_rps_steer_rx(struct hdd_adapter *adapter,
+				    struct sk_buff *skb)
+{
+}
+
+static inline ssize_t hdd_rps_steer_debugfs_show(struct hdd_adapter *adapter,
+						 uint8_t *buf,
+						 ssize_t buf_avail_len)
+{
+	return 0;
+}
+#endif /* WLAN_FEATURE_DP_BUS_BANDWIDTH */
+#endif /* __WLAN_HDD_RPS_STEER_H__ */
@@ -101,6 +101,7 @@
 	ENUM(TRACE_CODE_HDD_CFG80211_SCHED_SCAN_STOP) \
 	ENUM(TRACE_CODE_HDD_CFG80211_DEL_PMKSA) \
 	ENUM(TRACE_CODE_HDD_SEND_MGMT_TX) \
+	ENUM(TRACE_CODE_HDD_STARTUP_STAGE) \
 	/*
 	 * New CFG80211 enums to be added before this comment.
 	 * TRACE_CODE_HDD_RX_SME_MSG is used as code for MTRACE commands.
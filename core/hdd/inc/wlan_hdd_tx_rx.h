@@ -153,6 +153,42 @@ QDF_STATUS hdd_rx_pkt_thread_enqueue_cbk(void *adapter_context,
  */
 int hdd_rx_ol_init(struct hdd_context *hdd_ctx);
 
+/**
+ * hdd_rx_ol_deinit() - Release the per-CPU NAPI contexts of the Rx offload
+ * @hdd_ctx: pointer to HDD Station Context
+ *
+ * Return: none
+ */
+void hdd_rx_ol_deinit(struct hdd_context *hdd_ctx);
+
+/**
+ * hdd_rx_ol_batch_end() - Finish delivering a chain of RX packets
+ * @adapter: pointer to HDD adapter the chain was received on
+ *
+ * Flushes the GRO packets held during the batch when running from an RX
+ * thread, or when throughput is idle in NAPI mode.
+ *
+ * Return: none
+ */
+void hdd_rx_ol_batch_end(struct hdd_adapter *adapter);
+
+/**
+ * hdd_rx_ol_flow_class_str() - Name of a GRO stats flow class
+ * @flow_class: flow class
+ *
+ * Return: printable name of @flow_class
+ */
+const char *hdd_rx_ol_flow_class_str(enum hdd_rx_ol_flow_class flow_class);
+
+/**
+ * hdd_rx_ol_coalesce_ratio() - GRO coalescing ratio of a flow class
+ * @pkts: packets handed to GRO
+ * @merged: packets GRO merged into a held packet
+ *
+ * Return: packets handed to GRO per packet delivered to the stack, times 100
+ */
+uint32_t hdd_rx_ol_coalesce_ratio(uint32_t pkts, uint32_t merged);
+
 /**
  * hdd_disable_rx_ol_in_concurrency() - Disable Rx offload due to concurrency
  * @disable: true/false to disable/enable the Rx offload
@@ -453,6 +489,44 @@ uint32_t
 wlan_hdd_dump_queue_history_state(struct hdd_netif_queue_history *q_hist,
 				  char *buf, uint32_t size);
 
+/**
+ * wlan_hdd_queue_history_alloc() - Allocate the netif queue history rings
+ * @adapter: adapter handle
+ *
+ * One ring is allocated for each of the nr_cpu_ids CPUs.
+ *
+ * Return: QDF_STATUS_SUCCESS, QDF_STATUS_E_NOMEM on allocation failure
+ */
+QDF_STATUS wlan_hdd_queue_history_alloc(struct hdd_adapter *adapter);
+
+/**
+ * wlan_hdd_queue_history_free() - Free the netif queue history rings
+ * @rings: rings allocated by wlan_hdd_queue_history_alloc()
+ *
+ * Takes the rings rather than the adapter, as they are freed once the
+ * adapter memory is gone with its net device.
+ *
+ * Return: None
+ */
+void wlan_hdd_queue_history_free(struct hdd_netif_queue_history_ring *rings);
+
+/**
+ * wlan_hdd_get_queue_history() - Merge the per CPU netif queue history
+ * @adapter: adapter handle
+ * @q_hist: array the entries are copied to
+ * @max_entries: number of entries @q_hist can hold
+ *
+ * Copy the netif queue history recorded by every CPU since the last clear
+ * and sort it from the oldest to the newest entry. Entries rewritten while
+ * being copied are skipped.
+ *
+ * Return: number of entries copied to @q_hist
+ */
+uint32_t
+wlan_hdd_get_queue_history(struct hdd_adapter *adapter,
+			   struct hdd_netif_queue_history *q_hist,
+			   uint32_t max_entries);
+
 /**
  * wlan_hdd_rx_rpm_mark_last_busy() - Check if dp rx marked last busy
  * @hdd_ctx: Pointer to hdd context
@@ -190,6 +190,15 @@ struct hdd_wmm_status {
 	bool qos_connection;
 };
 
+/**
+ * struct hdd_wmm_classifier - per-adapter TX packet classifier
+ * @dscp_to_queue_map: netdev queue of each DSCP, derived from the adapter
+ *	DSCP-to-UP map
+ */
+struct hdd_wmm_classifier {
+	uint8_t dscp_to_queue_map[WLAN_MAX_DSCP + 1];
+};
+
 extern const uint8_t hdd_qdisc_ac_to_tl_ac[];
 extern const uint8_t hdd_wmm_up_to_ac_map[];
 extern const uint8_t hdd_linux_up_to_ac_map[];
@@ -227,6 +236,18 @@ QDF_STATUS hdd_send_dscp_up_map_to_fw(struct hdd_adapter *adapter);
  */
 QDF_STATUS hdd_wmm_init(struct hdd_adapter *adapter);
 
+/**
+ * hdd_wmm_update_dscp_queue_map() - rebuild the DSCP-to-queue map
+ * @adapter: adapter whose DSCP-to-UP map has changed
+ *
+ * Recomputes the netdev queue of each DSCP from the adapter DSCP-to-UP map
+ * and drops the flows cached by the TX classifier. To be called whenever
+ * the DSCP-to-UP map of the adapter is written.
+ *
+ * Return: None
+ */
+void hdd_wmm_update_dscp_queue_map(struct hdd_adapter *adapter);
+
 /**
  * hdd_wmm_adapter_init() - initialize the WMM configuration of an adapter
  * @adapter: [in]  pointer to Adapter context
@@ -1869,6 +1869,8 @@ static QDF_STATUS hdd_dis_connect_handler(struct hdd_adapter *adapter,
 	complete(&adapter->disconnect_comp_var);
 
 	hdd_nud_reset_tracking(adapter);
+	hdd_stats_cache_invalidate(adapter);
+	hdd_ll_stats_stream_disarm(adapter);
 
 	hdd_set_disconnect_status(adapter, false);
 
@@ -2773,6 +2775,9 @@ hdd_association_completion_handler(struct hdd_adapter *adapter,
 	 */
 	hdd_reset_scan_reject_params(hdd_ctx, roam_status, roam_result);
 
+	/* cached station stats belong to the previous link, if any */
+	hdd_stats_cache_invalidate(adapter);
+
 	/* HDD has initiated disconnect, do not send connect result indication
 	 * to kernel as it will be handled by __cfg80211_disconnect.
 	 */
@@ -2822,6 +2827,7 @@ hdd_association_completion_handler(struct hdd_adapter *adapter,
 		/* Save the connection info from CSR... */
 		hdd_conn_save_connect_info(adapter, roam_info,
 					   eCSR_BSS_TYPE_INFRASTRUCTURE);
+		hdd_ll_stats_stream_arm(adapter);
 
 		if (hdd_add_beacon_filter(adapter) != 0)
 			hdd_err("hdd_add_beacon_filter() failed");
@@ -4833,6 +4839,7 @@ hdd_sme_roam_callback(void *context, struct csr_roam_info *roam_info,
 	case eCSR_ROAM_SYNCH_COMPLETE:
 		hdd_debug("LFR3: Roam synch complete");
 		hdd_set_roaming_in_progress(false);
+		hdd_stats_cache_invalidate(adapter);
 		break;
 	case eCSR_ROAM_SHOULD_ROAM:
 		/* notify apps that we can't pass traffic anymore */
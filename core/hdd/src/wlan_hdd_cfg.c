@@ -235,6 +235,7 @@ QDF_STATUS hdd_update_mac_config(struct hdd_context *hdd_ctx)
 	int max_mac_addr = QDF_MAX_CONCURRENCY_PERSONA;
 	struct hdd_cfg_entry mac_table[QDF_MAX_CONCURRENCY_PERSONA];
 	tSirMacAddr custom_mac_addr;
+	uint64_t start_us;
 
 	QDF_STATUS qdf_status = QDF_STATUS_SUCCESS;
 
@@ -257,6 +258,7 @@ QDF_STATUS hdd_update_mac_config(struct hdd_context *hdd_ctx)
 
 	hdd_debug("wlan_mac.bin size %zu", fw->size);
 
+	start_us = qdf_get_log_timestamp_usecs();
 	temp = qdf_mem_malloc(fw->size + 1);
 
 	if (!temp) {
@@ -316,6 +318,8 @@ QDF_STATUS hdd_update_mac_config(struct hdd_context *hdd_ctx)
 		hdd_err("Invalid MAC addresses provided");
 		goto config_exit;
 	}
+	hdd_ctx->startup_profile.mac_parse_us =
+		qdf_get_log_timestamp_usecs() - start_us;
 	hdd_ctx->num_provisioned_addr = i;
 	hdd_debug("Populating remaining %d Mac addresses",
 		   max_mac_addr - i);
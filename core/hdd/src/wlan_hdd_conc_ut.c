@@ -36,6 +36,7 @@
 
 #define NUMBER_OF_SCENARIO 300
 #define MAX_ALLOWED_CHAR_IN_REPORT 50
+#define PACKED_TABLES_UT_ITERATIONS 100
 
 /**
  * struct report_t: Data structure to fill report
@@ -886,3 +887,31 @@ void wlan_hdd_three_connections_scenario(struct hdd_context *hdd_ctx,
 		next_sub_type = PM_STA_MODE;
 	}
 }
+
+void wlan_hdd_packed_tables_scenario(struct hdd_context *hdd_ctx)
+{
+	struct policy_mgr_packed_tables_ut_result result;
+	char reason[MAX_ALLOWED_CHAR_IN_REPORT] = {0};
+	QDF_STATUS ret;
+
+	/* rebuild the tables, and their packed form, for this HW */
+	ret = policy_mgr_psoc_enable(hdd_ctx->psoc);
+	if (!QDF_IS_STATUS_SUCCESS(ret)) {
+		hdd_err("Policy manager initialization failed");
+		return;
+	}
+
+	ret = policy_mgr_packed_tables_ut(PACKED_TABLES_UT_ITERATIONS,
+					  &result);
+	snprintf(reason, sizeof(reason), "%u/%u mismatch",
+		 result.num_mismatch, result.num_lookups);
+	fill_report(hdd_ctx, "packed tables", PM_MAX_NUM_OF_MODE,
+		    PM_MAX_NUM_OF_MODE, PM_MAX_NUM_OF_MODE, 0, 0, 0,
+		    QDF_IS_STATUS_SUCCESS(ret), PM_MAX_PCL_TYPE, reason, NULL);
+
+	pr_info("packed tables: %u lookups, %u mismatch, %u passes orig %llu us packed %llu us, size orig %u packed %u\n",
+		result.num_lookups, result.num_mismatch,
+		PACKED_TABLES_UT_ITERATIONS, result.orig_lookup_us,
+		result.packed_lookup_us, result.orig_size,
+		result.packed_size);
+}
@@ -87,6 +87,10 @@ wlan_hdd_debugfs_update_csr(struct hdd_context *hdd_ctx,
 		len = wlan_hdd_debugfs_update_filters_info(hdd_ctx, adapter,
 							   buf, buf_avail_len);
 		break;
+	case HDD_DEBUFS_FILE_ID_RPS_STEER_INFO:
+		/* populate per-flow RPS steering */
+		len = hdd_rps_steer_debugfs_show(adapter, buf, buf_avail_len);
+		break;
 	default:
 		hdd_err("Failed to fetch stats, unknown stats type");
 	}
@@ -362,6 +366,18 @@ void wlan_hdd_debugfs_csr_init(struct hdd_adapter *adapter)
 		if (!csr->entry)
 			hdd_err("Failed to create generic_info debugfs file");
 	}
+
+	csr = &adapter->csr_file[HDD_DEBUFS_FILE_ID_RPS_STEER_INFO];
+	if (!csr->entry) {
+		strlcpy(csr->name, "rps_steer", max_len);
+		csr->id = HDD_DEBUFS_FILE_ID_RPS_STEER_INFO;
+		csr->buf_max_size = DEBUGFS_RPS_STEER_INFO_BUF_SIZE;
+		csr->entry = debugfs_create_file(csr->name, 0444,
+						 adapter->debugfs_phy,
+						 csr, &fops_csr_debugfs);
+		if (!csr->entry)
+			hdd_err("Failed to create rps_steer debugfs file");
+	}
 }
 
 void wlan_hdd_debugfs_csr_deinit(struct hdd_adapter *adapter)
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wlan_hdd_debugfs_startup.c
+ *
+ * WLAN Host Device Driver implementation to export the per stage timing
+ * of driver module start through debugfs
+ *
+ * Example to read the startup profile:
+ * sm6150:/ # cat /sys/kernel/debug/wlan/startup_profile
+ */
+
+#include "wlan_hdd_main.h"
+#include "osif_psoc_sync.h"
+#include "wlan_hdd_debugfs_startup.h"
+
+#define STARTUP_DEBUGFS_PERMS	(QDF_FILE_USR_READ |	\
+				 QDF_FILE_GRP_READ |	\
+				 QDF_FILE_OTH_READ)
+
+/**
+ * hdd_startup_stage_str() - name of a startup stage
+ * @stage: startup stage
+ *
+ * Return: printable name of @stage
+ */
+static const char *hdd_startup_stage_str(enum hdd_startup_stage stage)
+{
+	switch (stage) {
+	case HDD_STARTUP_POWER_ON:
+		return "power_on";
+	case HDD_STARTUP_HIF_OPEN:
+		return "hif_open";
+	case HDD_STARTUP_BMI_INIT:
+		return "bmi_init";
+	case HDD_STARTUP_PSOC_OPEN:
+		return "psoc_open";
+	case HDD_STARTUP_CONFIG:
+		return "config";
+	case HDD_STARTUP_WBUFF_INIT:
+		return "wbuff_init (async)";
+	case HDD_STARTUP_CDS_OPEN:
+		return "cds_open";
+	case HDD_STARTUP_COMPONENT_CONFIG:
+		return "component_config";
+	case HDD_STARTUP_DP_OPEN:
+		return "dp_open";
+	case HDD_STARTUP_REGISTER:
+		return "register";
+	case HDD_STARTUP_PRE_ENABLE:
+		return "pre_enable";
+	case HDD_STARTUP_CONFIGURE_CDS:
+		return "configure_cds";
+	default:
+		return "unknown";
+	}
+}
+
+static QDF_STATUS hdd_debugfs_startup_profile_read(qdf_debugfs_file_t file,
+						   void *arg)
+{
+	struct hdd_context *hdd_ctx = arg;
+	struct hdd_startup_profile *profile;
+	struct osif_psoc_sync *psoc_sync;
+	enum hdd_startup_stage stage;
+	int ret;
+
+	ret = osif_psoc_sync_op_start(wiphy_dev(hdd_ctx->wiphy), &psoc_sync);
+	if (ret)
+		return qdf_status_from_os_return(ret);
+
+	profile = &hdd_ctx->startup_profile;
+	qdf_debugfs_printf(file, "starts: %u failed: %u\n"
+				 "last total: %u us max total: %u us\n"
+				 "ini parse: %u us mac parse: %u us\n"
+				 "%-20s %12s %12s\n",
+			   profile->count, profile->fail_count,
+			   profile->total_us, profile->max_total_us,
+			   profile->ini_parse_us, profile->mac_parse_us,
+			   "stage", "last(us)", "max(us)");
+
+	for (stage = 0; stage < HDD_STARTUP_STAGE_MAX; stage++)
+		qdf_debugfs_printf(file, "%-20s %12u %12u\n",
+				   hdd_startup_stage_str(stage),
+				   profile->stage_us[stage],
+				   profile->max_stage_us[stage]);
+
+	osif_psoc_sync_op_stop(psoc_sync);
+
+	return QDF_STATUS_SUCCESS;
+}
+
+static struct qdf_debugfs_fops hdd_startup_profile_fops = {
+	.show = hdd_debugfs_startup_profile_read,
+};
+
+void hdd_debugfs_startup_profile_init(struct hdd_context *hdd_ctx)
+{
+	hdd_startup_profile_fops.priv = hdd_ctx;
+	if (!qdf_debugfs_create_file("startup_profile", STARTUP_DEBUGFS_PERMS,
+				     NULL, &hdd_startup_profile_fops))
+		hdd_err("Failed to create the startup profile file");
+}
+
+void hdd_debugfs_startup_profile_deinit(struct hdd_context *hdd_ctx)
+{
+	/* the file has no directory, it is removed as part of qdf remove */
+}
@@ -1918,6 +1918,7 @@ QDF_STATUS hdd_hostapd_sap_event_cb(struct sap_event *sap_event,
 
 		hostapd_state->bss_state = BSS_START;
 		hdd_start_tsf_sync(adapter);
+		hdd_ll_stats_stream_arm(adapter);
 
 		/* Set default key index */
 		hdd_debug("default key index %hu", ap_ctx->wep_def_key_idx);
@@ -1994,6 +1995,7 @@ QDF_STATUS hdd_hostapd_sap_event_cb(struct sap_event *sap_event,
 		}
 		hdd_nofl_info("Ap stopped vid %d reason=%d", adapter->vdev_id,
 			      ap_ctx->bss_stop_reason);
+		hdd_ll_stats_stream_disarm(adapter);
 		if ((BSS_STOP_DUE_TO_MCC_SCC_SWITCH !=
 			ap_ctx->bss_stop_reason) &&
 		    (BSS_STOP_DUE_TO_VENDOR_CONFIG_CHAN !=
@@ -3579,6 +3581,13 @@ struct hdd_adapter *hdd_wlan_create_ap_dev(struct hdd_context *hdd_ctx,
 
 	qdf_atomic_init(&adapter->ch_switch_in_progress);
 
+	qdf_status = wlan_hdd_queue_history_alloc(adapter);
+	if (QDF_IS_STATUS_ERROR(qdf_status)) {
+		hdd_err("failed to allocate netif queue history");
+		free_netdev(adapter->dev);
+		return NULL;
+	}
+
 	return adapter;
 }
 
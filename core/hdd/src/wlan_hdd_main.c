@@ -172,6 +172,7 @@
 #include <target_type.h>
 #include <wlan_hdd_debugfs_coex.h>
 #include <wlan_hdd_debugfs_config.h>
+#include <wlan_hdd_debugfs_startup.h>
 #include "wlan_blm_ucfg_api.h"
 #include "nan_ucfg_api.h"
 #include "wlan_osif_priv.h"
@@ -374,6 +375,9 @@ static void hdd_set_rps_cpu_mask(struct hdd_context *hdd_ctx)
 
 	hdd_for_each_adapter(hdd_ctx, adapter)
 		hdd_send_rps_ind(adapter);
+
+	if (hdd_ctx->dynamic_rps)
+		hdd_rps_steer_start(hdd_ctx);
 }
 
 #ifdef QCA_HL_NETDEV_FLOW_CONTROL
@@ -2735,6 +2739,7 @@ int hdd_start_adapter(struct hdd_adapter *adapter)
 	}
 
 	wlan_hdd_update_dbs_scan_and_fw_mode_config();
+	hdd_ll_stats_stream_start(adapter);
 
 exit_with_success:
 	hdd_exit();
@@ -3461,6 +3466,150 @@ out:
 	return ret;
 }
 
+/**
+ * hdd_startup_stage_record() - record the duration of a startup stage
+ * @hdd_ctx: HDD context
+ * @stage: stage which completed
+ * @duration_us: time spent in @stage
+ *
+ * Return: None
+ */
+static void hdd_startup_stage_record(struct hdd_context *hdd_ctx,
+				     enum hdd_startup_stage stage,
+				     uint32_t duration_us)
+{
+	struct hdd_startup_profile *profile = &hdd_ctx->startup_profile;
+
+	profile->stage_us[stage] = duration_us;
+	if (duration_us > profile->max_stage_us[stage])
+		profile->max_stage_us[stage] = duration_us;
+
+	qdf_mtrace(QDF_MODULE_ID_HDD, QDF_MODULE_ID_HDD,
+		   TRACE_CODE_HDD_STARTUP_STAGE, stage, duration_us);
+}
+
+/**
+ * hdd_startup_stage_done() - mark the end of a sequential startup stage
+ * @hdd_ctx: HDD context
+ * @stage: stage which completed
+ *
+ * The stage is accounted the time since the previous sequential stage
+ * ended, or since the start began for the first one.
+ *
+ * Return: None
+ */
+static void hdd_startup_stage_done(struct hdd_context *hdd_ctx,
+				   enum hdd_startup_stage stage)
+{
+	struct hdd_startup_profile *profile = &hdd_ctx->startup_profile;
+	uint64_t now_us = qdf_get_log_timestamp_usecs();
+
+	hdd_startup_stage_record(hdd_ctx, stage, now_us - profile->mark_us);
+	profile->mark_us = now_us;
+}
+
+/**
+ * hdd_startup_profile_begin() - start profiling hdd_wlan_start_modules()
+ * @hdd_ctx: HDD context
+ *
+ * Return: None
+ */
+static void hdd_startup_profile_begin(struct hdd_context *hdd_ctx)
+{
+	struct hdd_startup_profile *profile = &hdd_ctx->startup_profile;
+
+	qdf_mem_zero(profile->stage_us, sizeof(profile->stage_us));
+	profile->start_us = qdf_get_log_timestamp_usecs();
+	profile->mark_us = profile->start_us;
+}
+
+/**
+ * hdd_startup_profile_end() - finish profiling hdd_wlan_start_modules()
+ * @hdd_ctx: HDD context
+ * @ret: result of the start
+ *
+ * Return: None
+ */
+static void hdd_startup_profile_end(struct hdd_context *hdd_ctx, int ret)
+{
+	struct hdd_startup_profile *profile = &hdd_ctx->startup_profile;
+
+	if (ret) {
+		profile->fail_count++;
+		return;
+	}
+
+	profile->total_us = qdf_get_log_timestamp_usecs() - profile->start_us;
+	if (profile->total_us > profile->max_total_us)
+		profile->max_total_us = profile->total_us;
+	profile->count++;
+
+	hdd_info("Modules started in %u us (cds open %u us, configure %u us, ini parse %u us, mac parse %u us)",
+		 profile->total_us,
+		 profile->stage_us[HDD_STARTUP_CDS_OPEN],
+		 profile->stage_us[HDD_STARTUP_CONFIGURE_CDS],
+		 profile->ini_parse_us, profile->mac_parse_us);
+}
+
+/**
+ * hdd_startup_wbuff_init_work() - preallocate wbuff pools off the start path
+ * @arg: HDD context
+ *
+ * Return: None
+ */
+static void hdd_startup_wbuff_init_work(void *arg)
+{
+	struct hdd_context *hdd_ctx = arg;
+	struct hdd_startup_profile *profile = &hdd_ctx->startup_profile;
+	uint64_t start_us = qdf_get_log_timestamp_usecs();
+
+	profile->async_status = wbuff_module_init();
+	hdd_startup_stage_record(hdd_ctx, HDD_STARTUP_WBUFF_INIT,
+				 qdf_get_log_timestamp_usecs() - start_us);
+}
+
+/**
+ * hdd_startup_async_start() - kick the wbuff preallocation
+ * @hdd_ctx: HDD context
+ *
+ * The wbuff pools only depend on the QDF layer, they are first used when
+ * WMI is attached from cds_open(). Allocating them is overlapped with the
+ * host side component open and configuration.
+ *
+ * Return: None
+ */
+static void hdd_startup_async_start(struct hdd_context *hdd_ctx)
+{
+	struct hdd_startup_profile *profile = &hdd_ctx->startup_profile;
+
+	qdf_create_work(0, &profile->async_work, hdd_startup_wbuff_init_work,
+			hdd_ctx);
+	profile->async_pending = true;
+	qdf_sched_work(0, &profile->async_work);
+}
+
+/**
+ * hdd_startup_async_join() - wait for the wbuff preallocation
+ * @hdd_ctx: HDD context
+ *
+ * Return: None
+ */
+static void hdd_startup_async_join(struct hdd_context *hdd_ctx)
+{
+	struct hdd_startup_profile *profile = &hdd_ctx->startup_profile;
+
+	if (!profile->async_pending)
+		return;
+
+	qdf_flush_work(&profile->async_work);
+	qdf_destroy_work(0, &profile->async_work);
+	profile->async_pending = false;
+
+	if (QDF_IS_STATUS_ERROR(profile->async_status))
+		hdd_err("WBUFF init unsuccessful; status: %d",
+			profile->async_status);
+}
+
 int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 {
 	int ret = 0;
@@ -3493,6 +3642,7 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 		hdd_nofl_debug("Wlan transitioning (CLOSED -> ENABLED)");
 
 		hdd_debug_domain_set(QDF_DEBUG_DOMAIN_ACTIVE);
+		hdd_startup_profile_begin(hdd_ctx);
 
 		if (!reinit && !unint) {
 			ret = pld_power_on(qdf_dev->dev);
@@ -3502,6 +3652,7 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 				goto release_lock;
 			}
 		}
+		hdd_startup_stage_done(hdd_ctx, HDD_STARTUP_POWER_ON);
 
 		hdd_bus_bandwidth_init(hdd_ctx);
 		pld_set_fw_log_mode(hdd_ctx->parent_dev,
@@ -3521,6 +3672,7 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 			ret = -EINVAL;
 			goto power_down;
 		}
+		hdd_startup_stage_done(hdd_ctx, HDD_STARTUP_HIF_OPEN);
 
 		status = ol_cds_init(qdf_dev, hif_ctx);
 		if (status != QDF_STATUS_SUCCESS) {
@@ -3529,6 +3681,7 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 			ret = qdf_status_to_os_return(status);
 			goto hif_close;
 		}
+		hdd_startup_stage_done(hdd_ctx, HDD_STARTUP_BMI_INIT);
 
 		if (hdd_get_conparam() == QDF_GLOBAL_EPPING_MODE) {
 			status = epping_open();
@@ -3551,6 +3704,8 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 			break;
 		}
 
+		hdd_startup_async_start(hdd_ctx);
+
 		ucfg_ipa_component_config_update(hdd_ctx->psoc);
 
 		hdd_update_cds_ac_specs_params(hdd_ctx);
@@ -3562,6 +3717,7 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 			ret = qdf_status_to_os_return(status);
 			goto cds_free;
 		}
+		hdd_startup_stage_done(hdd_ctx, HDD_STARTUP_PSOC_OPEN);
 
 		ret = hdd_update_config(hdd_ctx);
 		if (ret) {
@@ -3569,10 +3725,10 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 				ret);
 			goto cds_free;
 		}
+		hdd_startup_stage_done(hdd_ctx, HDD_STARTUP_CONFIG);
 
-		status = wbuff_module_init();
-		if (QDF_IS_STATUS_ERROR(status))
-			hdd_err("WBUFF init unsuccessful; status: %d", status);
+		/* WMI attach in cds_open allocates from the wbuff pools */
+		hdd_startup_async_join(hdd_ctx);
 
 		status = cds_open(hdd_ctx->psoc);
 		if (QDF_IS_STATUS_ERROR(status)) {
@@ -3580,6 +3736,7 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 			ret = qdf_status_to_os_return(status);
 			goto psoc_close;
 		}
+		hdd_startup_stage_done(hdd_ctx, HDD_STARTUP_CDS_OPEN);
 
 		hdd_ctx->mac_handle = cds_get_context(QDF_MODULE_ID_SME);
 
@@ -3598,6 +3755,7 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 				ret);
 			goto close;
 		}
+		hdd_startup_stage_done(hdd_ctx, HDD_STARTUP_COMPONENT_CONFIG);
 
 		status = cds_dp_open(hdd_ctx->psoc);
 		if (!QDF_IS_STATUS_SUCCESS(status)) {
@@ -3606,6 +3764,7 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 			ret = qdf_status_to_os_return(status);
 			goto close;
 		}
+		hdd_startup_stage_done(hdd_ctx, HDD_STARTUP_DP_OPEN);
 
 		ret = hdd_register_cb(hdd_ctx);
 		if (ret) {
@@ -3623,6 +3782,7 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 		 * register HDD callbacks with UMAC's NAN componenet.
 		 */
 		hdd_nan_register_callbacks(hdd_ctx);
+		hdd_startup_stage_done(hdd_ctx, HDD_STARTUP_REGISTER);
 
 		status = cds_pre_enable();
 		if (!QDF_IS_STATUS_SUCCESS(status)) {
@@ -3630,6 +3790,7 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 			ret = qdf_status_to_os_return(status);
 			goto unregister_notifiers;
 		}
+		hdd_startup_stage_done(hdd_ctx, HDD_STARTUP_PRE_ENABLE);
 
 		hdd_register_policy_manager_callback(
 			hdd_ctx->psoc);
@@ -3653,6 +3814,7 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 			hdd_err("Failed to Enable cds modules; errno: %d", ret);
 			goto destroy_driver_sysfs;
 		}
+		hdd_startup_stage_done(hdd_ctx, HDD_STARTUP_CONFIGURE_CDS);
 
 		hdd_enable_power_management(hdd_ctx);
 
@@ -3669,6 +3831,7 @@ int hdd_wlan_start_modules(struct hdd_context *hdd_ctx, bool reinit)
 		goto release_lock;
 	}
 
+	hdd_startup_profile_end(hdd_ctx, 0);
 	hdd_ctx->driver_status = DRIVER_MODULES_ENABLED;
 	hdd_nofl_debug("Wlan transitioned (now ENABLED)");
 
@@ -3713,6 +3876,7 @@ psoc_close:
 	cds_deinit_ini_config();
 
 cds_free:
+	hdd_startup_async_join(hdd_ctx);
 	ol_cds_free();
 
 hif_close:
@@ -3728,6 +3892,7 @@ release_lock:
 		hdd_ctx->target_hw_name = NULL;
 	}
 
+	hdd_startup_profile_end(hdd_ctx, ret);
 	hdd_check_for_leaks(hdd_ctx, reinit);
 	hdd_debug_domain_set(QDF_DEBUG_DOMAIN_INIT);
 
@@ -4636,6 +4801,10 @@ hdd_alloc_station_adapter(struct hdd_context *hdd_ctx, tSirMacAddr mac_addr,
 	adapter->start_time = qdf_system_ticks();
 	adapter->last_time = adapter->start_time;
 
+	qdf_status = wlan_hdd_queue_history_alloc(adapter);
+	if (QDF_IS_STATUS_ERROR(qdf_status))
+		goto free_net_dev;
+
 	return adapter;
 
 free_net_dev:
@@ -5275,6 +5444,7 @@ static void hdd_cleanup_adapter(struct hdd_context *hdd_ctx,
 				bool rtnl_held)
 {
 	struct net_device *dev = NULL;
+	struct hdd_netif_queue_history_ring *queue_history;
 
 	if (adapter)
 		dev = adapter->dev;
@@ -5307,6 +5477,7 @@ static void hdd_cleanup_adapter(struct hdd_context *hdd_ctx,
 	clear_bit(DEVICE_IFACE_OPENED, &adapter->event_flags);
 
 	if (test_bit(NET_DEVICE_REGISTERED, &adapter->event_flags)) {
+		queue_history = adapter->queue_oper_history;
 		if (rtnl_held)
 			unregister_netdevice(dev);
 		else
@@ -5315,6 +5486,7 @@ static void hdd_cleanup_adapter(struct hdd_context *hdd_ctx,
 		 * Note that the adapter is no longer valid at this point
 		 * since the memory has been reclaimed
 		 */
+		wlan_hdd_queue_history_free(queue_history);
 	}
 }
 
@@ -6010,6 +6182,8 @@ struct hdd_adapter *hdd_open_adapter(struct hdd_context *hdd_ctx, uint8_t sessio
 	INIT_WORK(&adapter->scan_block_work, wlan_hdd_cfg80211_scan_block_cb);
 	INIT_WORK(&adapter->sap_stop_bss_work,
 		  hdd_stop_sap_due_to_invalid_channel);
+	hdd_stats_cache_init(adapter);
+	hdd_ll_stats_stream_init(adapter);
 	qdf_list_create(&adapter->blocked_scan_request_q, WLAN_MAX_SCAN_COUNT);
 	qdf_mutex_create(&adapter->blocked_scan_request_q_lock);
 	qdf_event_create(&adapter->acs_complete_event);
@@ -6059,6 +6233,7 @@ struct hdd_adapter *hdd_open_adapter(struct hdd_context *hdd_ctx, uint8_t sessio
 
 err_free_netdev:
 	wlan_hdd_release_intf_addr(hdd_ctx, adapter->mac_addr.bytes);
+	wlan_hdd_queue_history_free(adapter->queue_oper_history);
 
 	if (ndev)
 		free_netdev(ndev);
@@ -6072,6 +6247,7 @@ static void __hdd_close_adapter(struct hdd_context *hdd_ctx,
 {
 	qdf_list_destroy(&adapter->blocked_scan_request_q);
 	qdf_mutex_destroy(&adapter->blocked_scan_request_q_lock);
+	hdd_ll_stats_stream_deinit(adapter);
 	policy_mgr_clear_concurrency_mode(hdd_ctx->psoc, adapter->device_mode);
 	qdf_event_destroy(&adapter->acs_complete_event);
 	qdf_event_destroy(&adapter->peer_cleanup_done);
@@ -6238,6 +6414,8 @@ QDF_STATUS hdd_stop_adapter(struct hdd_context *hdd_ctx,
 	hdd_nud_ignore_tracking(adapter, true);
 	hdd_nud_reset_tracking(adapter);
 	hdd_nud_flush_work(adapter);
+	hdd_stats_cache_flush(adapter);
+	hdd_ll_stats_stream_stop(adapter);
 	hdd_stop_tsf_sync(adapter);
 
 	hdd_debug("Disabling queues");
@@ -6752,6 +6930,7 @@ QDF_STATUS hdd_reset_all_adapters(struct hdd_context *hdd_ctx)
 		hdd_nud_ignore_tracking(adapter, true);
 		hdd_nud_reset_tracking(adapter);
 		hdd_nud_flush_work(adapter);
+		hdd_ll_stats_stream_stop(adapter);
 
 		if (adapter->device_mode != QDF_SAP_MODE &&
 		    adapter->device_mode != QDF_P2P_GO_MODE &&
@@ -7594,6 +7773,7 @@ QDF_STATUS hdd_start_all_adapters(struct hdd_context *hdd_ctx)
 		default:
 			break;
 		}
+		hdd_ll_stats_stream_start(adapter);
 		/*
 		 * Action frame registered in one adapter which will
 		 * applicable to all interfaces
@@ -8216,8 +8396,10 @@ void hdd_context_destroy(struct hdd_context *hdd_ctx)
 	qdf_mem_free(hdd_ctx->config);
 	hdd_ctx->config = NULL;
 	cfg_release();
+	ol_fw_cache_flush();
 
 	qdf_delayed_work_destroy(&hdd_ctx->psoc_idle_timeout_work);
+	hdd_rx_ol_deinit(hdd_ctx);
 	wiphy_free(hdd_ctx->wiphy);
 }
 
@@ -8258,6 +8440,7 @@ void hdd_wlan_exit(struct hdd_context *hdd_ctx)
 
 	hdd_enter();
 
+	hdd_debugfs_startup_profile_deinit(hdd_ctx);
 	hdd_debugfs_ini_config_deinit(hdd_ctx);
 	hdd_debugfs_mws_coex_info_deinit(hdd_ctx);
 	hdd_psoc_idle_timer_stop(hdd_ctx);
@@ -8598,6 +8781,8 @@ static void hdd_clear_rps_cpu_mask(struct hdd_context *hdd_ctx)
 {
 	struct hdd_adapter *adapter;
 
+	hdd_rps_steer_stop(hdd_ctx);
+
 	hdd_for_each_adapter(hdd_ctx, adapter)
 		hdd_send_rps_disable_ind(adapter);
 }
@@ -9106,6 +9291,9 @@ static void __hdd_bus_bw_work_handler(struct hdd_context *hdd_ctx)
 
 	hdd_pld_request_bus_bandwidth(hdd_ctx, tx_packets, rx_packets);
 
+	if (hdd_ctx->dynamic_rps)
+		hdd_rps_steer_update(hdd_ctx);
+
 	return;
 
 stop_work:
@@ -9132,6 +9320,7 @@ int hdd_bus_bandwidth_init(struct hdd_context *hdd_ctx)
 	hdd_enter();
 
 	qdf_spinlock_create(&hdd_ctx->bus_bw_lock);
+	hdd_rps_steer_init(hdd_ctx);
 	hdd_pm_qos_add_request(hdd_ctx);
 	status = qdf_periodic_work_create(&hdd_ctx->bus_bw_work,
 					  hdd_bus_bw_work_handler,
@@ -9153,6 +9342,7 @@ void hdd_bus_bandwidth_deinit(struct hdd_context *hdd_ctx)
 
 	qdf_periodic_work_destroy(&hdd_ctx->bus_bw_work);
 	hdd_pm_qos_remove_request(hdd_ctx);
+	hdd_rps_steer_deinit(hdd_ctx);
 	qdf_spinlock_destroy(&hdd_ctx->bus_bw_lock);
 
 	hdd_exit();
@@ -9347,7 +9537,8 @@ wlan_hdd_display_adapter_netif_queue_stats(struct hdd_adapter *adapter)
 {
 	int i;
 	qdf_time_t total, pause, unpause, curr_time, delta;
-	struct hdd_netif_queue_history *q_hist_ptr;
+	struct hdd_netif_queue_history *q_hist, *q_hist_ptr;
+	uint32_t max_entries, num_entries;
 	char q_status_buf[NUM_TX_QUEUES * HDD_NETDEV_TX_Q_STATE_STRLEN] = {0};
 
 	hdd_nofl_debug("Netif queue operation statistics:");
@@ -9387,35 +9578,36 @@ wlan_hdd_display_adapter_netif_queue_stats(struct hdd_adapter *adapter)
 			       total_pause_time + pause_delta));
 	}
 
-	hdd_nofl_debug("Netif queue operation history: Total entries: %d current index %d(-1) time %u",
-		       WLAN_HDD_MAX_HISTORY_ENTRY,
-		       adapter->history_index,
-		       qdf_system_ticks_to_msecs(qdf_system_ticks()));
+	max_entries = nr_cpu_ids * WLAN_HDD_MAX_HISTORY_ENTRY;
+	q_hist = qdf_mem_malloc(max_entries * sizeof(*q_hist));
+	if (!q_hist)
+		return;
+
+	num_entries = wlan_hdd_get_queue_history(adapter, q_hist, max_entries);
 
-	hdd_nofl_debug("%2s%20s%50s%30s%10s  %s",
-		       "#", "time(ms)", "action_type", "reason_type",
+	hdd_nofl_debug("Netif queue operation history: Total entries: %u time %llu",
+		       num_entries, qdf_get_log_timestamp_usecs());
+
+	hdd_nofl_debug("%3s%4s%20s%50s%30s%10s  %s",
+		       "#", "cpu", "time(us)", "action_type", "reason_type",
 		       "pause_map", "netdev-queue-status");
 
-	for (i = 0; i < WLAN_HDD_MAX_HISTORY_ENTRY; i++) {
-		/* using hdd_log to avoid printing function name */
-		if (adapter->queue_oper_history[i].time == 0)
-			continue;
-		q_hist_ptr = &adapter->queue_oper_history[i];
+	for (i = 0; i < num_entries; i++) {
+		q_hist_ptr = &q_hist[i];
 		wlan_hdd_dump_queue_history_state(q_hist_ptr,
 						  q_status_buf,
 						  sizeof(q_status_buf));
-		hdd_nofl_debug("%2d%20u%50s%30s%10x  %s",
-			       i, qdf_system_ticks_to_msecs(
-				adapter->queue_oper_history[i].time),
-				   hdd_action_type_to_string(
-				adapter->queue_oper_history[i].
-					netif_action),
-				   hdd_reason_type_to_string(
-				adapter->queue_oper_history[i].
-					netif_reason),
-				   adapter->queue_oper_history[i].pause_map,
-				   q_status_buf);
+		/* using hdd_log to avoid printing function name */
+		hdd_nofl_debug("%3d%4u%20llu%50s%30s%10x  %s",
+			       i, q_hist_ptr->cpu, q_hist_ptr->time,
+			       hdd_action_type_to_string(
+					q_hist_ptr->netif_action),
+			       hdd_reason_type_to_string(
+					q_hist_ptr->netif_reason),
+			       q_hist_ptr->pause_map, q_status_buf);
 	}
+
+	qdf_mem_free(q_hist);
 }
 
 void
@@ -9465,9 +9657,9 @@ void wlan_hdd_clear_netif_queue_history(struct hdd_context *hdd_ctx)
 	hdd_for_each_adapter(hdd_ctx, adapter) {
 		qdf_mem_zero(adapter->queue_oper_stats,
 					sizeof(adapter->queue_oper_stats));
-		qdf_mem_zero(adapter->queue_oper_history,
-					sizeof(adapter->queue_oper_history));
-		adapter->history_index = 0;
+		/* writers own their rings, so only hide the older entries */
+		WRITE_ONCE(adapter->history_clear_time,
+			   qdf_get_log_timestamp_usecs());
 		adapter->start_time = adapter->last_time = qdf_system_ticks();
 		adapter->total_pause_time = 0;
 		adapter->total_unpause_time = 0;
@@ -10735,6 +10927,9 @@ static void hdd_cfg_params_init(struct hdd_context *hdd_ctx)
 	config->disable_channel = cfg_get(psoc, CFG_ENABLE_DISABLE_CHANNEL);
 	config->enable_sar_conversion = cfg_get(psoc, CFG_SAR_CONVERSION);
 	config->is_wow_disabled = cfg_get(psoc, CFG_WOW_DISABLE);
+	config->sta_stats_cache_age = cfg_get(psoc, CFG_STA_STATS_CACHE_AGE);
+	config->ll_stats_stream_interval =
+				cfg_get(psoc, CFG_LL_STATS_STREAM_INTERVAL);
 	config->nb_commands_interval =
 				cfg_get(psoc, CFG_NB_COMMANDS_RATE_LIMIT);
 
@@ -10755,6 +10950,7 @@ struct hdd_context *hdd_context_create(struct device *dev)
 	QDF_STATUS status;
 	int ret = 0;
 	struct hdd_context *hdd_ctx;
+	uint64_t parse_start_us;
 
 	hdd_enter();
 
@@ -10781,6 +10977,12 @@ struct hdd_context *hdd_context_create(struct device *dev)
 		goto err_free_hdd_context;
 	}
 
+	/*
+	 * The INI is parsed into the cfg store of the cfg component, which
+	 * owns its format, so only the time spent here is reported. The
+	 * store outlives idle restarts, the INI is parsed once per context.
+	 */
+	parse_start_us = qdf_get_log_timestamp_usecs();
 	status = cfg_parse(WLAN_INI_FILE);
 	if (QDF_IS_STATUS_ERROR(status)) {
 		hdd_err("Failed to parse cfg %s; status:%d\n",
@@ -10788,6 +10990,8 @@ struct hdd_context *hdd_context_create(struct device *dev)
 		ret = qdf_status_to_os_return(status);
 		goto err_free_config;
 	}
+	hdd_ctx->startup_profile.ini_parse_us =
+		qdf_get_log_timestamp_usecs() - parse_start_us;
 
 	ret = hdd_objmgr_create_and_store_psoc(hdd_ctx, DEFAULT_PSOC_ID);
 	if (ret) {
@@ -13221,6 +13425,7 @@ int hdd_wlan_startup(struct hdd_context *hdd_ctx)
 	hdd_set_idle_ps_config(hdd_ctx, is_imps_enabled);
 	hdd_debugfs_mws_coex_info_init(hdd_ctx);
 	hdd_debugfs_ini_config_init(hdd_ctx);
+	hdd_debugfs_startup_profile_init(hdd_ctx);
 	wlan_cfg80211_init_interop_issues_ap(hdd_ctx->pdev);
 
 	hdd_exit();
@@ -13711,6 +13916,9 @@ void wlan_hdd_send_svc_nlink_msg(int radio, int type, void *data, int len)
 	case WLAN_SVC_WLAN_TP_TX_IND:
 	case WLAN_SVC_RPS_ENABLE_IND:
 	case WLAN_SVC_CORE_MINFREQ:
+#ifdef WLAN_SVC_LL_STATS_STREAM_IND
+	case WLAN_SVC_LL_STATS_STREAM_IND:
+#endif
 		ani_hdr->length = len;
 		nlh->nlmsg_len = NLMSG_LENGTH((sizeof(tAniMsgHdr) + len));
 		nl_data = (char *)ani_hdr + sizeof(tAniMsgHdr);
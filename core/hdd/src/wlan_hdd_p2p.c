@@ -1033,10 +1033,12 @@ __hdd_indicate_mgmt_frame_to_user(struct hdd_adapter *adapter,
 		freq = ieee80211_channel_to_frequency(rx_chan,
 						      NL80211_BAND_5GHZ);
 
-	if (hdd_is_qos_action_frame(pb_frames, frm_len))
+	if (hdd_is_qos_action_frame(pb_frames, frm_len)) {
 		sme_update_dsc_pto_up_mapping(hdd_ctx->mac_handle,
 					      adapter->dscp_to_up_map,
 					      adapter->vdev_id);
+		hdd_wmm_update_dscp_queue_map(adapter);
+	}
 
 	/* Indicate Frame Over Normal Interface */
 	hdd_debug("Indicate Frame over NL80211 sessionid : %d, idx :%d",
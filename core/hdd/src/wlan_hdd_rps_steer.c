@@ -0,0 +1,633 @@
+/*
+ * Copyright (c) 2020 The Linux Foundation. All rights reserved.
+ *
+ * Permission to use, copy, modify, and/or distribute this software for
+ * any purpose with or without fee is hereby granted, provided that the
+ * above copyright notice and this permission notice appear in all
+ * copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ * WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ * AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ * DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ * PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ * TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/**
+ * DOC: wlan_hdd_rps_steer.c
+ *
+ * Flow aware RPS steering
+ *
+ * RPS picks the CPU of a packet as map->cpus[reciprocal_scale(hash, len)],
+ * where map is the RPS map installed on the rx queue of the net device.
+ * The flows are steered by choosing the hash of their packets so that this
+ * lookup lands on the CPU assigned to the flow. The CPUs are assigned
+ * against a snapshot of the installed map and every packet checks the hash
+ * against the live map, so a map changed by user space is never trusted.
+ *
+ * The RX path does not take the steering lock, it only uses atomics on the
+ * flow table entries; the lock serializes the periodic update against
+ * start, stop and debugfs.
+ */
+
+#include <linux/arch_topology.h>
+#include "wlan_hdd_main.h"
+#include "wlan_hdd_rps_steer.h"
+
+/* Intervals without traffic after which a flow is forgotten */
+#define HDD_RPS_STEER_IDLE_INTERVALS	10
+
+/**
+ * hdd_rps_steer_reset_flow() - Free a flow table entry
+ * @flow: flow table entry
+ *
+ * Return: none
+ */
+static void hdd_rps_steer_reset_flow(struct hdd_rps_steer_flow *flow)
+{
+	qdf_atomic_set(&flow->steer_hash, 0);
+	qdf_atomic_set(&flow->bytes, 0);
+	flow->rate = 0;
+	flow->cpu = HDD_RPS_STEER_CPU_NONE;
+	flow->idle_cnt = 0;
+	flow->heavy = false;
+	qdf_atomic_set(&flow->flow_id, 0);
+}
+
+#ifdef CONFIG_RPS
+/**
+ * hdd_rps_steer_get_map() - Get the RPS map installed on an rx queue
+ * @dev: net device
+ * @queue: rx queue index
+ *
+ * Must be called under rcu_read_lock().
+ *
+ * Return: installed RPS map, NULL if there is none
+ */
+static struct rps_map *hdd_rps_steer_get_map(struct net_device *dev,
+					     uint16_t queue)
+{
+	if (queue >= dev->real_num_rx_queues)
+		return NULL;
+
+	return rcu_dereference(dev->_rx[queue].rps_map);
+}
+
+/**
+ * hdd_rps_steer_refresh_map() - Snapshot the RPS map installed by user space
+ * @hdd_ctx: HDD context
+ *
+ * The map of rx queue 0 of the first adapter which has one is used, flows
+ * of adapters with a different map fail the check in the RX path and are
+ * left to plain RPS.
+ *
+ * Return: none
+ */
+static void hdd_rps_steer_refresh_map(struct hdd_context *hdd_ctx)
+{
+	struct hdd_rps_steer *steer = &hdd_ctx->rps_steer;
+	struct hdd_adapter *adapter;
+	struct rps_map *map;
+	uint8_t i;
+
+	steer->map_len = 0;
+
+	rcu_read_lock();
+	hdd_for_each_adapter(hdd_ctx, adapter) {
+		if (!adapter->dev)
+			continue;
+
+		map = hdd_rps_steer_get_map(adapter->dev, 0);
+		if (!map)
+			continue;
+
+		/* CPUs beyond the fixed tables and CPU masks are not steered */
+		if (map->len > HDD_RPS_STEER_MAX_CPUS)
+			break;
+
+		for (i = 0; i < map->len; i++) {
+			if (map->cpus[i] >= HDD_RPS_STEER_MAX_CPUS)
+				break;
+			steer->map_cpus[i] = map->cpus[i];
+		}
+		if (i == map->len)
+			steer->map_len = map->len;
+		break;
+	}
+	rcu_read_unlock();
+}
+
+/**
+ * hdd_rps_steer_hash_valid() - Check a steering hash against the live map
+ * @skb: received packet, after eth_type_trans()
+ * @hash: steering hash of the flow
+ * @cpu: CPU the flow is steered to
+ *
+ * Return: true if RPS resolves @hash to @cpu for @skb
+ */
+static bool hdd_rps_steer_hash_valid(struct sk_buff *skb, uint32_t hash,
+				     uint8_t cpu)
+{
+	struct rps_map *map;
+	uint16_t queue;
+	bool valid = false;
+
+	queue = skb_rx_queue_recorded(skb) ? skb_get_rx_queue(skb) : 0;
+
+	rcu_read_lock();
+	map = hdd_rps_steer_get_map(skb->dev, queue);
+	if (map)
+		valid = map->cpus[reciprocal_scale(hash, map->len)] == cpu;
+	rcu_read_unlock();
+
+	return valid;
+}
+#else
+static void hdd_rps_steer_refresh_map(struct hdd_context *hdd_ctx)
+{
+	hdd_ctx->rps_steer.map_len = 0;
+}
+
+static bool hdd_rps_steer_hash_valid(struct sk_buff *skb, uint32_t hash,
+				     uint8_t cpu)
+{
+	return false;
+}
+#endif /* CONFIG_RPS */
+
+#ifdef CONFIG_GENERIC_ARCH_TOPOLOGY
+/**
+ * hdd_rps_steer_cpu_capacity() - Get the compute capacity of a CPU
+ * @cpu: CPU
+ *
+ * Return: capacity of @cpu relative to SCHED_CAPACITY_SCALE
+ */
+static unsigned long hdd_rps_steer_cpu_capacity(uint8_t cpu)
+{
+#if (LINUX_VERSION_CODE >= KERNEL_VERSION(5, 4, 0))
+	return topology_get_cpu_scale(cpu);
+#else
+	return topology_get_cpu_scale(NULL, cpu);
+#endif
+}
+#else
+static unsigned long hdd_rps_steer_cpu_capacity(uint8_t cpu)
+{
+	return SCHED_CAPACITY_SCALE;
+}
+#endif /* CONFIG_GENERIC_ARCH_TOPOLOGY */
+
+/**
+ * hdd_rps_steer_big_mask() - Get the CPU mask of the big cores of the map
+ * @hdd_ctx: HDD context
+ *
+ * The mask comes from the gRpsSteerBigCpuMask ini if set, otherwise the
+ * CPUs of the RPS map with the highest capacity are the big cores; all of
+ * them when the CPUs are symmetric.
+ *
+ * Return: CPU mask of the big cores
+ */
+static uint32_t hdd_rps_steer_big_mask(struct hdd_context *hdd_ctx)
+{
+	struct hdd_rps_steer *steer = &hdd_ctx->rps_steer;
+	unsigned long capacity, max_capacity = 0;
+	uint32_t big_mask = 0;
+	uint8_t idx;
+
+	if (hdd_ctx->config->rps_steer_big_cpu_mask)
+		return hdd_ctx->config->rps_steer_big_cpu_mask;
+
+	for (idx = 0; idx < steer->map_len; idx++) {
+		capacity = hdd_rps_steer_cpu_capacity(steer->map_cpus[idx]);
+		if (capacity > max_capacity) {
+			max_capacity = capacity;
+			big_mask = 0;
+		}
+		if (capacity == max_capacity)
+			big_mask |= BIT(steer->map_cpus[idx]);
+	}
+
+	return big_mask;
+}
+
+/**
+ * hdd_rps_steer_map_idx() - Get the index of a CPU in the RPS map
+ * @steer: RPS steering context
+ * @cpu: CPU to look for
+ *
+ * Return: index in the RPS map, -1 if @cpu is not part of it
+ */
+static int hdd_rps_steer_map_idx(struct hdd_rps_steer *steer, uint8_t cpu)
+{
+	int idx;
+
+	for (idx = 0; idx < steer->map_len; idx++) {
+		if (steer->map_cpus[idx] == cpu)
+			return idx;
+	}
+
+	return -1;
+}
+
+/**
+ * hdd_rps_steer_hash() - Get a hash of a flow which RPS maps to a map index
+ * @idx: index in the RPS map
+ * @map_len: number of CPUs in the RPS map
+ * @flow_id: flow id computed by the target
+ *
+ * The hashes RPS maps to @idx are [ceil(idx * 2^32 / len),
+ * ceil((idx + 1) * 2^32 / len)). The flow id is folded into this range, so
+ * that flows steered to the same CPU still get distinct hashes for GRO and
+ * RFS.
+ *
+ * Return: hash which selects the CPU at @idx
+ */
+static uint32_t hdd_rps_steer_hash(int idx, uint8_t map_len, uint32_t flow_id)
+{
+	uint64_t first = ((uint64_t)idx << 32) + map_len - 1;
+	uint64_t last = ((uint64_t)(idx + 1) << 32) + map_len - 1;
+	uint64_t span;
+	uint32_t hash;
+
+	first = qdf_do_div(first, map_len);
+	last = qdf_do_div(last, map_len);
+	span = last - first;
+
+	/* span is 2^32 only for a single CPU map, where no folding is needed */
+	if (flow_id >= span)
+		flow_id = qdf_do_div_rem(flow_id, (uint32_t)span);
+	hash = (uint32_t)first + flow_id;
+
+	/* RPS ignores packets without a hash */
+	return hash ? hash : 1;
+}
+
+/**
+ * hdd_rps_steer_pick_heavy() - Pick the heaviest flow not picked yet
+ * @steer: RPS steering context
+ * @picked: flows picked so far, indexed like the flow table
+ * @thres: minimum rate of a heavy flow in bytes per second
+ *
+ * Return: index of the flow, -1 if no flow is above @thres
+ */
+static int hdd_rps_steer_pick_heavy(struct hdd_rps_steer *steer,
+				    bool *picked, uint64_t thres)
+{
+	struct hdd_rps_steer_flow *flow;
+	uint64_t max_rate = 0;
+	int i, heaviest = -1;
+
+	for (i = 0; i < HDD_RPS_STEER_TABLE_SIZE; i++) {
+		flow = &steer->flows[i];
+		if (!qdf_atomic_read(&flow->flow_id) || picked[i] ||
+		    flow->rate < thres)
+			continue;
+
+		if (flow->rate > max_rate) {
+			max_rate = flow->rate;
+			heaviest = i;
+		}
+	}
+
+	return heaviest;
+}
+
+/**
+ * hdd_rps_steer_assign() - Assign a flow to the CPU at a map index
+ * @steer: RPS steering context
+ * @flow: flow to assign
+ * @idx: index in the RPS map, -1 to leave the flow to plain RPS
+ *
+ * Return: none
+ */
+static void hdd_rps_steer_assign(struct hdd_rps_steer *steer,
+				 struct hdd_rps_steer_flow *flow, int idx)
+{
+	if (idx < 0) {
+		WRITE_ONCE(flow->cpu, HDD_RPS_STEER_CPU_NONE);
+		qdf_atomic_set(&flow->steer_hash, 0);
+		return;
+	}
+
+	WRITE_ONCE(flow->cpu, steer->map_cpus[idx]);
+	qdf_atomic_set(&flow->steer_hash,
+		       hdd_rps_steer_hash(idx, steer->map_len,
+					  qdf_atomic_read(&flow->flow_id)));
+}
+
+/**
+ * hdd_rps_steer_least_loaded() - Find the least loaded CPU for a mice flow
+ * @steer: RPS steering context
+ * @big_mask: CPU mask of the big cores
+ * @owned: map indexes owned by a heavy flow
+ * @load: rate of the flows assigned to each map index
+ *
+ * Little cores are preferred, the big cores which are not owned by a heavy
+ * flow are only used when the RPS map has no little core.
+ *
+ * Return: map index, -1 if no CPU is available
+ */
+static int hdd_rps_steer_least_loaded(struct hdd_rps_steer *steer,
+				      uint32_t big_mask, bool *owned,
+				      uint64_t *load)
+{
+	int idx, best = -1;
+	bool little, best_little = false;
+
+	for (idx = 0; idx < steer->map_len; idx++) {
+		if (owned[idx])
+			continue;
+
+		little = !(big_mask & BIT(steer->map_cpus[idx]));
+		if (best >= 0 && best_little && !little)
+			continue;
+
+		if (best < 0 || (little && !best_little) ||
+		    load[idx] < load[best]) {
+			best = idx;
+			best_little = little;
+		}
+	}
+
+	return best;
+}
+
+void hdd_rps_steer_update(struct hdd_context *hdd_ctx)
+{
+	struct hdd_rps_steer *steer = &hdd_ctx->rps_steer;
+	struct hdd_config *config = hdd_ctx->config;
+	struct hdd_rps_steer_flow *flow;
+	bool picked[HDD_RPS_STEER_TABLE_SIZE] = {0};
+	bool owned[HDD_RPS_STEER_MAX_CPUS] = {0};
+	uint64_t load[HDD_RPS_STEER_MAX_CPUS] = {0};
+	uint32_t big_mask;
+	uint32_t bytes;
+	uint64_t thres;
+	uint8_t num_big = 0;
+	int i, idx;
+
+	if (!steer->active || !config->bus_bw_compute_interval)
+		return;
+
+	thres = (uint64_t)config->rps_steer_heavy_thres * 1000 * 1000 / 8;
+
+	qdf_spin_lock_bh(&steer->lock);
+
+	hdd_rps_steer_refresh_map(hdd_ctx);
+	big_mask = hdd_rps_steer_big_mask(hdd_ctx);
+	steer->big_mask = big_mask;
+	for (idx = 0; idx < steer->map_len; idx++) {
+		if (big_mask & BIT(steer->map_cpus[idx]))
+			num_big++;
+	}
+
+	steer->num_flows = 0;
+	for (i = 0; i < HDD_RPS_STEER_TABLE_SIZE; i++) {
+		flow = &steer->flows[i];
+		if (!qdf_atomic_read(&flow->flow_id))
+			continue;
+
+		/* the RX path keeps adding while the interval is taken out */
+		bytes = qdf_atomic_read(&flow->bytes);
+		qdf_atomic_sub(bytes, &flow->bytes);
+
+		flow->rate = qdf_do_div((uint64_t)bytes * 1000,
+					config->bus_bw_compute_interval);
+		if (flow->rate) {
+			flow->idle_cnt = 0;
+		} else if (++flow->idle_cnt >= HDD_RPS_STEER_IDLE_INTERVALS) {
+			hdd_rps_steer_reset_flow(flow);
+			continue;
+		}
+
+		steer->num_flows++;
+	}
+
+	/* one dedicated big core for each of the heaviest flows */
+	for (i = 0; i < num_big; i++) {
+		idx = hdd_rps_steer_pick_heavy(steer, picked, thres);
+		if (idx < 0)
+			break;
+		picked[idx] = true;
+	}
+
+	/* heavy flows keep their big core to avoid reordering on a move */
+	steer->num_heavy = 0;
+	for (i = 0; i < HDD_RPS_STEER_TABLE_SIZE; i++) {
+		flow = &steer->flows[i];
+		if (!flow->heavy)
+			continue;
+
+		idx = hdd_rps_steer_map_idx(steer, flow->cpu);
+		if (!picked[i] || idx < 0 || owned[idx] ||
+		    !(big_mask & BIT(steer->map_cpus[idx]))) {
+			flow->heavy = false;
+			continue;
+		}
+
+		owned[idx] = true;
+		hdd_rps_steer_assign(steer, flow, idx);
+		steer->num_heavy++;
+	}
+
+	for (i = 0; i < HDD_RPS_STEER_TABLE_SIZE; i++) {
+		flow = &steer->flows[i];
+		if (!picked[i] || flow->heavy)
+			continue;
+
+		for (idx = 0; idx < steer->map_len; idx++) {
+			if (!owned[idx] &&
+			    (big_mask & BIT(steer->map_cpus[idx])))
+				break;
+		}
+		if (idx == steer->map_len)
+			break;
+
+		owned[idx] = true;
+		flow->heavy = true;
+		hdd_rps_steer_assign(steer, flow, idx);
+		steer->num_heavy++;
+	}
+
+	/* mice flows stay where they are unless their core was taken */
+	for (i = 0; i < HDD_RPS_STEER_TABLE_SIZE; i++) {
+		flow = &steer->flows[i];
+		if (!qdf_atomic_read(&flow->flow_id) || flow->heavy)
+			continue;
+
+		idx = hdd_rps_steer_map_idx(steer, flow->cpu);
+		if (idx < 0 || owned[idx] ||
+		    ((big_mask & BIT(steer->map_cpus[idx])) &&
+		     num_big < steer->map_len)) {
+			WRITE_ONCE(flow->cpu, HDD_RPS_STEER_CPU_NONE);
+			continue;
+		}
+
+		load[idx] += flow->rate;
+		hdd_rps_steer_assign(steer, flow, idx);
+	}
+
+	for (i = 0; i < HDD_RPS_STEER_TABLE_SIZE; i++) {
+		flow = &steer->flows[i];
+		if (!qdf_atomic_read(&flow->flow_id) || flow->heavy ||
+		    flow->cpu != HDD_RPS_STEER_CPU_NONE)
+			continue;
+
+		idx = hdd_rps_steer_least_loaded(steer, big_mask, owned, load);
+		if (idx >= 0)
+			load[idx] += flow->rate;
+		hdd_rps_steer_assign(steer, flow, idx);
+	}
+
+	qdf_spin_unlock_bh(&steer->lock);
+}
+
+void hdd_rps_steer_rx(struct hdd_adapter *adapter, struct sk_buff *skb)
+{
+	struct hdd_rps_steer *steer = &adapter->hdd_ctx->rps_steer;
+	struct hdd_rps_steer_flow *flow;
+	uint32_t flow_id, cur_id, steer_hash;
+
+	if (!READ_ONCE(steer->active))
+		return;
+
+	flow_id = QDF_NBUF_CB_RX_FLOW_ID(skb);
+	if (!flow_id)
+		return;
+
+	flow = &steer->flows[flow_id & (HDD_RPS_STEER_TABLE_SIZE - 1)];
+
+	cur_id = qdf_atomic_read(&flow->flow_id);
+	if (cur_id != flow_id) {
+		/* the entry is freed by the update once its flow went idle */
+		if (cur_id) {
+			qdf_atomic_inc(&steer->evictions);
+			return;
+		}
+
+		/* a lost race only accounts this packet to the other flow */
+		flow->vdev_id = adapter->vdev_id;
+		qdf_atomic_set(&flow->flow_id, flow_id);
+	}
+
+	qdf_atomic_add(skb->len, &flow->bytes);
+
+	steer_hash = qdf_atomic_read(&flow->steer_hash);
+	if (!steer_hash)
+		return;
+
+	if (!hdd_rps_steer_hash_valid(skb, steer_hash, READ_ONCE(flow->cpu))) {
+		qdf_atomic_inc(&steer->map_mismatches);
+		return;
+	}
+
+	skb_set_hash(skb, steer_hash, PKT_HASH_TYPE_L4);
+}
+
+void hdd_rps_steer_start(struct hdd_context *hdd_ctx)
+{
+	struct hdd_rps_steer *steer = &hdd_ctx->rps_steer;
+
+	if (steer->active)
+		return;
+
+	/* the map is picked up from the net devices by the next update */
+	qdf_spin_lock_bh(&steer->lock);
+	steer->map_len = 0;
+	WRITE_ONCE(steer->active, true);
+	qdf_spin_unlock_bh(&steer->lock);
+
+	hdd_debug("RPS steering started, big cpus 0x%x",
+		  hdd_ctx->config->rps_steer_big_cpu_mask);
+}
+
+void hdd_rps_steer_stop(struct hdd_context *hdd_ctx)
+{
+	struct hdd_rps_steer *steer = &hdd_ctx->rps_steer;
+	int i;
+
+	if (!steer->active)
+		return;
+
+	qdf_spin_lock_bh(&steer->lock);
+	WRITE_ONCE(steer->active, false);
+	for (i = 0; i < HDD_RPS_STEER_TABLE_SIZE; i++)
+		hdd_rps_steer_reset_flow(&steer->flows[i]);
+	steer->num_flows = 0;
+	steer->num_heavy = 0;
+	qdf_spin_unlock_bh(&steer->lock);
+
+	hdd_debug("RPS steering stopped");
+}
+
+ssize_t hdd_rps_steer_debugfs_show(struct hdd_adapter *adapter,
+				   uint8_t *buf, ssize_t buf_avail_len)
+{
+	struct hdd_rps_steer *steer = &adapter->hdd_ctx->rps_steer;
+	struct hdd_rps_steer_flow *flow;
+	ssize_t length;
+	uint32_t flow_id;
+	int i;
+
+	qdf_spin_lock_bh(&steer->lock);
+	length = scnprintf(buf, buf_avail_len,
+			   "\nRPS STEERING: %s map cpus %u big cpus 0x%x evictions %u map mismatches %u\n",
+			   steer->active ? "active" : "inactive",
+			   steer->map_len, steer->big_mask,
+			   qdf_atomic_read(&steer->evictions),
+			   qdf_atomic_read(&steer->map_mismatches));
+	length += scnprintf(buf + length, buf_avail_len - length,
+			    "flow_id    rate_kbps  cpu  class\n");
+
+	for (i = 0; i < HDD_RPS_STEER_TABLE_SIZE; i++) {
+		flow = &steer->flows[i];
+		flow_id = qdf_atomic_read(&flow->flow_id);
+		if (!flow_id || flow->vdev_id != adapter->vdev_id)
+			continue;
+
+		if (flow->cpu == HDD_RPS_STEER_CPU_NONE)
+			length += scnprintf(buf + length,
+					    buf_avail_len - length,
+					    "0x%08x %10llu  rps  %s\n",
+					    flow_id,
+					    qdf_do_div(flow->rate * 8, 1000),
+					    flow->heavy ? "heavy" : "mice");
+		else
+			length += scnprintf(buf + length,
+					    buf_avail_len - length,
+					    "0x%08x %10llu  %3u  %s\n",
+					    flow_id,
+					    qdf_do_div(flow->rate * 8, 1000),
+					    flow->cpu,
+					    flow->heavy ? "heavy" : "mice");
+	}
+	qdf_spin_unlock_bh(&steer->lock);
+
+	return length;
+}
+
+void hdd_rps_steer_init(struct hdd_context *hdd_ctx)
+{
+	struct hdd_rps_steer *steer = &hdd_ctx->rps_steer;
+	int i;
+
+	qdf_spinlock_create(&steer->lock);
+	for (i = 0; i < HDD_RPS_STEER_TABLE_SIZE; i++) {
+		qdf_atomic_init(&steer->flows[i].flow_id);
+		qdf_atomic_init(&steer->flows[i].bytes);
+		qdf_atomic_init(&steer->flows[i].steer_hash);
+		hdd_rps_steer_reset_flow(&steer->flows[i]);
+	}
+	qdf_atomic_init(&steer->evictions);
+	qdf_atomic_init(&steer->map_mismatches);
+	steer->active = false;
+}
+
+void hdd_rps_steer_deinit(struct hdd_context *hdd_ctx)
+{
+	hdd_rps_steer_stop(hdd_ctx);
+	qdf_spinlock_destroy(&hdd_ctx->rps_steer.lock);
+}
@@ -950,6 +950,8 @@ QDF_STATUS hdd_softap_rx_packet_cbk(void *adapter_context, qdf_nbuf_t rx_buf)
 
 		skb->protocol = eth_type_trans(skb, skb->dev);
 
+		hdd_rps_steer_rx(adapter, skb);
+
 		/* hold configurable wakelock for unicast traffic */
 		if (!hdd_is_current_high_throughput(hdd_ctx) &&
 		    hdd_ctx->config->rx_wakelock_timeout &&
@@ -981,6 +983,8 @@ QDF_STATUS hdd_softap_rx_packet_cbk(void *adapter_context, qdf_nbuf_t rx_buf)
 		}
 	}
 
+	hdd_rx_ol_batch_end(adapter);
+
 	return QDF_STATUS_SUCCESS;
 }
 
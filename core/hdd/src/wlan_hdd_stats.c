@@ -42,6 +42,7 @@
 #include "wlan_mlme_ucfg_api.h"
 #include "cdp_txrx_misc.h"
 #include "cdp_txrx_host_stats.h"
+#include "wlan_hdd_tx_rx.h"
 
 #if (LINUX_VERSION_CODE < KERNEL_VERSION(4, 0, 0)) && !defined(WITH_BACKPORTS)
 #define HDD_INFO_SIGNAL                 STATION_INFO_SIGNAL
@@ -1233,6 +1234,278 @@ static void hdd_debugfs_process_ll_stats(struct hdd_adapter *adapter,
 		osif_request_complete(request);
 }
 
+/* Streamed peers whose counters are kept as delta reference */
+#define HDD_LL_STATS_STREAM_MAX_PEERS		WLAN_MAX_STA_COUNT
+#define HDD_LL_STATS_STREAM_MIN_INTERVAL	100
+#define HDD_LL_STATS_STREAM_MPDU_THRESHOLD	128
+#define HDD_LL_STATS_STREAM_MSG_LEN		1024
+/* mac address, flags and four 32-bit varints of at most 5 bytes */
+#define HDD_LL_STATS_STREAM_PEER_MAX_LEN	(QDF_MAC_ADDR_SIZE + 1 + 4 * 5)
+
+/**
+ * hdd_ll_stats_stream_put_varint() - encode a counter as LEB128 varint
+ * @pos: buffer position to encode at
+ * @val: counter
+ *
+ * Return: buffer position after the encoded counter
+ */
+static uint8_t *hdd_ll_stats_stream_put_varint(uint8_t *pos, uint32_t val)
+{
+	while (val >= 0x80) {
+		*pos++ = (val & 0x7f) | 0x80;
+		val >>= 7;
+	}
+	*pos++ = val;
+
+	return pos;
+}
+
+/**
+ * hdd_ll_stats_stream_find_peer() - find a peer of the previous interval
+ * @stream: LL stats stream
+ * @peer_macaddr: peer mac address
+ *
+ * Must be called with the stream lock held.
+ *
+ * Return: counters of the peer at the previous interval, NULL if not found
+ */
+static struct hdd_ll_stats_stream_peer *
+hdd_ll_stats_stream_find_peer(struct hdd_ll_stats_stream *stream,
+			      struct qdf_mac_addr *peer_macaddr)
+{
+	uint16_t i;
+
+	if (!stream->prev)
+		return NULL;
+
+	for (i = 0; i < stream->num_prev; i++) {
+		if (qdf_is_macaddr_equal(&stream->prev[i].peer_macaddr,
+					 peer_macaddr))
+			return &stream->prev[i];
+	}
+
+	return NULL;
+}
+
+/**
+ * hdd_ll_stats_stream_put_peer() - encode the record of a peer
+ * @stream: LL stats stream
+ * @peer_info: link layer stats of the peer
+ * @pos: buffer position to encode at, with room for
+ *	HDD_LL_STATS_STREAM_PEER_MAX_LEN bytes
+ *
+ * The counters of the peer are saved as reference for the next interval.
+ *
+ * Return: buffer position after the record
+ */
+static uint8_t *
+hdd_ll_stats_stream_put_peer(struct hdd_ll_stats_stream *stream,
+			     struct wifi_peer_info *peer_info, uint8_t *pos)
+{
+	struct hdd_ll_stats_stream_peer cur = {0};
+	struct hdd_ll_stats_stream_peer delta;
+	struct hdd_ll_stats_stream_peer *prev;
+	uint8_t flags = 0;
+	uint32_t i;
+
+	qdf_copy_macaddr(&cur.peer_macaddr, &peer_info->peer_macaddr);
+	for (i = 0; i < peer_info->num_rate; i++) {
+		cur.tx_mpdu += peer_info->rate_stats[i].tx_mpdu;
+		cur.rx_mpdu += peer_info->rate_stats[i].rx_mpdu;
+		cur.mpdu_lost += peer_info->rate_stats[i].mpdu_lost;
+		cur.retries += peer_info->rate_stats[i].retries;
+	}
+
+	qdf_spin_lock_bh(&stream->lock);
+	prev = hdd_ll_stats_stream_find_peer(stream, &cur.peer_macaddr);
+	if (prev && cur.tx_mpdu >= prev->tx_mpdu &&
+	    cur.rx_mpdu >= prev->rx_mpdu &&
+	    cur.mpdu_lost >= prev->mpdu_lost &&
+	    cur.retries >= prev->retries) {
+		delta.tx_mpdu = cur.tx_mpdu - prev->tx_mpdu;
+		delta.rx_mpdu = cur.rx_mpdu - prev->rx_mpdu;
+		delta.mpdu_lost = cur.mpdu_lost - prev->mpdu_lost;
+		delta.retries = cur.retries - prev->retries;
+	} else {
+		flags |= HDD_LL_STATS_STREAM_PEER_FULL;
+		delta = cur;
+	}
+
+	if (stream->cur && stream->num_cur < HDD_LL_STATS_STREAM_MAX_PEERS)
+		stream->cur[stream->num_cur++] = cur;
+	qdf_spin_unlock_bh(&stream->lock);
+
+	qdf_mem_copy(pos, cur.peer_macaddr.bytes, QDF_MAC_ADDR_SIZE);
+	pos += QDF_MAC_ADDR_SIZE;
+	*pos++ = flags;
+	pos = hdd_ll_stats_stream_put_varint(pos, delta.tx_mpdu);
+	pos = hdd_ll_stats_stream_put_varint(pos, delta.rx_mpdu);
+	pos = hdd_ll_stats_stream_put_varint(pos, delta.mpdu_lost);
+	pos = hdd_ll_stats_stream_put_varint(pos, delta.retries);
+
+	return pos;
+}
+
+/**
+ * hdd_ll_stats_stream_send() - send a streamed LL stats message
+ * @adapter: adapter
+ * @buf: message, starting with room for the header
+ * @end: end of the last peer record
+ * @num_peers: number of peer records in the message
+ * @more_data: more messages follow for this interval
+ *
+ * Return: None
+ */
+static void hdd_ll_stats_stream_send(struct hdd_adapter *adapter,
+				     uint8_t *buf, uint8_t *end,
+				     uint8_t num_peers, bool more_data)
+{
+	struct hdd_ll_stats_stream *stream = &adapter->ll_stats_stream;
+	struct hdd_ll_stats_stream_hdr *hdr;
+
+	hdr = (struct hdd_ll_stats_stream_hdr *)buf;
+	hdr->version = HDD_LL_STATS_STREAM_VERSION;
+	hdr->vdev_id = adapter->vdev_id;
+	hdr->flags = more_data ? HDD_LL_STATS_STREAM_MORE : 0;
+	hdr->num_peers = num_peers;
+	hdr->seq = cpu_to_le16(stream->seq);
+	hdr->reserved = 0;
+	hdr->interval_ms = cpu_to_le32(stream->interval_ms);
+
+	wlan_hdd_send_svc_nlink_msg(adapter->hdd_ctx->radio_index,
+				    WLAN_SVC_LL_STATS_STREAM_IND,
+				    buf, end - buf);
+	stream->num_msgs++;
+}
+
+/**
+ * hdd_ll_stats_stream_end_interval() - make the interval the delta reference
+ * @stream: LL stats stream
+ *
+ * Return: None
+ */
+static void hdd_ll_stats_stream_end_interval(struct hdd_ll_stats_stream *stream)
+{
+	struct hdd_ll_stats_stream_peer *prev;
+
+	qdf_spin_lock_bh(&stream->lock);
+	prev = stream->prev;
+	stream->prev = stream->cur;
+	stream->num_prev = stream->num_cur;
+	stream->cur = prev;
+	stream->num_cur = 0;
+	qdf_spin_unlock_bh(&stream->lock);
+}
+
+/**
+ * hdd_ll_stats_stream_iface() - start streaming an interval
+ * @adapter: adapter
+ * @num_peers: number of peers firmware reports stats for
+ *
+ * Return: None
+ */
+static void hdd_ll_stats_stream_iface(struct hdd_adapter *adapter,
+				      uint32_t num_peers)
+{
+	struct hdd_ll_stats_stream *stream = &adapter->ll_stats_stream;
+	struct hdd_ll_stats_stream_hdr hdr;
+
+	qdf_spin_lock_bh(&stream->lock);
+	stream->num_cur = 0;
+	stream->seq++;
+	qdf_spin_unlock_bh(&stream->lock);
+
+	if (num_peers)
+		return;
+
+	/* No peer stats follow, tell the collector the peers are gone */
+	hdd_ll_stats_stream_end_interval(stream);
+	hdd_ll_stats_stream_send(adapter, (uint8_t *)&hdr,
+				 (uint8_t *)(&hdr + 1), 0, false);
+}
+
+/**
+ * hdd_ll_stats_stream_peers() - stream the stats of a batch of peers
+ * @adapter: adapter
+ * @peer_stat: peer stats from firmware
+ * @more_data: more peer stats follow for this interval
+ *
+ * Return: None
+ */
+static void hdd_ll_stats_stream_peers(struct hdd_adapter *adapter,
+				      struct wifi_peer_stat *peer_stat,
+				      bool more_data)
+{
+	struct hdd_ll_stats_stream *stream = &adapter->ll_stats_stream;
+	struct wifi_peer_info *peer_info;
+	uint8_t *buf, *pos;
+	uint8_t num = 0;
+	uint32_t i;
+
+	buf = qdf_mem_malloc(HDD_LL_STATS_STREAM_MSG_LEN);
+	if (!buf)
+		return;
+
+	pos = buf + sizeof(struct hdd_ll_stats_stream_hdr);
+	peer_info = (struct wifi_peer_info *)peer_stat->peer_info;
+	for (i = 0; i < peer_stat->num_peers; i++) {
+		if (pos - buf + HDD_LL_STATS_STREAM_PEER_MAX_LEN >
+		    HDD_LL_STATS_STREAM_MSG_LEN) {
+			hdd_ll_stats_stream_send(adapter, buf, pos, num, true);
+			pos = buf + sizeof(struct hdd_ll_stats_stream_hdr);
+			num = 0;
+		}
+
+		pos = hdd_ll_stats_stream_put_peer(stream, peer_info, pos);
+		num++;
+
+		peer_info = (struct wifi_peer_info *)((uint8_t *)peer_info +
+			    sizeof(struct wifi_peer_info) +
+			    peer_info->num_rate *
+			    sizeof(struct wifi_rate_stat));
+	}
+
+	if (!more_data)
+		hdd_ll_stats_stream_end_interval(stream);
+
+	hdd_ll_stats_stream_send(adapter, buf, pos, num, more_data);
+	qdf_mem_free(buf);
+}
+
+/**
+ * hdd_ll_stats_stream_process() - stream the LL stats received from firmware
+ * @adapter: adapter
+ * @results: link layer stats from firmware
+ * @request: stream request
+ *
+ * Return: None
+ */
+static void hdd_ll_stats_stream_process(struct hdd_adapter *adapter,
+					tSirLLStatsResults *results,
+					struct osif_request *request)
+{
+	struct hdd_ll_stats_priv *priv = osif_request_priv(request);
+
+	if (results->paramId & WMI_LINK_STATS_IFACE) {
+		hdd_ll_stats_stream_iface(adapter, results->num_peers);
+
+		if (!results->num_peers)
+			priv->request_bitmap &= ~(WMI_LINK_STATS_ALL_PEER);
+
+		priv->request_bitmap &= ~(WMI_LINK_STATS_IFACE);
+	} else if (results->paramId & WMI_LINK_STATS_ALL_PEER) {
+		hdd_ll_stats_stream_peers(adapter, results->results,
+					  results->moreResultToFollow);
+		if (!results->moreResultToFollow)
+			priv->request_bitmap &= ~(WMI_LINK_STATS_ALL_PEER);
+	} else {
+		hdd_err("INVALID LL_STATS_NOTIFY RESPONSE");
+	}
+
+	if (!priv->request_bitmap)
+		osif_request_complete(request);
+}
+
 void wlan_hdd_cfg80211_link_layer_stats_callback(hdd_handle_t hdd_handle,
 						 int indication_type,
 						 tSirLLStatsResults *results,
@@ -1284,7 +1557,9 @@ void wlan_hdd_cfg80211_link_layer_stats_callback(hdd_handle_t hdd_handle,
 
 		if (results->rspId == DEBUGFS_LLSTATS_REQID) {
 			hdd_debugfs_process_ll_stats(adapter, results, request);
-		 } else {
+		} else if (results->rspId == HDD_LL_STATS_STREAM_REQID) {
+			hdd_ll_stats_stream_process(adapter, results, request);
+		} else {
 			qdf_spin_lock(&priv->ll_stats_lock);
 			if (priv->request_bitmap)
 				hdd_process_ll_stats(results, request);
@@ -1422,6 +1697,8 @@ __wlan_hdd_cfg80211_ll_stats_set(struct wiphy *wiphy,
 	}
 
 	adapter->is_link_layer_stats_set = true;
+	/* configured by userspace, not to be reverted by the stream */
+	adapter->ll_stats_stream.ll_stats_enabled = false;
 	hdd_exit();
 	return 0;
 }
@@ -1624,6 +1901,232 @@ exit:
 	return ret;
 }
 
+/**
+ * hdd_ll_stats_stream_has_peers() - check if the adapter may have peers
+ * @adapter: adapter
+ *
+ * Return: true if the STA is connected or the BSS of the SAP is started
+ */
+static bool hdd_ll_stats_stream_has_peers(struct hdd_adapter *adapter)
+{
+	struct hdd_station_ctx *sta_ctx;
+
+	if (wlan_hdd_validate_context(adapter->hdd_ctx))
+		return false;
+
+	switch (adapter->device_mode) {
+	case QDF_STA_MODE:
+	case QDF_P2P_CLIENT_MODE:
+		sta_ctx = WLAN_HDD_GET_STATION_CTX_PTR(adapter);
+		return hdd_conn_is_connected(sta_ctx) &&
+		       !sta_ctx->hdd_reassoc_scenario;
+	case QDF_SAP_MODE:
+	case QDF_P2P_GO_MODE:
+		return test_bit(SOFTAP_BSS_STARTED, &adapter->event_flags);
+	default:
+		return false;
+	}
+}
+
+/**
+ * hdd_ll_stats_stream_work() - fetch the LL stats of the interval
+ * @work: delayed work of the stream
+ *
+ * The stats are streamed from the response callback, the work only sends
+ * the request and waits for the response before it is scheduled again.
+ * The work is only scheduled while the stream is armed.
+ *
+ * Return: None
+ */
+static void hdd_ll_stats_stream_work(struct work_struct *work)
+{
+	struct hdd_ll_stats_stream *stream =
+		qdf_container_of(to_delayed_work(work),
+				 struct hdd_ll_stats_stream, work);
+	struct hdd_adapter *adapter =
+		qdf_container_of(stream, struct hdd_adapter, ll_stats_stream);
+	struct osif_vdev_sync *vdev_sync;
+	tSirLLStatsGetReq req;
+
+	if (!osif_vdev_sync_op_start(adapter->dev, &vdev_sync)) {
+		if (hdd_ll_stats_stream_has_peers(adapter)) {
+			req.reqId = HDD_LL_STATS_STREAM_REQID;
+			req.paramIdMask = WMI_LINK_STATS_IFACE |
+					  WMI_LINK_STATS_ALL_PEER;
+			req.staId = adapter->vdev_id;
+			if (wlan_hdd_send_ll_stats_req(adapter, &req))
+				stream->num_failures++;
+		}
+		osif_vdev_sync_op_stop(vdev_sync);
+	}
+
+	/* rescheduled under the lock so that disarm can cancel it */
+	qdf_spin_lock_bh(&stream->lock);
+	if (stream->armed)
+		schedule_delayed_work(&stream->work,
+				      msecs_to_jiffies(stream->interval_ms));
+	qdf_spin_unlock_bh(&stream->lock);
+}
+
+void hdd_ll_stats_stream_init(struct hdd_adapter *adapter)
+{
+	struct hdd_ll_stats_stream *stream = &adapter->ll_stats_stream;
+
+	INIT_DELAYED_WORK(&stream->work, hdd_ll_stats_stream_work);
+	qdf_spinlock_create(&stream->lock);
+}
+
+void hdd_ll_stats_stream_deinit(struct hdd_adapter *adapter)
+{
+	qdf_spinlock_destroy(&adapter->ll_stats_stream.lock);
+}
+
+void hdd_ll_stats_stream_start(struct hdd_adapter *adapter)
+{
+	struct hdd_context *hdd_ctx = adapter->hdd_ctx;
+	struct hdd_ll_stats_stream *stream = &adapter->ll_stats_stream;
+	uint32_t interval_ms = hdd_ctx->config->ll_stats_stream_interval;
+	struct hdd_ll_stats_stream_peer *prev, *cur;
+
+	if (!interval_ms || stream->interval_ms)
+		return;
+
+	switch (adapter->device_mode) {
+	case QDF_STA_MODE:
+	case QDF_P2P_CLIENT_MODE:
+	case QDF_SAP_MODE:
+	case QDF_P2P_GO_MODE:
+		break;
+	default:
+		return;
+	}
+
+	prev = qdf_mem_malloc(HDD_LL_STATS_STREAM_MAX_PEERS * sizeof(*prev));
+	if (!prev)
+		return;
+
+	cur = qdf_mem_malloc(HDD_LL_STATS_STREAM_MAX_PEERS * sizeof(*cur));
+	if (!cur) {
+		qdf_mem_free(prev);
+		return;
+	}
+
+	qdf_spin_lock_bh(&stream->lock);
+	stream->prev = prev;
+	stream->num_prev = 0;
+	stream->cur = cur;
+	stream->num_cur = 0;
+	stream->interval_ms = QDF_MAX(interval_ms,
+				      HDD_LL_STATS_STREAM_MIN_INTERVAL);
+	qdf_spin_unlock_bh(&stream->lock);
+
+	hdd_debug("vdev %d: LL stats streaming every %u ms",
+		  adapter->vdev_id, stream->interval_ms);
+
+	/* the link may already be up, e.g. when restarted after SSR */
+	if (hdd_ll_stats_stream_has_peers(adapter))
+		hdd_ll_stats_stream_arm(adapter);
+}
+
+void hdd_ll_stats_stream_stop(struct hdd_adapter *adapter)
+{
+	struct hdd_ll_stats_stream *stream = &adapter->ll_stats_stream;
+	struct hdd_ll_stats_stream_peer *prev, *cur;
+
+	if (!stream->interval_ms)
+		return;
+
+	hdd_ll_stats_stream_disarm(adapter);
+	cancel_delayed_work_sync(&stream->work);
+
+	qdf_spin_lock_bh(&stream->lock);
+	prev = stream->prev;
+	cur = stream->cur;
+	stream->prev = NULL;
+	stream->num_prev = 0;
+	stream->cur = NULL;
+	stream->num_cur = 0;
+	stream->interval_ms = 0;
+	qdf_spin_unlock_bh(&stream->lock);
+
+	qdf_mem_free(cur);
+	qdf_mem_free(prev);
+
+	hdd_debug("vdev %d: LL stats streaming stopped, msgs %u failures %u",
+		  adapter->vdev_id, stream->num_msgs, stream->num_failures);
+}
+
+void hdd_ll_stats_stream_arm(struct hdd_adapter *adapter)
+{
+	struct hdd_context *hdd_ctx = adapter->hdd_ctx;
+	struct hdd_ll_stats_stream *stream = &adapter->ll_stats_stream;
+	tSirLLStatsSetReq set_req;
+
+	if (!stream->interval_ms || stream->armed)
+		return;
+
+	if (!adapter->is_link_layer_stats_set) {
+		set_req.reqId = HDD_LL_STATS_STREAM_REQID;
+		set_req.mpduSizeThreshold = HDD_LL_STATS_STREAM_MPDU_THRESHOLD;
+		set_req.aggressiveStatisticsGathering = 0;
+		set_req.staId = adapter->vdev_id;
+		if (QDF_IS_STATUS_ERROR(sme_ll_stats_set_req(hdd_ctx->mac_handle,
+							     &set_req))) {
+			hdd_err("Failed to enable LL stats for streaming");
+			return;
+		}
+		adapter->is_link_layer_stats_set = true;
+		stream->ll_stats_enabled = true;
+	}
+
+	/* the first interval of a new link is reported in full */
+	qdf_spin_lock_bh(&stream->lock);
+	stream->num_prev = 0;
+	stream->num_cur = 0;
+	stream->armed = true;
+	schedule_delayed_work(&stream->work,
+			      msecs_to_jiffies(stream->interval_ms));
+	qdf_spin_unlock_bh(&stream->lock);
+}
+
+void hdd_ll_stats_stream_disarm(struct hdd_adapter *adapter)
+{
+	struct hdd_context *hdd_ctx = adapter->hdd_ctx;
+	struct hdd_ll_stats_stream *stream = &adapter->ll_stats_stream;
+	tSirLLStatsClearReq clear_req;
+
+	if (!stream->armed)
+		return;
+
+	qdf_spin_lock_bh(&stream->lock);
+	stream->armed = false;
+	qdf_spin_unlock_bh(&stream->lock);
+
+	/*
+	 * Not waiting for a running work here, the disconnect and BSS stop
+	 * events are delivered in the context answering its stats request.
+	 */
+	cancel_delayed_work(&stream->work);
+
+	if (!stream->ll_stats_enabled)
+		return;
+
+	/* restore the LL stats state the stream found at arm time */
+	stream->ll_stats_enabled = false;
+	adapter->is_link_layer_stats_set = false;
+	if (cds_is_driver_recovering())
+		return;
+
+	clear_req.reqId = HDD_LL_STATS_STREAM_REQID;
+	clear_req.staId = adapter->vdev_id;
+	clear_req.statsClearReqMask = WIFI_STATS_IFACE_AC |
+				      WIFI_STATS_IFACE_ALL_PEER;
+	clear_req.stopReq = 1;
+	if (QDF_IS_STATUS_ERROR(sme_ll_stats_clear_req(hdd_ctx->mac_handle,
+						       &clear_req)))
+		hdd_err("Failed to disable LL stats after streaming");
+}
+
 int wlan_hdd_ll_stats_get(struct hdd_adapter *adapter, uint32_t req_id,
 			  uint32_t req_mask)
 {
@@ -1912,8 +2415,10 @@ __wlan_hdd_cfg80211_ll_stats_clear(struct wiphy *wiphy,
 	 * the firmware is just asked to clear the
 	 * statistics.
 	 */
-	if (stopReq == 1)
+	if (stopReq == 1) {
 		adapter->is_link_layer_stats_set = false;
+		adapter->ll_stats_stream.ll_stats_enabled = false;
+	}
 
 	hdd_exit();
 
@@ -3350,7 +3855,7 @@ wlan_hdd_get_sap_stats(struct hdd_adapter *adapter, struct station_info *info)
 {
 	int ret;
 
-	ret = wlan_hdd_get_station_stats(adapter);
+	ret = wlan_hdd_get_cached_station_stats(adapter);
 	if (ret) {
 		hdd_err("Failed to get SAP stats; status:%d", ret);
 		return ret;
@@ -4740,7 +5245,7 @@ static int wlan_hdd_get_sta_stats(struct wiphy *wiphy,
 		wlan_hdd_get_rcpi(adapter, (uint8_t *)mac, &rcpi_value,
 				  RCPI_MEASUREMENT_TYPE_AVG_MGMT);
 
-	wlan_hdd_get_station_stats(adapter);
+	wlan_hdd_get_cached_station_stats(adapter);
 
 	adapter->rssi = adapter->hdd_stats.summary_stat.rssi;
 	snr = adapter->hdd_stats.summary_stat.snr;
@@ -6503,6 +7008,129 @@ put_request:
 }
 #endif /* QCA_SUPPORT_CP_STATS */
 
+/**
+ * hdd_stats_cache_refresh() - Refresh the cached station stats
+ * @adapter: adapter
+ *
+ * Caller must own the refresh_pending claim of the cache. The snapshot is
+ * only marked fresh if the cache was not invalidated while the request was
+ * in flight.
+ *
+ * Return: status of wlan_hdd_get_station_stats()
+ */
+static int hdd_stats_cache_refresh(struct hdd_adapter *adapter)
+{
+	struct hdd_stats_cache *cache = &adapter->stats_cache;
+	int32_t gen = qdf_atomic_read(&cache->gen);
+	int errno;
+
+	errno = wlan_hdd_get_station_stats(adapter);
+	if (!errno && gen == qdf_atomic_read(&cache->gen))
+		cache->last_update = qdf_mc_timer_get_system_time();
+	qdf_atomic_set(&cache->refresh_pending, 0);
+
+	return errno;
+}
+
+/**
+ * hdd_stats_cache_refresh_work() - Background refresh of the stats cache
+ * @work: refresh_work of the adapter stats cache
+ *
+ * Return: None
+ */
+static void hdd_stats_cache_refresh_work(struct work_struct *work)
+{
+	struct hdd_adapter *adapter = container_of(work, struct hdd_adapter,
+						   stats_cache.refresh_work);
+	struct osif_vdev_sync *vdev_sync;
+
+	if (osif_vdev_sync_op_start(adapter->dev, &vdev_sync)) {
+		qdf_atomic_set(&adapter->stats_cache.refresh_pending, 0);
+		return;
+	}
+
+	hdd_stats_cache_refresh(adapter);
+
+	osif_vdev_sync_op_stop(vdev_sync);
+}
+
+void hdd_stats_cache_init(struct hdd_adapter *adapter)
+{
+	struct hdd_stats_cache *cache = &adapter->stats_cache;
+
+	INIT_WORK(&cache->refresh_work, hdd_stats_cache_refresh_work);
+	qdf_atomic_init(&cache->refresh_pending);
+	qdf_atomic_init(&cache->gen);
+	cache->last_update = 0;
+	cache->hits = 0;
+	cache->stale_hits = 0;
+	cache->misses = 0;
+	cache->coalesced = 0;
+}
+
+void hdd_stats_cache_invalidate(struct hdd_adapter *adapter)
+{
+	qdf_atomic_inc(&adapter->stats_cache.gen);
+	adapter->stats_cache.last_update = 0;
+}
+
+void hdd_stats_cache_flush(struct hdd_adapter *adapter)
+{
+	struct hdd_stats_cache *cache = &adapter->stats_cache;
+
+	cancel_work_sync(&cache->refresh_work);
+	qdf_atomic_set(&cache->refresh_pending, 0);
+	hdd_stats_cache_invalidate(adapter);
+
+	hdd_debug("stats cache hits %u stale %u misses %u coalesced %u",
+		  cache->hits, cache->stale_hits, cache->misses,
+		  cache->coalesced);
+}
+
+int wlan_hdd_get_cached_station_stats(struct hdd_adapter *adapter)
+{
+	struct hdd_stats_cache *cache = &adapter->stats_cache;
+	uint32_t max_age = adapter->hdd_ctx->config->sta_stats_cache_age;
+	qdf_time_t last_update;
+	qdf_time_t age;
+
+	if (!max_age)
+		return wlan_hdd_get_station_stats(adapter);
+
+	/*
+	 * get_station requests are serialized by rtnl_lock, so the only
+	 * concurrent refresh is the background one. A snapshot is never
+	 * returned past max_age; from half of it on, a background refresh
+	 * is started so that the next request finds a fresh snapshot.
+	 */
+	last_update = cache->last_update;
+	age = qdf_mc_timer_get_system_time() - last_update;
+	if (last_update && age <= max_age) {
+		if (age > max_age / 2) {
+			cache->stale_hits++;
+			if (qdf_atomic_inc_return(&cache->refresh_pending) == 1)
+				schedule_work(&cache->refresh_work);
+		} else {
+			cache->hits++;
+		}
+		return 0;
+	}
+
+	cache->misses++;
+	if (qdf_atomic_inc_return(&cache->refresh_pending) != 1) {
+		/* wait for the result of the refresh in flight */
+		cache->coalesced++;
+		flush_work(&cache->refresh_work);
+		last_update = cache->last_update;
+		age = qdf_mc_timer_get_system_time() - last_update;
+		if (last_update && age <= max_age)
+			return 0;
+		qdf_atomic_inc(&cache->refresh_pending);
+	}
+
+	return hdd_stats_cache_refresh(adapter);
+}
+
 struct temperature_priv {
 	int temperature;
 };
@@ -6597,6 +7225,7 @@ void wlan_hdd_display_txrx_stats(struct hdd_context *ctx)
 	int i = 0;
 	uint32_t total_rx_pkt, total_rx_dropped,
 		 total_rx_delv, total_rx_refused;
+	uint32_t ratio;
 
 	hdd_for_each_adapter_dev_held(ctx, adapter) {
 		total_rx_pkt = 0;
@@ -6632,7 +7261,7 @@ void wlan_hdd_display_txrx_stats(struct hdd_context *ctx)
 				  i, stats->rx_packets[i], stats->rx_dropped[i],
 				  stats->rx_delivered[i], stats->rx_refused[i]);
 		}
-		hdd_debug("RX - packets %u, dropped %u, unsolict_arp_n_mcast_drp %u, delivered %u, refused %u GRO - agg %u drop %u non-agg %u flush_skip %u low_tput_flush %u disabled(conc %u low-tput %u)",
+		hdd_debug("RX - packets %u, dropped %u, unsolict_arp_n_mcast_drp %u, delivered %u, refused %u GRO - agg %u drop %u non-agg %u flush_skip %u low_tput_flush %u batch_flush %u disabled(conc %u low-tput %u)",
 			  total_rx_pkt, total_rx_dropped,
 			  qdf_atomic_read(&stats->rx_usolict_arp_n_mcast_drp),
 			  total_rx_delv,
@@ -6640,8 +7269,21 @@ void wlan_hdd_display_txrx_stats(struct hdd_context *ctx)
 			  stats->rx_gro_dropped, stats->rx_non_aggregated,
 			  stats->rx_gro_flush_skip,
 			  stats->rx_gro_low_tput_flush,
+			  stats->rx_gro_batch_flush,
 			  qdf_atomic_read(&ctx->disable_rx_ol_in_concurrency),
 			  qdf_atomic_read(&ctx->disable_rx_ol_in_low_tput));
+
+		for (i = 0; i < HDD_RX_OL_FLOW_MAX; i++) {
+			if (!stats->rx_gro_pkts[i])
+				continue;
+			ratio = hdd_rx_ol_coalesce_ratio(stats->rx_gro_pkts[i],
+							 stats->rx_gro_merged[i]);
+			hdd_debug("GRO %s: pkts %u merged %u ratio %u.%02u",
+				  hdd_rx_ol_flow_class_str(i),
+				  stats->rx_gro_pkts[i],
+				  stats->rx_gro_merged[i],
+				  ratio / 100, ratio % 100);
+		}
 	}
 }
 
@@ -205,6 +205,100 @@ void wlan_hdd_cfg80211_link_layer_stats_ext_callback(hdd_handle_t ctx,
 void hdd_lost_link_info_cb(hdd_handle_t hdd_handle,
 			   struct sir_lost_link_info *lost_link_info);
 
+/* Request id of the link layer stats fetched for streaming */
+#define HDD_LL_STATS_STREAM_REQID	4294967294UL
+
+#define HDD_LL_STATS_STREAM_VERSION	1
+
+/* More messages of the same interval follow */
+#define HDD_LL_STATS_STREAM_MORE	BIT(0)
+
+/* Peer counters are absolute values, not the increase since last interval */
+#define HDD_LL_STATS_STREAM_PEER_FULL	BIT(0)
+
+/**
+ * struct hdd_ll_stats_stream_hdr - header of a streamed LL stats message
+ * @version: HDD_LL_STATS_STREAM_VERSION
+ * @vdev_id: vdev of the peers
+ * @flags: HDD_LL_STATS_STREAM_MORE if more messages follow for @seq
+ * @num_peers: number of peer records following the header
+ * @seq: interval sequence number, little endian
+ * @reserved: reserved, 0
+ * @interval_ms: streaming interval in ms, little endian
+ *
+ * Sent as WLAN_SVC_LL_STATS_STREAM_IND on the WLAN service netlink
+ * multicast group. Each peer record is the 6 byte peer mac address, a flags
+ * byte and the tx_mpdu, rx_mpdu, mpdu_lost and retries counters summed over
+ * all rates, each an unsigned LEB128 varint. The counters are the increase
+ * since the previous interval, unless HDD_LL_STATS_STREAM_PEER_FULL is set
+ * for a new peer or after the firmware counters were reset. Peers missing
+ * from an interval are no longer connected.
+ */
+struct hdd_ll_stats_stream_hdr {
+	uint8_t version;
+	uint8_t vdev_id;
+	uint8_t flags;
+	uint8_t num_peers;
+	__le16 seq;
+	uint16_t reserved;
+	__le32 interval_ms;
+} qdf_packed;
+
+/**
+ * hdd_ll_stats_stream_init() - Initialize the LL stats streaming of adapter
+ * @adapter: adapter
+ *
+ * Return: None
+ */
+void hdd_ll_stats_stream_init(struct hdd_adapter *adapter);
+
+/**
+ * hdd_ll_stats_stream_deinit() - De-initialize the LL stats streaming
+ * @adapter: adapter
+ *
+ * Return: None
+ */
+void hdd_ll_stats_stream_deinit(struct hdd_adapter *adapter);
+
+/**
+ * hdd_ll_stats_stream_start() - Set up the LL stats streaming of adapter
+ * @adapter: STA, P2P client, SAP or P2P GO adapter
+ *
+ * Does nothing if the ll_stats_stream_interval ini is 0. The stats are
+ * only fetched while the stream is armed, i.e. while the STA is connected
+ * or the BSS of the SAP is started.
+ *
+ * Return: None
+ */
+void hdd_ll_stats_stream_start(struct hdd_adapter *adapter);
+
+/**
+ * hdd_ll_stats_stream_stop() - Tear down the LL stats streaming of adapter
+ * @adapter: adapter
+ *
+ * Return: None
+ */
+void hdd_ll_stats_stream_stop(struct hdd_adapter *adapter);
+
+/**
+ * hdd_ll_stats_stream_arm() - Start streaming the LL stats of the peers
+ * @adapter: adapter which got connected or whose BSS got started
+ *
+ * Link layer stats collection is enabled in firmware for the vdev if not
+ * done already, and disabled again when the stream is disarmed.
+ *
+ * Return: None
+ */
+void hdd_ll_stats_stream_arm(struct hdd_adapter *adapter);
+
+/**
+ * hdd_ll_stats_stream_disarm() - Stop streaming the LL stats of the peers
+ * @adapter: adapter which got disconnected or whose BSS got stopped
+ *
+ * Return: None
+ */
+void hdd_ll_stats_stream_disarm(struct hdd_adapter *adapter);
+
 #else /* WLAN_FEATURE_LINK_LAYER_STATS */
 
 static inline bool hdd_link_layer_stats_supported(void)
@@ -253,6 +347,30 @@ hdd_lost_link_info_cb(hdd_handle_t hdd_handle,
 {
 }
 
+static inline void hdd_ll_stats_stream_init(struct hdd_adapter *adapter)
+{
+}
+
+static inline void hdd_ll_stats_stream_deinit(struct hdd_adapter *adapter)
+{
+}
+
+static inline void hdd_ll_stats_stream_start(struct hdd_adapter *adapter)
+{
+}
+
+static inline void hdd_ll_stats_stream_stop(struct hdd_adapter *adapter)
+{
+}
+
+static inline void hdd_ll_stats_stream_arm(struct hdd_adapter *adapter)
+{
+}
+
+static inline void hdd_ll_stats_stream_disarm(struct hdd_adapter *adapter)
+{
+}
+
 #endif /* End of WLAN_FEATURE_LINK_LAYER_STATS */
 
 #ifdef WLAN_FEATURE_STATS_EXT
@@ -444,6 +562,48 @@ QDF_STATUS wlan_hdd_get_class_astats(struct hdd_adapter *adapter);
  */
 int wlan_hdd_get_station_stats(struct hdd_adapter *adapter);
 
+/**
+ * wlan_hdd_get_cached_station_stats() - Get station statistics through cache
+ * @adapter: adapter for which statistics are desired
+ *
+ * Same as wlan_hdd_get_station_stats(), but returns without a firmware
+ * request if the statistics saved in the adapter are not older than the
+ * sta_stats_cache_age ini. Past half of that age a refresh is scheduled in
+ * the background as well. Callers needing a refresh wait for the one
+ * already in flight, if any, instead of sending a new request.
+ *
+ * Return: status of operation
+ */
+int wlan_hdd_get_cached_station_stats(struct hdd_adapter *adapter);
+
+/**
+ * hdd_stats_cache_init() - Initialize the station stats cache of an adapter
+ * @adapter: adapter
+ *
+ * Return: None
+ */
+void hdd_stats_cache_init(struct hdd_adapter *adapter);
+
+/**
+ * hdd_stats_cache_invalidate() - Empty the station stats cache of an adapter
+ * @adapter: adapter
+ *
+ * Called when the link changes, so that the next get_station request does
+ * not return statistics of the previous link. A refresh in flight does not
+ * repopulate the cache.
+ *
+ * Return: None
+ */
+void hdd_stats_cache_invalidate(struct hdd_adapter *adapter);
+
+/**
+ * hdd_stats_cache_flush() - Wait for the background refresh and empty cache
+ * @adapter: adapter
+ *
+ * Return: None
+ */
+void hdd_stats_cache_flush(struct hdd_adapter *adapter);
+
 /**
  * wlan_hdd_get_temperature() - get current device temperature
  * @adapter: device upon which the request was made
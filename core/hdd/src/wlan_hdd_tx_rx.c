@@ -33,6 +33,7 @@
 #include <linux/etherdevice.h>
 #include <linux/if_ether.h>
 #include <linux/inetdevice.h>
+#include <linux/sort.h>
 #include <cds_sched.h>
 #include <cds_utils.h>
 
@@ -1556,181 +1557,285 @@ static void hdd_resolve_rx_ol_mode(struct hdd_context *hdd_ctx)
 }
 
 /**
- * hdd_gro_rx_bh_disable() - GRO RX/flush function.
- * @napi_to_use: napi to be used to give packets to the stack, gro flush
- * @skb: pointer to sk_buff
+ * hdd_rx_ol_in_thread() - Check if GRO is run from an RX thread
+ * @hdd_ctx: pointer to hdd context
  *
- * Function calls napi_gro_receive for the skb. If the skb indicates that a
- * flush needs to be done (set by the lower DP layer), the function also calls
- * napi_gro_flush. Local softirqs are disabled (and later enabled) while making
- * napi_gro__ calls.
+ * In the RX thread modes the held packets are flushed at the end of every
+ * batch. In NAPI mode the batch ends with the HIF poll instead.
  *
- * Return: QDF_STATUS_SUCCESS if not dropped by napi_gro_receive or
- *	   QDF error code.
+ * Return: true if GRO is delivered from the legacy or DP RX threads
  */
-static QDF_STATUS hdd_gro_rx_bh_disable(struct hdd_adapter *adapter,
-					struct napi_struct *napi_to_use,
-					struct sk_buff *skb)
+static inline bool hdd_rx_ol_in_thread(struct hdd_context *hdd_ctx)
 {
-	QDF_STATUS status = QDF_STATUS_SUCCESS;
-	struct hdd_context *hdd_ctx = adapter->hdd_ctx;
-	gro_result_t gro_res;
+	return hdd_ctx->rx_ol.initialized &&
+	       hdd_ctx->ol_enable == CFG_GRO_ENABLED &&
+	       (hdd_ctx->enable_rxthread || hdd_ctx->enable_dp_rx_threads);
+}
 
-	skb_set_hash(skb, QDF_NBUF_CB_RX_FLOW_ID(skb), PKT_HASH_TYPE_L4);
+/**
+ * hdd_rx_ol_get_cpu_ctx() - Get the NAPI context of the current CPU
+ * @hdd_ctx: pointer to hdd context
+ *
+ * The caller may migrate after this, the context is protected by its own
+ * lock and not by the CPU it belongs to.
+ *
+ * Return: per-CPU NAPI context of the RX offload engine
+ */
+static inline struct hdd_rx_ol_cpu_ctx *
+hdd_rx_ol_get_cpu_ctx(struct hdd_context *hdd_ctx)
+{
+	return per_cpu_ptr(hdd_ctx->rx_ol.cpu_ctx, raw_smp_processor_id());
+}
 
-	local_bh_disable();
-	gro_res = napi_gro_receive(napi_to_use, skb);
+/**
+ * hdd_rx_ol_flush_all() - Flush the GRO packets held on every CPU
+ * @hdd_ctx: pointer to hdd context
+ *
+ * The IRQ of a HIF NAPI or an RX thread may move to another CPU, leaving
+ * packets held in the context of the CPU it ran on, so every context
+ * holding packets is flushed and not only the one of the current CPU.
+ *
+ * Return: true if there were packets to flush
+ */
+static bool hdd_rx_ol_flush_all(struct hdd_context *hdd_ctx)
+{
+	struct hdd_rx_ol_cpu_ctx *cpu_ctx;
+	bool flushed = false;
+	int cpu;
+
+	for_each_possible_cpu(cpu) {
+		cpu_ctx = per_cpu_ptr(hdd_ctx->rx_ol.cpu_ctx, cpu);
+		if (!READ_ONCE(cpu_ctx->held))
+			continue;
 
-	if (hdd_get_current_throughput_level(hdd_ctx) == PLD_BUS_WIDTH_IDLE) {
-		if (gro_res != GRO_DROP && gro_res != GRO_NORMAL) {
-			adapter->hdd_stats.tx_rx_stats.
-					rx_gro_low_tput_flush++;
-			napi_gro_flush(napi_to_use, false);
+		qdf_spin_lock_bh(&cpu_ctx->lock);
+		if (cpu_ctx->held) {
+			napi_gro_flush(&cpu_ctx->napi, false);
+			cpu_ctx->held = 0;
+			flushed = true;
 		}
+		qdf_spin_unlock_bh(&cpu_ctx->lock);
 	}
-	local_bh_enable();
 
-	if (gro_res == GRO_DROP)
-		status = QDF_STATUS_E_GRO_DROP;
-
-	return status;
+	return flushed;
 }
 
 /**
- * hdd_gro_rx_dp_thread() - Handle Rx procesing via GRO for DP thread
- * @adapter: pointer to adapter context
+ * hdd_rx_ol_get_flow_class() - Classify a GRO eligible packet for the stats
  * @skb: pointer to sk_buff
  *
- * Return: QDF_STATUS_SUCCESS if processed via GRO or non zero return code
+ * Return: flow class of the packet
  */
-static
-QDF_STATUS hdd_gro_rx_dp_thread(struct hdd_adapter *adapter,
-				struct sk_buff *skb)
+static inline enum hdd_rx_ol_flow_class
+hdd_rx_ol_get_flow_class(struct sk_buff *skb)
 {
-	struct napi_struct *napi_to_use = NULL;
-	QDF_STATUS status = QDF_STATUS_E_FAILURE;
+	if (QDF_NBUF_CB_RX_TCP_PURE_ACK(skb))
+		return HDD_RX_OL_FLOW_TCP_ACK;
 
-	if (!adapter->hdd_ctx->enable_dp_rx_threads) {
-		hdd_dp_err_rl("gro not supported without DP RX thread!");
-		return status;
-	}
-
-	napi_to_use =
-		dp_rx_get_napi_context(cds_get_context(QDF_MODULE_ID_SOC),
-				       QDF_NBUF_CB_RX_CTX_ID(skb));
-
-	if (!napi_to_use) {
-		hdd_dp_err_rl("no napi to use for GRO!");
-		return status;
-	}
-
-	status = hdd_gro_rx_bh_disable(adapter, napi_to_use, skb);
+	if (QDF_NBUF_CB_RX_IPV6_PROTO(skb))
+		return HDD_RX_OL_FLOW_TCP6;
 
-	return status;
+	return HDD_RX_OL_FLOW_TCP4;
 }
 
 /**
- * hdd_gro_rx_legacy() - Handle Rx processing via GRO for ihelium based targets
+ * hdd_gro_rx() - Handle Rx processing via GRO
  * @adapter: pointer to adapter context
  * @skb: pointer to sk_buff
  *
- * Supports GRO for only station mode
+ * Feeds the skb to the NAPI context of the current CPU. Nothing is flushed
+ * here, the held packets are flushed once per batch by
+ * hdd_rx_ol_batch_end() or once per HIF poll by hdd_rx_ol_flush(). Local
+ * softirqs are only disabled for the GRO call.
  *
  * Return: QDF_STATUS_SUCCESS if processed via GRO or non zero return code
  */
-static
-QDF_STATUS hdd_gro_rx_legacy(struct hdd_adapter *adapter, struct sk_buff *skb)
+static QDF_STATUS hdd_gro_rx(struct hdd_adapter *adapter, struct sk_buff *skb)
 {
-	struct qca_napi_info *qca_napii;
-	struct qca_napi_data *napid;
-	struct napi_struct *napi_to_use;
-	QDF_STATUS status = QDF_STATUS_E_FAILURE;
 	struct hdd_context *hdd_ctx = adapter->hdd_ctx;
+	struct hdd_tx_rx_stats *stats = &adapter->hdd_stats.tx_rx_stats;
+	struct hdd_rx_ol_cpu_ctx *cpu_ctx;
+	enum hdd_rx_ol_flow_class flow_class;
+	gro_result_t gro_res;
+
+	if (hdd_ctx->rx_ol.lithium) {
+		if (!hdd_ctx->enable_dp_rx_threads) {
+			hdd_dp_err_rl("gro not supported without DP RX thread!");
+			return QDF_STATUS_E_FAILURE;
+		}
+	} else {
+		/* Only enabling it for STA mode like LRO today */
+		if (QDF_STA_MODE != adapter->device_mode)
+			return QDF_STATUS_E_NOSUPPORT;
+
+		if (qdf_atomic_read(&hdd_ctx->disable_rx_ol_in_low_tput) ||
+		    qdf_atomic_read(&hdd_ctx->disable_rx_ol_in_concurrency))
+			return QDF_STATUS_E_NOSUPPORT;
+	}
+
+	/* keep the hash chosen by RPS steering */
+	if (!skb->l4_hash)
+		skb_set_hash(skb, QDF_NBUF_CB_RX_FLOW_ID(skb),
+			     PKT_HASH_TYPE_L4);
+	flow_class = hdd_rx_ol_get_flow_class(skb);
+
+	cpu_ctx = hdd_rx_ol_get_cpu_ctx(hdd_ctx);
+	qdf_spin_lock_bh(&cpu_ctx->lock);
+	gro_res = napi_gro_receive(&cpu_ctx->napi, skb);
+	if (gro_res != GRO_DROP && gro_res != GRO_NORMAL)
+		WRITE_ONCE(cpu_ctx->held, cpu_ctx->held + 1);
+	qdf_spin_unlock_bh(&cpu_ctx->lock);
 
-	/* Only enabling it for STA mode like LRO today */
-	if (QDF_STA_MODE != adapter->device_mode)
-		return QDF_STATUS_E_NOSUPPORT;
+	if (gro_res == GRO_DROP)
+		return QDF_STATUS_E_GRO_DROP;
 
-	if (qdf_atomic_read(&hdd_ctx->disable_rx_ol_in_low_tput) ||
-	    qdf_atomic_read(&hdd_ctx->disable_rx_ol_in_concurrency))
-		return QDF_STATUS_E_NOSUPPORT;
+	if (gro_res == GRO_MERGED || gro_res == GRO_MERGED_FREE)
+		stats->rx_gro_merged[flow_class]++;
+	stats->rx_gro_pkts[flow_class]++;
 
-	napid = hdd_napi_get_all();
-	if (unlikely(!napid))
-		goto out;
+	return QDF_STATUS_SUCCESS;
+}
+
+void hdd_rx_ol_batch_end(struct hdd_adapter *adapter)
+{
+	struct hdd_context *hdd_ctx = adapter->hdd_ctx;
+
+	if (hdd_rx_ol_in_thread(hdd_ctx)) {
+		if (hdd_rx_ol_flush_all(hdd_ctx))
+			adapter->hdd_stats.tx_rx_stats.rx_gro_batch_flush++;
+		return;
+	}
 
-	qca_napii = hif_get_napi(QDF_NBUF_CB_RX_CTX_ID(skb), napid);
-	if (unlikely(!qca_napii))
-		goto out;
+	if (!hdd_ctx->rx_ol.initialized ||
+	    hdd_ctx->ol_enable != CFG_GRO_ENABLED)
+		return;
 
 	/*
-	 * As we are breaking context in Rxthread mode, there is rx_thread NAPI
-	 * corresponds each hif_napi.
+	 * In NAPI mode the HIF poll flushes, but do not hold packets till the
+	 * end of the poll when there is no throughput to aggregate.
 	 */
-	if (adapter->hdd_ctx->enable_rxthread)
-		napi_to_use =  &qca_napii->rx_thread_napi;
-	else
-		napi_to_use = &qca_napii->napi;
+	if (hdd_get_current_throughput_level(hdd_ctx) != PLD_BUS_WIDTH_IDLE)
+		return;
 
-	status = hdd_gro_rx_bh_disable(adapter, napi_to_use, skb);
-out:
+	if (hdd_rx_ol_flush_all(hdd_ctx))
+		adapter->hdd_stats.tx_rx_stats.rx_gro_low_tput_flush++;
+}
 
-	return status;
+#ifdef FEATURE_LRO
+/**
+ * hdd_rx_ol_lro_flush() - Flush the LRO context of a HIF NAPI
+ * @qca_napii: hif NAPI context
+ *
+ * Return: none
+ */
+static inline void hdd_rx_ol_lro_flush(struct qca_napi_info *qca_napii)
+{
+	qdf_lro_flush(qca_napii->lro_ctx);
 }
+#else
+static inline void hdd_rx_ol_lro_flush(struct qca_napi_info *qca_napii)
+{
+}
+#endif
 
 /**
- * hdd_rxthread_napi_gro_flush() - GRO flush callback for NAPI+Rx_Thread Rx mode
+ * hdd_rx_ol_flush() - RX offload flush callback, called once per HIF poll
  * @data: hif NAPI context
  *
  * Return: none
  */
-static void hdd_rxthread_napi_gro_flush(void *data)
+static void hdd_rx_ol_flush(void *data)
 {
-	struct qca_napi_info *qca_napii = (struct qca_napi_info *)data;
+	struct hdd_context *hdd_ctx = cds_get_context(QDF_MODULE_ID_HDD);
 
-	local_bh_disable();
-	/*
-	 * As we are breaking context in Rxthread mode, there is rx_thread NAPI
-	 * corresponds each hif_napi.
-	 */
-	napi_gro_flush(&qca_napii->rx_thread_napi, false);
-	local_bh_enable();
+	if (!hdd_ctx)
+		return;
+
+	if (hdd_ctx->ol_enable == CFG_LRO_ENABLED) {
+		hdd_rx_ol_lro_flush((struct qca_napi_info *)data);
+		return;
+	}
+
+	if (hdd_ctx->rx_ol.initialized)
+		hdd_rx_ol_flush_all(hdd_ctx);
 }
 
 /**
- * hdd_hif_napi_gro_flush() - GRO flush callback for NAPI Rx mode
- * @data: hif NAPI context
+ * hdd_rx_ol_napi_poll() - dummy poll of the RX offload NAPI contexts
+ * @napi: pointer to the NAPI context
+ * @budget: poll budget
  *
- * Return: none
+ * Return: 0 as it is not supposed to be polled at all as it is not scheduled.
  */
-static void hdd_hif_napi_gro_flush(void *data)
+static int hdd_rx_ol_napi_poll(struct napi_struct *napi, int budget)
 {
-	struct qca_napi_info *qca_napii = (struct qca_napi_info *)data;
+	QDF_DEBUG_PANIC("this napi_poll should not be polled as we don't schedule it");
 
-	local_bh_disable();
-	napi_gro_flush(&qca_napii->napi, false);
-	local_bh_enable();
+	return 0;
 }
 
-#ifdef FEATURE_LRO
 /**
- * hdd_qdf_lro_flush() - LRO flush wrapper
- * @data: hif NAPI context
+ * hdd_rx_ol_engine_init() - Set up the per-CPU NAPI contexts for GRO
+ * @hdd_ctx: pointer to hdd context
  *
- * Return: none
+ * The contexts survive SSR, so they are only set up on the first call.
+ *
+ * Return: 0 on success, -ENOMEM if the contexts cannot be allocated
  */
-static void hdd_qdf_lro_flush(void *data)
+static int hdd_rx_ol_engine_init(struct hdd_context *hdd_ctx)
 {
-	struct qca_napi_info *qca_napii = (struct qca_napi_info *)data;
-	qdf_lro_ctx_t qdf_lro_ctx = qca_napii->lro_ctx;
+	struct hdd_rx_ol_engine *rx_ol = &hdd_ctx->rx_ol;
+	struct hdd_rx_ol_cpu_ctx *cpu_ctx;
+	int cpu;
+
+	if (rx_ol->initialized)
+		return 0;
+
+	rx_ol->netdev = qdf_mem_malloc(sizeof(*rx_ol->netdev));
+	if (!rx_ol->netdev)
+		return -ENOMEM;
+
+	rx_ol->cpu_ctx = alloc_percpu(struct hdd_rx_ol_cpu_ctx);
+	if (!rx_ol->cpu_ctx) {
+		qdf_mem_free(rx_ol->netdev);
+		rx_ol->netdev = NULL;
+		return -ENOMEM;
+	}
+
+	init_dummy_netdev(rx_ol->netdev);
+	for_each_possible_cpu(cpu) {
+		cpu_ctx = per_cpu_ptr(rx_ol->cpu_ctx, cpu);
+		netif_napi_add(rx_ol->netdev, &cpu_ctx->napi,
+			       hdd_rx_ol_napi_poll, NAPI_POLL_WEIGHT);
+		napi_enable(&cpu_ctx->napi);
+		qdf_spinlock_create(&cpu_ctx->lock);
+		cpu_ctx->held = 0;
+	}
+	rx_ol->initialized = true;
 
-	qdf_lro_flush(qdf_lro_ctx);
+	return 0;
 }
-#else
-static void hdd_qdf_lro_flush(void *data)
+
+void hdd_rx_ol_deinit(struct hdd_context *hdd_ctx)
 {
+	struct hdd_rx_ol_engine *rx_ol = &hdd_ctx->rx_ol;
+	struct hdd_rx_ol_cpu_ctx *cpu_ctx;
+	int cpu;
+
+	if (!rx_ol->initialized)
+		return;
+
+	rx_ol->initialized = false;
+	for_each_possible_cpu(cpu) {
+		cpu_ctx = per_cpu_ptr(rx_ol->cpu_ctx, cpu);
+		netif_napi_del(&cpu_ctx->napi);
+		qdf_spinlock_destroy(&cpu_ctx->lock);
+	}
+	free_percpu(rx_ol->cpu_ctx);
+	rx_ol->cpu_ctx = NULL;
+	qdf_mem_free(rx_ol->netdev);
+	rx_ol->netdev = NULL;
 }
-#endif
 
 /**
  * hdd_register_rx_ol() - Register LRO/GRO rx processing callbacks
@@ -1750,25 +1855,21 @@ static void hdd_register_rx_ol_cb(struct hdd_context *hdd_ctx,
 	}
 
 	hdd_ctx->en_tcp_delack_no_lro = 0;
+	hdd_ctx->rx_ol.lithium = lithium_based_target;
 
 	if (!hdd_is_lro_enabled(hdd_ctx)) {
-		cdp_register_rx_offld_flush_cb(soc, hdd_qdf_lro_flush);
+		cdp_register_rx_offld_flush_cb(soc, hdd_rx_ol_flush);
 		hdd_ctx->receive_offload_cb = hdd_lro_rx;
 		hdd_debug("LRO is enabled");
 	} else if (hdd_ctx->ol_enable == CFG_GRO_ENABLED) {
-		if (lithium_based_target) {
-		/* no flush registration needed, it happens in DP thread */
-			hdd_ctx->receive_offload_cb = hdd_gro_rx_dp_thread;
-		} else {
-			/*ihelium based targets */
-			if (hdd_ctx->enable_rxthread)
-				cdp_register_rx_offld_flush_cb(soc,
-							       hdd_rxthread_napi_gro_flush);
-			else
-				cdp_register_rx_offld_flush_cb(soc,
-							       hdd_hif_napi_gro_flush);
-			hdd_ctx->receive_offload_cb = hdd_gro_rx_legacy;
+		if (hdd_rx_ol_engine_init(hdd_ctx)) {
+			hdd_err("GRO contexts alloc failed, GRO disabled");
+			return;
 		}
+		/* lithium targets flush from the DP thread batches */
+		if (!lithium_based_target)
+			cdp_register_rx_offld_flush_cb(soc, hdd_rx_ol_flush);
+		hdd_ctx->receive_offload_cb = hdd_gro_rx;
 		hdd_debug("GRO is enabled");
 	} else if (HDD_MSM_CFG(hdd_ctx->config->enable_tcp_delack)) {
 		hdd_ctx->en_tcp_delack_no_lro = 1;
@@ -1883,12 +1984,25 @@ void hdd_disable_rx_ol_for_low_tput(struct hdd_context *hdd_ctx, bool disable)
 }
 
 #else /* RECEIVE_OFFLOAD */
+static inline bool hdd_rx_ol_in_thread(struct hdd_context *hdd_ctx)
+{
+	return false;
+}
+
 int hdd_rx_ol_init(struct hdd_context *hdd_ctx)
 {
 	hdd_err("Rx_OL, LRO/GRO not supported");
 	return -EPERM;
 }
 
+void hdd_rx_ol_deinit(struct hdd_context *hdd_ctx)
+{
+}
+
+void hdd_rx_ol_batch_end(struct hdd_adapter *adapter)
+{
+}
+
 void hdd_disable_rx_ol_in_concurrency(bool disable)
 {
 }
@@ -1898,6 +2012,28 @@ void hdd_disable_rx_ol_for_low_tput(struct hdd_context *hdd_ctx, bool disable)
 }
 #endif /* RECEIVE_OFFLOAD */
 
+const char *hdd_rx_ol_flow_class_str(enum hdd_rx_ol_flow_class flow_class)
+{
+	switch (flow_class) {
+	case HDD_RX_OL_FLOW_TCP4:
+		return "TCPv4";
+	case HDD_RX_OL_FLOW_TCP6:
+		return "TCPv6";
+	case HDD_RX_OL_FLOW_TCP_ACK:
+		return "TCP_ACK";
+	default:
+		return "UNKNOWN";
+	}
+}
+
+uint32_t hdd_rx_ol_coalesce_ratio(uint32_t pkts, uint32_t merged)
+{
+	if (!pkts || merged >= pkts)
+		return 0;
+
+	return (uint32_t)qdf_do_div((uint64_t)pkts * 100, pkts - merged);
+}
+
 #ifdef WLAN_FEATURE_TSF_PLUS
 static inline void hdd_tsf_timestamp_rx(struct hdd_context *hdd_ctx,
 					qdf_nbuf_t netbuf,
@@ -1930,6 +2066,10 @@ QDF_STATUS hdd_rx_thread_gro_flush_ind_cbk(void *adapter, int rx_ctx_id)
 		return QDF_STATUS_SUCCESS;
 	}
 
+	/* GRO packets are flushed at the end of every DP thread batch */
+	if (hdd_rx_ol_in_thread(hdd_adapter->hdd_ctx))
+		return QDF_STATUS_SUCCESS;
+
 	return dp_rx_gro_flush_ind(cds_get_context(QDF_MODULE_ID_SOC),
 				   rx_ctx_id);
 }
@@ -2164,6 +2304,8 @@ QDF_STATUS hdd_rx_packet_cbk(void *adapter_context,
 		++adapter->stats.rx_packets;
 		adapter->stats.rx_bytes += skb->len;
 
+		hdd_rps_steer_rx(adapter, skb);
+
 		/* Incr GW Rx count for NUD tracking based on GW mac addr */
 		hdd_nud_incr_gw_rx_pkt_cnt(adapter, mac_addr);
 
@@ -2229,6 +2371,8 @@ QDF_STATUS hdd_rx_packet_cbk(void *adapter_context,
 		}
 	}
 
+	hdd_rx_ol_batch_end(adapter);
+
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -2326,54 +2470,26 @@ static void wlan_hdd_update_queue_oper_stats(struct hdd_adapter *adapter,
 	}
 }
 
-/**
- * hdd_netdev_queue_is_locked()
- * @txq: net device tx queue
- *
- * For SMP system, always return false and we could safely rely on
- * __netif_tx_trylock().
- *
- * Return: true locked; false not locked
- */
-#ifdef QCA_CONFIG_SMP
-static inline bool hdd_netdev_queue_is_locked(struct netdev_queue *txq)
-{
-	return false;
-}
-#else
-static inline bool hdd_netdev_queue_is_locked(struct netdev_queue *txq)
-{
-	return txq->xmit_lock_owner != -1;
-}
-#endif
-
 /**
  * wlan_hdd_update_txq_timestamp() - update txq timestamp
  * @dev: net device
  *
+ * The timestamp only defers the TX watchdog of a stopped queue, so it is
+ * stored without taking the queue xmit lock and the store is skipped when
+ * it would not change, to keep the queue cache line clean.
+ *
  * Return: none
  */
 static void wlan_hdd_update_txq_timestamp(struct net_device *dev)
 {
 	struct netdev_queue *txq;
+	unsigned long now = jiffies;
 	int i;
 
 	for (i = 0; i < NUM_TX_QUEUES; i++) {
 		txq = netdev_get_tx_queue(dev, i);
-
-		/*
-		 * On UP system, kernel will trigger watchdog bite if spinlock
-		 * recursion is detected. Unfortunately recursion is possible
-		 * when it is called in dev_queue_xmit() context, where stack
-		 * grabs the lock before calling driver's ndo_start_xmit
-		 * callback.
-		 */
-		if (!hdd_netdev_queue_is_locked(txq)) {
-			if (__netif_tx_trylock(txq)) {
-				txq_trans_update(txq);
-				__netif_tx_unlock(txq);
-			}
-		}
+		if (READ_ONCE(txq->trans_start) != now)
+			WRITE_ONCE(txq->trans_start, now);
 	}
 }
 
@@ -2437,7 +2553,8 @@ wlan_hdd_dump_queue_history_state(struct hdd_netif_queue_history *queue_history,
 
 /**
  * wlan_hdd_update_queue_history_state() - Save a copy of dev TX queues state
- * @adapter: adapter handle
+ * @dev: net device
+ * @q_hist: queue history entry
  *
  * Save netdev TX queues state into adapter queue history.
  *
@@ -2455,10 +2572,129 @@ wlan_hdd_update_queue_history_state(struct net_device *dev,
 
 	for (i = 0; i < num_tx_queues; i++) {
 		txq = netdev_get_tx_queue(dev, i);
-		q_hist->tx_q_state[i] = txq->state;
+		q_hist->tx_q_state[i] = READ_ONCE(txq->state);
 	}
 }
 
+/**
+ * wlan_hdd_record_queue_history() - Record a netif queue operation
+ * @adapter: adapter handle
+ * @action: action type
+ * @reason: reason type
+ * @pause_map: pause map after the operation
+ *
+ * The entry is written into the ring of the current CPU with interrupts
+ * disabled, so the ring is never written concurrently and no lock is
+ * needed. The entry sequence is odd while it is being written, which
+ * lets readers drop the entries they raced with.
+ *
+ * Return: None
+ */
+static void wlan_hdd_record_queue_history(struct hdd_adapter *adapter,
+					  enum netif_action_type action,
+					  enum netif_reason_type reason,
+					  uint32_t pause_map)
+{
+	struct hdd_netif_queue_history_ring *ring;
+	struct hdd_netif_queue_history *q_hist;
+	unsigned long flags;
+	int cpu;
+
+	local_irq_save(flags);
+	cpu = qdf_get_cpu();
+	ring = &adapter->queue_oper_history[cpu];
+	q_hist = &ring->entries[ring->head++ &
+				(WLAN_HDD_MAX_HISTORY_ENTRY - 1)];
+
+	WRITE_ONCE(q_hist->seq, q_hist->seq + 1);
+	smp_wmb();
+	q_hist->time = qdf_get_log_timestamp_usecs();
+	q_hist->netif_action = action;
+	q_hist->netif_reason = reason;
+	q_hist->pause_map = pause_map;
+	q_hist->cpu = cpu;
+	wlan_hdd_update_queue_history_state(adapter->dev, q_hist);
+	smp_wmb();
+	WRITE_ONCE(q_hist->seq, q_hist->seq + 1);
+	local_irq_restore(flags);
+}
+
+QDF_STATUS wlan_hdd_queue_history_alloc(struct hdd_adapter *adapter)
+{
+	adapter->queue_oper_history =
+		qdf_mem_malloc(nr_cpu_ids *
+			       sizeof(*adapter->queue_oper_history));
+	if (!adapter->queue_oper_history)
+		return QDF_STATUS_E_NOMEM;
+
+	return QDF_STATUS_SUCCESS;
+}
+
+void wlan_hdd_queue_history_free(struct hdd_netif_queue_history_ring *rings)
+{
+	qdf_mem_free(rings);
+}
+
+/**
+ * wlan_hdd_queue_history_cmp() - Order netif queue history entries by time
+ * @a: first entry
+ * @b: second entry
+ *
+ * Return: <0, 0 or >0 if @a is older, as old or newer than @b
+ */
+static int wlan_hdd_queue_history_cmp(const void *a, const void *b)
+{
+	const struct hdd_netif_queue_history *q_a = a;
+	const struct hdd_netif_queue_history *q_b = b;
+
+	if (q_a->time == q_b->time)
+		return 0;
+
+	return q_a->time < q_b->time ? -1 : 1;
+}
+
+uint32_t
+wlan_hdd_get_queue_history(struct hdd_adapter *adapter,
+			   struct hdd_netif_queue_history *q_hist,
+			   uint32_t max_entries)
+{
+	struct hdd_netif_queue_history *entry;
+	uint64_t clear_time = READ_ONCE(adapter->history_clear_time);
+	uint32_t num_entries = 0;
+	uint32_t seq;
+	int cpu, i;
+
+	for_each_possible_cpu(cpu) {
+		if (!READ_ONCE(adapter->queue_oper_history[cpu].head))
+			continue;
+
+		for (i = 0; i < WLAN_HDD_MAX_HISTORY_ENTRY; i++) {
+			if (num_entries == max_entries)
+				goto sort;
+
+			entry = &adapter->queue_oper_history[cpu].entries[i];
+			seq = READ_ONCE(entry->seq);
+			if (!seq || (seq & 1))
+				continue;
+
+			smp_rmb();
+			q_hist[num_entries] = *entry;
+			smp_rmb();
+			if (READ_ONCE(entry->seq) != seq ||
+			    q_hist[num_entries].time <= clear_time)
+				continue;
+
+			num_entries++;
+		}
+	}
+
+sort:
+	sort(q_hist, num_entries, sizeof(*q_hist),
+	     wlan_hdd_queue_history_cmp, NULL);
+
+	return num_entries;
+}
+
 /**
  * wlan_hdd_stop_non_priority_queue() - stop non prority queues
  * @adapter: adapter handle
@@ -2503,8 +2739,6 @@ void wlan_hdd_netif_queue_control(struct hdd_adapter *adapter,
 	enum netif_action_type action, enum netif_reason_type reason)
 {
 	uint32_t temp_map;
-	uint8_t index;
-	struct hdd_netif_queue_history *txq_hist_ptr;
 
 	if ((!adapter) || (WLAN_HDD_ADAPTER_MAGIC != adapter->magic) ||
 		 (!adapter->dev)) {
@@ -2672,25 +2906,17 @@ void wlan_hdd_netif_queue_control(struct hdd_adapter *adapter,
 		hdd_err("unsupported action %d", action);
 	}
 
-	spin_lock_bh(&adapter->pause_map_lock);
-	if (adapter->pause_map & (1 << WLAN_PEER_UNAUTHORISED))
-		wlan_hdd_process_peer_unauthorised_pause(adapter);
-
-	index = adapter->history_index++;
-	if (adapter->history_index == WLAN_HDD_MAX_HISTORY_ENTRY)
-		adapter->history_index = 0;
-	spin_unlock_bh(&adapter->pause_map_lock);
+	temp_map = READ_ONCE(adapter->pause_map);
+	if (temp_map & (1 << WLAN_PEER_UNAUTHORISED)) {
+		spin_lock_bh(&adapter->pause_map_lock);
+		if (adapter->pause_map & (1 << WLAN_PEER_UNAUTHORISED))
+			wlan_hdd_process_peer_unauthorised_pause(adapter);
+		temp_map = adapter->pause_map;
+		spin_unlock_bh(&adapter->pause_map_lock);
+	}
 
 	wlan_hdd_update_queue_oper_stats(adapter, action, reason);
-
-	adapter->queue_oper_history[index].time = qdf_system_ticks();
-	adapter->queue_oper_history[index].netif_action = action;
-	adapter->queue_oper_history[index].netif_reason = reason;
-	adapter->queue_oper_history[index].pause_map = adapter->pause_map;
-
-	txq_hist_ptr = &adapter->queue_oper_history[index];
-
-	wlan_hdd_update_queue_history_state(adapter->dev, txq_hist_ptr);
+	wlan_hdd_record_queue_history(adapter, action, reason, temp_map);
 }
 
 void hdd_print_netdev_txq_status(struct net_device *dev)
@@ -3009,6 +3235,10 @@ static void hdd_ini_bus_bandwidth(struct hdd_config *config,
 		cfg_get(psoc, CFG_DP_BUS_BANDWIDTH_COMPUTE_INTERVAL);
 	config->bus_low_cnt_threshold =
 		cfg_get(psoc, CFG_DP_BUS_LOW_BW_CNT_THRESHOLD);
+	config->rps_steer_big_cpu_mask =
+		cfg_get(psoc, CFG_DP_RPS_STEER_BIG_CPU_MASK);
+	config->rps_steer_heavy_thres =
+		cfg_get(psoc, CFG_DP_RPS_STEER_HEAVY_FLOW_THRESHOLD);
 }
 
 /**
@@ -2467,7 +2467,8 @@
  * pm_run_scenario - Create scenario with number of connections provided.
  *
  * @INPUT: num_of_conn
- * @num_of_conn: the number of connections (values: 1~3)
+ * @num_of_conn: the number of connections (values: 1~3), or 4 to check
+ *	the packed concurrency tables against the original ones
  *
  * @OUTPUT: None
  *
@@ -3098,6 +3099,7 @@ void hdd_wlan_get_stats(struct hdd_adapter *adapter, uint16_t *length,
 	uint32_t len = 0;
 	uint32_t total_rx_pkt = 0, total_rx_dropped = 0;
 	uint32_t total_rx_delv = 0, total_rx_refused = 0;
+	uint32_t ratio;
 	int i = 0;
 	struct hdd_context *hdd_ctx = adapter->hdd_ctx;
 
@@ -3115,7 +3117,7 @@ void hdd_wlan_get_stats(struct hdd_adapter *adapter, uint16_t *length,
 			"\n[classified] BK %u, BE %u, VI %u, VO %u"
 			"\n\nReceive[%lu] - "
 			"packets %u, dropped %u, unsolict_arp_n_mcast_drp %u, delivered %u, refused %u\n"
-			"GRO - agg %u non-agg %u flush_skip %u low_tput_flush %u disabled(conc %u low-tput %u)\n",
+			"GRO - agg %u non-agg %u flush_skip %u low_tput_flush %u batch_flush %u disabled(conc %u low-tput %u)\n",
 			qdf_system_ticks(),
 			stats->tx_called,
 			stats->tx_dropped,
@@ -3136,6 +3138,7 @@ void hdd_wlan_get_stats(struct hdd_adapter *adapter, uint16_t *length,
 			stats->rx_aggregated, stats->rx_non_aggregated,
 			stats->rx_gro_flush_skip,
 			stats->rx_gro_low_tput_flush,
+			stats->rx_gro_batch_flush,
 			qdf_atomic_read(&hdd_ctx->disable_rx_ol_in_concurrency),
 			qdf_atomic_read(&hdd_ctx->disable_rx_ol_in_low_tput));
 
@@ -3149,6 +3152,16 @@ void hdd_wlan_get_stats(struct hdd_adapter *adapter, uint16_t *length,
 				 stats->rx_delivered[i], stats->rx_refused[i]);
 	}
 
+	for (i = 0; i < HDD_RX_OL_FLOW_MAX; i++) {
+		ratio = hdd_rx_ol_coalesce_ratio(stats->rx_gro_pkts[i],
+						 stats->rx_gro_merged[i]);
+		len += scnprintf(buffer + len, buf_len - len,
+				 "GRO %s: pkts %u merged %u ratio %u.%02u\n",
+				 hdd_rx_ol_flow_class_str(i),
+				 stats->rx_gro_pkts[i], stats->rx_gro_merged[i],
+				 ratio / 100, ratio % 100);
+	}
+
 	len += scnprintf(buffer + len, buf_len - len,
 		"\nTX_FLOW"
 		"\nCurrent status: %s"
@@ -7839,6 +7852,8 @@ static int iw_get_policy_manager_ut_ops(struct hdd_context *hdd_ctx,
 			/* MCC on same band with 1x1 same mac */
 			wlan_hdd_three_connections_scenario(hdd_ctx,
 				36, 149, POLICY_MGR_ONE_ONE, 1);
+		} else if (apps_args[0] == 4) {
+			wlan_hdd_packed_tables_scenario(hdd_ctx);
 		}
 		print_report(hdd_ctx);
 	}
@@ -1580,6 +1580,8 @@ QDF_STATUS hdd_wmm_init(struct hdd_adapter *adapter)
 		status = hdd_send_dscp_up_map_to_fw(adapter);
 	}
 
+	hdd_wmm_update_dscp_queue_map(adapter);
+
 	return status;
 }
 
@@ -1691,6 +1693,7 @@ QDF_STATUS hdd_wmm_adapter_close(struct hdd_adapter *adapter)
  * @adapter: adapter upon which the packet is being transmitted
  * @skb: pointer to network buffer
  * @user_pri: user priority of the OS packet
+ * @queue: netdev queue of the OS packet
  * @is_eapol: eapol packet flag
  *
  * Return: None
@@ -1699,6 +1702,7 @@ static
 void hdd_wmm_classify_pkt(struct hdd_adapter *adapter,
 			  struct sk_buff *skb,
 			  enum sme_qos_wmmuptype *user_pri,
+			  uint16_t *queue,
 			  bool *is_eapol)
 {
 	unsigned char dscp;
@@ -1804,9 +1808,11 @@ void hdd_wmm_classify_pkt(struct hdd_adapter *adapter,
 
 	dscp = (tos >> 2) & 0x3f;
 	*user_pri = adapter->dscp_to_up_map[dscp];
+	*queue = adapter->wmm_classifier.dscp_to_queue_map[dscp];
 
 #ifdef HDD_WMM_DEBUG
-	hdd_debug("tos is %d, dscp is %d, up is %d", tos, dscp, *user_pri);
+	hdd_debug("tos is %d, dscp is %d, up is %d, queue is %d",
+		  tos, dscp, *user_pri, *queue);
 #endif /* HDD_WMM_DEBUG */
 }
 
@@ -1823,26 +1829,36 @@ static uint16_t __hdd_get_queue_index(uint16_t up)
 	return hdd_linux_up_to_ac_map[up];
 }
 
+void hdd_wmm_update_dscp_queue_map(struct hdd_adapter *adapter)
+{
+	struct hdd_wmm_classifier *classifier = &adapter->wmm_classifier;
+	uint8_t dscp;
+
+	for (dscp = 0; dscp <= WLAN_MAX_DSCP; dscp++)
+		classifier->dscp_to_queue_map[dscp] =
+			__hdd_get_queue_index(adapter->dscp_to_up_map[dscp]);
+}
+
 #if defined(QCA_LL_TX_FLOW_CONTROL_V2) || defined(QCA_HL_NETDEV_FLOW_CONTROL)
 /**
  * hdd_get_queue_index() - get queue index
- * @up: user priority
+ * @queue: netdev queue the packet was classified to
  * @is_eapol: is_eapol flag
  *
  * Return: queue_index
  */
 static
-uint16_t hdd_get_queue_index(uint16_t up, bool is_eapol)
+uint16_t hdd_get_queue_index(uint16_t queue, bool is_eapol)
 {
 	if (qdf_unlikely(is_eapol == true))
 		return HDD_LINUX_AC_HI_PRIO;
-	return __hdd_get_queue_index(up);
+	return queue;
 }
 #else
 static
-uint16_t hdd_get_queue_index(uint16_t up, bool is_eapol)
+uint16_t hdd_get_queue_index(uint16_t queue, bool is_eapol)
 {
-	return __hdd_get_queue_index(up);
+	return queue;
 }
 #endif
 
@@ -1859,6 +1875,7 @@ static uint16_t hdd_wmm_select_queue(struct net_device *dev,
 				     struct sk_buff *skb)
 {
 	enum sme_qos_wmmuptype up = SME_QOS_WMM_UP_BE;
+	uint16_t queue = HDD_LINUX_AC_BE;
 	uint16_t index;
 	struct hdd_adapter *adapter = WLAN_HDD_GET_PRIV_PTR(dev);
 	bool is_crtical = false;
@@ -1872,8 +1889,8 @@ static uint16_t hdd_wmm_select_queue(struct net_device *dev,
 		return HDD_LINUX_AC_BE;
 	}
 
-	/* Get the user priority from IP header */
-	hdd_wmm_classify_pkt(adapter, skb, &up, &is_crtical);
+	/* Get the user priority and queue from IP header */
+	hdd_wmm_classify_pkt(adapter, skb, &up, &queue, &is_crtical);
 	spin_lock_bh(&adapter->pause_map_lock);
 	if ((adapter->pause_map & (1 <<  WLAN_DATA_FLOW_CONTROL)) &&
 	   !(adapter->pause_map & (1 <<  WLAN_DATA_FLOW_CONTROL_PRIORITY))) {
@@ -1893,7 +1910,7 @@ static uint16_t hdd_wmm_select_queue(struct net_device *dev,
 	}
 	spin_unlock_bh(&adapter->pause_map_lock);
 	skb->priority = up;
-	index = hdd_get_queue_index(skb->priority, is_crtical);
+	index = hdd_get_queue_index(queue, is_crtical);
 
 	return index;
 }
@@ -2243,6 +2260,8 @@ QDF_STATUS hdd_wmm_assoc(struct hdd_adapter *adapter,
 
 	if (!QDF_IS_STATUS_SUCCESS(status))
 		hdd_wmm_init(adapter);
+	else
+		hdd_wmm_update_dscp_queue_map(adapter);
 
 	hdd_exit();
 
@@ -482,6 +482,11 @@ struct pe_session {
 	uint16_t schBeaconOffsetBegin;
 	/* Size of the trailing portion */
 	uint16_t schBeaconOffsetEnd;
+	/* Offsets of CSA/ECSA switch count in the trailing portion, 0 if none */
+	uint16_t sch_csa_count_offset;
+	uint16_t sch_ecsa_count_offset;
+	/* P2P IE offset of the beacon template, see sch_context */
+	uint16_t sch_p2p_ie_offset;
 	bool isOSENConnection;
 	/*  DSCP to UP mapping for HS 2.0 */
 	struct qos_map_set QosMapSet;
@@ -52,6 +52,22 @@ void sch_edca_profile_update(struct mac_context *mac,
 QDF_STATUS sch_set_fixed_beacon_fields(struct mac_context *mac,
 				       struct pe_session *pe_session);
 
+/**
+ * sch_patch_csa_count() - Update the switch count of the beacon template
+ * @mac: pointer to mac structure
+ * @pe_session: pe session
+ *
+ * Writes the current switch count of the session into the CSA/ECSA IEs of
+ * the cached beacon template and probe response, without regenerating the
+ * other IEs. Only possible if the cached template already announces the
+ * switch to the current target channel.
+ *
+ * Return: QDF_STATUS_SUCCESS if patched, QDF_STATUS_E_INVAL if the template
+ * has to be regenerated with sch_set_fixed_beacon_fields()
+ */
+QDF_STATUS sch_patch_csa_count(struct mac_context *mac,
+			       struct pe_session *pe_session);
+
 /**
  * sch_process_pre_beacon_ind() - Process the PreBeacon Indication from the Lim
  * @mac: pointer to mac structure
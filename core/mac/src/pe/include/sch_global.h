@@ -50,6 +50,9 @@
  * @p2p_ie_offset: P2P IE offset
  * @csa_count_offset: CSA Switch Count Offset to be sent to FW
  * @ecsa_count_offset: ECSA Switch Count Offset to be sent to FW
+ * @num_bcn_full_update: number of beacon templates generated from scratch
+ * @num_bcn_patch_update: number of beacon templates updated by patching
+ *	the switch count of the cached template
  */
 struct sch_context {
 	uint16_t beacon_interval;
@@ -57,6 +60,8 @@ struct sch_context {
 	uint16_t p2p_ie_offset;
 	uint32_t csa_count_offset;
 	uint32_t ecsa_count_offset;
+	uint32_t num_bcn_full_update;
+	uint32_t num_bcn_patch_update;
 };
 
 #endif
@@ -7694,6 +7694,21 @@ lim_send_dfs_chan_sw_ie_update(struct mac_context *mac_ctx, struct pe_session *s
 		 session->gLimChannelSwitch.switchCount);
 }
 
+void
+lim_send_dfs_chan_sw_count_update(struct mac_context *mac_ctx,
+				  struct pe_session *session)
+{
+	/* Only the count changed, patch it unless the IEs have to be rebuilt */
+	if (QDF_IS_STATUS_ERROR(sch_patch_csa_count(mac_ctx, session))) {
+		lim_send_dfs_chan_sw_ie_update(mac_ctx, session);
+		return;
+	}
+
+	lim_send_beacon_ind(mac_ctx, session, REASON_CHANNEL_SWITCH);
+	pe_debug("Updated CSA IE, IE COUNT: %d",
+		 session->gLimChannelSwitch.switchCount);
+}
+
 void lim_process_ap_ecsa_timeout(void *data)
 {
 	struct pe_session *session = (struct pe_session *)data;
@@ -7726,7 +7741,7 @@ void lim_process_ap_ecsa_timeout(void *data)
 	 */
 	if (session->gLimChannelSwitch.switchCount > 0) {
 		/* Send the next beacon with updated CSA IE count */
-		lim_send_dfs_chan_sw_ie_update(mac_ctx, session);
+		lim_send_dfs_chan_sw_count_update(mac_ctx, session);
 
 		ch = session->gLimChannelSwitch.primaryChannel;
 		ch_width = session->gLimChannelSwitch.ch_width;
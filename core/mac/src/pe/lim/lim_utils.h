@@ -1365,6 +1365,20 @@ enum rateid lim_get_min_session_txrate(struct pe_session *session);
 void lim_send_dfs_chan_sw_ie_update(struct mac_context *mac_ctx,
 				    struct pe_session *session);
 
+/**
+ * lim_send_dfs_chan_sw_count_update() - updates the switch count of the
+ * channel switch IE in beacon template
+ * @mac_ctx: pointer to global mac context
+ * @session: A pointer to pesession
+ *
+ * Patches the count into the cached beacon template and falls back to
+ * lim_send_dfs_chan_sw_ie_update() if the template has to be regenerated.
+ *
+ * Return: None
+ */
+void lim_send_dfs_chan_sw_count_update(struct mac_context *mac_ctx,
+				       struct pe_session *session);
+
 /**
  * lim_process_ap_ecsa_timeout() -process ECSA timeout which decrement csa count
  * in beacon and update beacon template in firmware
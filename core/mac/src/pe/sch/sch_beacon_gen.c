@@ -611,6 +611,8 @@ sch_set_fixed_beacon_fields(struct mac_context *mac_ctx, struct pe_session *sess
 					      n_bytes,
 					      &csa_count_offset,
 					      &ecsa_count_offset);
+	session->sch_csa_count_offset = csa_count_offset;
+	session->sch_ecsa_count_offset = ecsa_count_offset;
 
 	if (csa_count_offset)
 		mac_ctx->sch.csa_count_offset =
@@ -655,10 +657,12 @@ sch_set_fixed_beacon_fields(struct mac_context *mac_ctx, struct pe_session *sess
 			extra_ie_offset + p2p_ie_offset;
 	else
 		mac_ctx->sch.p2p_ie_offset = 0;
+	session->sch_p2p_ie_offset = mac_ctx->sch.p2p_ie_offset;
 
 	pe_debug("Initialized beacon end, offset %d",
 		session->schBeaconOffsetEnd);
 	mac_ctx->sch.beacon_changed = 1;
+	mac_ctx->sch.num_bcn_full_update++;
 	qdf_mem_free(bcn_1);
 	qdf_mem_free(bcn_2);
 	qdf_mem_free(wsc_prb_res);
@@ -666,6 +670,68 @@ sch_set_fixed_beacon_fields(struct mac_context *mac_ctx, struct pe_session *sess
 	return QDF_STATUS_SUCCESS;
 }
 
+/**
+ * sch_is_csa_count_patchable() - check a switch count field of the template
+ * @session: pe session entry
+ * @count_offset: offset of the switch count in the trailing portion
+ *
+ * The new channel field precedes the switch count in both the CSA and the
+ * ECSA IE, so it tells whether the cached IE still announces the current
+ * channel switch.
+ *
+ * Return: true if the switch count at @count_offset can be patched
+ */
+static bool sch_is_csa_count_patchable(struct pe_session *session,
+				       uint16_t count_offset)
+{
+	if (!count_offset || count_offset >= session->schBeaconOffsetEnd)
+		return false;
+
+	return session->pSchBeaconFrameEnd[count_offset - 1] ==
+		session->gLimChannelSwitch.primaryChannel;
+}
+
+QDF_STATUS
+sch_patch_csa_count(struct mac_context *mac_ctx, struct pe_session *session)
+{
+	uint16_t csa_offset = session->sch_csa_count_offset;
+	uint16_t ecsa_offset = session->sch_ecsa_count_offset;
+	uint8_t count = session->gLimChannelSwitch.switchCount;
+
+	if (!session->dfsIncludeChanSwIe || (!csa_offset && !ecsa_offset))
+		return QDF_STATUS_E_INVAL;
+
+	if ((csa_offset && !sch_is_csa_count_patchable(session, csa_offset)) ||
+	    (ecsa_offset && !sch_is_csa_count_patchable(session, ecsa_offset)))
+		return QDF_STATUS_E_INVAL;
+
+	if (csa_offset)
+		session->pSchBeaconFrameEnd[csa_offset] = count;
+	if (ecsa_offset)
+		session->pSchBeaconFrameEnd[ecsa_offset] = count;
+
+	if (session->probeRespFrame.ChanSwitchAnn.present)
+		session->probeRespFrame.ChanSwitchAnn.switchCount = count;
+	if (session->probeRespFrame.ext_chan_switch_ann.present)
+		session->probeRespFrame.ext_chan_switch_ann.switch_count =
+									count;
+
+	/* The offsets are global, another session may have overwritten them */
+	mac_ctx->sch.p2p_ie_offset = session->sch_p2p_ie_offset;
+	mac_ctx->sch.csa_count_offset = csa_offset ?
+		session->schBeaconOffsetBegin + TIM_IE_SIZE + csa_offset : 0;
+	mac_ctx->sch.ecsa_count_offset = ecsa_offset ?
+		session->schBeaconOffsetBegin + TIM_IE_SIZE + ecsa_offset : 0;
+
+	mac_ctx->sch.beacon_changed = 1;
+	mac_ctx->sch.num_bcn_patch_update++;
+	pe_debug("Patched switch count %d, beacon updates full %u patched %u",
+		 count, mac_ctx->sch.num_bcn_full_update,
+		 mac_ctx->sch.num_bcn_patch_update);
+
+	return QDF_STATUS_SUCCESS;
+}
+
 QDF_STATUS
 lim_update_probe_rsp_template_ie_bitmap_beacon1(struct mac_context *mac,
 						tDot11fBeacon1 *beacon1,
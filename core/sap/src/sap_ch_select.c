@@ -49,6 +49,7 @@
 #include "pld_common.h"
 #include "wlan_reg_services_api.h"
 #include <wlan_scan_utils_api.h>
+#include "qdf_time.h"
 
 /*--------------------------------------------------------------------------
    Function definitions
@@ -59,6 +60,10 @@
    --------------------------------------------------------------------------*/
 #define SAP_DEBUG
 
+/* Channel numbers are 8 bit, one lookup entry per possible channel */
+#define SAP_ACS_CH_MAP_SIZE 256
+#define SAP_ACS_INVALID_SPECT_IDX 0xFF
+
 #define IS_RSSI_VALID(extRssi, rssi) \
 	( \
 		((extRssi < rssi) ? true : false) \
@@ -1339,170 +1344,278 @@ static bool ch_in_pcl(struct sap_context *sap_ctx, uint8_t channel)
 }
 
 /**
- * sap_compute_spect_weight() - Compute spectrum weight
- * @pSpectInfoParams: Pointer to the tSpectInfoParams structure
- * @mac_handle: Opaque handle to the global MAC context
- * @pResult: Pointer to tScanResultHandle
- * @sap_ctx: Context of the SAP
+ * struct sap_acs_ch_map - lookup tables over the spectrum of one ACS run
+ * @spect_idx: index in the spect ch array per channel number,
+ *             SAP_ACS_INVALID_SPECT_IDX if the channel is not in the spectrum
+ * @acs_ch: bitmap of the channels present in the ACS scan channel list
  *
- * Main function for computing the weight of each channel in the
- * spectrum based on the RSSI value of the BSSes on the channel
- * and number of BSS
+ * Built once per ACS run so that each scan entry reaches the aggregate of
+ * its channel in constant time instead of walking the whole spectrum.
  */
-static void sap_compute_spect_weight(tSapChSelSpectInfo *pSpectInfoParams,
-				     mac_handle_t mac_handle,
-				     qdf_list_t *scan_list,
-				     struct sap_context *sap_ctx)
+struct sap_acs_ch_map {
+	uint8_t spect_idx[SAP_ACS_CH_MAP_SIZE];
+	DECLARE_BITMAP(acs_ch, SAP_ACS_CH_MAP_SIZE);
+};
+
+/**
+ * struct sap_acs_bss_params - operating params of a BSS from its IEs
+ * @ch_width: channel width
+ * @sec_ch_offset: secondary channel offset
+ * @vht_support: BSS has VHT operation IE
+ * @center_freq: center frequency segment 0
+ * @center_freq_2: center frequency segment 1
+ */
+struct sap_acs_bss_params {
+	uint16_t ch_width;
+	uint16_t sec_ch_offset;
+	uint16_t vht_support;
+	uint16_t center_freq;
+	uint16_t center_freq_2;
+};
+
+/**
+ * sap_acs_build_ch_map() - build the per channel lookup tables
+ * @map: map to fill
+ * @spect_info: spectrum of this ACS run
+ * @sap_ctx: SAP context holding the ACS scan channel list
+ *
+ * Return: None
+ */
+static void sap_acs_build_ch_map(struct sap_acs_ch_map *map,
+				 tSapChSelSpectInfo *spect_info,
+				 struct sap_context *sap_ctx)
 {
-	int8_t rssi = 0;
-	uint8_t chn_num = 0;
-	uint8_t channel_id = 0;
-	tSapSpectChInfo *pSpectCh = pSpectInfoParams->pSpectCh;
-	uint32_t operatingBand;
-	uint16_t channelWidth;
-	uint16_t secondaryChannelOffset;
-	uint16_t centerFreq;
 	uint8_t i;
-	bool found;
-	uint16_t centerFreq_2 = 0;
-	uint16_t vhtSupport;
-	tSirProbeRespBeacon *bcn_struct;
-	struct mac_context *mac = MAC_CONTEXT(mac_handle);
-	tSapSpectChInfo *spectch_start = pSpectInfoParams->pSpectCh;
-	tSapSpectChInfo *spectch_end = pSpectInfoParams->pSpectCh +
-		pSpectInfoParams->numSpectChans;
-	qdf_list_node_t *cur_lst = NULL, *next_lst = NULL;
-	struct scan_cache_node *cur_node = NULL;
-	uint32_t normalized_weight;
-	uint8_t normalize_factor;
-
-	bcn_struct = qdf_mem_malloc(sizeof(tSirProbeRespBeacon));
-	if (!bcn_struct)
-		return;
+	uint16_t ch;
+
+	qdf_mem_set(map->spect_idx, sizeof(map->spect_idx),
+		    SAP_ACS_INVALID_SPECT_IDX);
+	bitmap_zero(map->acs_ch, SAP_ACS_CH_MAP_SIZE);
+
+	/* Keep the first entry of a channel, like the linear search did */
+	for (i = 0; i < spect_info->numSpectChans; i++) {
+		ch = spect_info->pSpectCh[i].chNum;
+		if (ch < SAP_ACS_CH_MAP_SIZE &&
+		    map->spect_idx[ch] == SAP_ACS_INVALID_SPECT_IDX)
+			map->spect_idx[ch] = i;
+	}
 
-	QDF_TRACE(QDF_MODULE_ID_SAP, QDF_TRACE_LEVEL_INFO_HIGH,
-		  "In %s, Computing spectral weight", __func__);
+	for (i = 0; i < sap_ctx->num_of_channel; i++)
+		qdf_set_bit(sap_ctx->channelList[i], map->acs_ch);
+}
 
-	/**
-	 * Soft AP specific channel weight calculation using DFS formula
-	 */
-	SET_ACS_BAND(operatingBand, sap_ctx);
+/**
+ * sap_acs_need_bss_params() - check if the IEs of a BSS are needed
+ * @operating_band: ACS band
+ * @ch_num: channel of the BSS
+ *
+ * Only the 5 GHz interference accounting looks at the width of the BSS,
+ * on 2.4 GHz the overlap is derived from the channel number alone.
+ *
+ * Return: true if the beacon IEs have to be parsed
+ */
+static bool sap_acs_need_bss_params(uint32_t operating_band, uint16_t ch_num)
+{
+	switch (operating_band) {
+	case eCSR_DOT11_MODE_11a:
+		return true;
+	case eCSR_DOT11_MODE_abg:
+		return ch_num >= SIR_11A_CHANNEL_BEGIN;
+	default:
+		return false;
+	}
+}
 
-	if (scan_list)
-		qdf_list_peek_front(scan_list, &cur_lst);
-	while (cur_lst) {
-		uint32_t ie_len = 0;
-		uint8_t *ie_ptr;
+/**
+ * sap_acs_parse_bss_params() - get the operating params of a BSS
+ * @mac: Pointer to Global MAC structure
+ * @entry: scan entry of the BSS
+ * @bcn_struct: scratch buffer for the parsed IEs
+ * @params: params to fill, left to the HT20 defaults on parse failure
+ *
+ * Return: None
+ */
+static void sap_acs_parse_bss_params(struct mac_context *mac,
+				     struct scan_cache_entry *entry,
+				     tSirProbeRespBeacon *bcn_struct,
+				     struct sap_acs_bss_params *params)
+{
+	qdf_mem_zero(bcn_struct, sizeof(*bcn_struct));
+
+	if (sir_parse_beacon_ie(mac, bcn_struct,
+				util_scan_entry_ie_data(entry),
+				util_scan_entry_ie_len(entry)) ==
+	    QDF_STATUS_SUCCESS)
+		sap_upd_chan_spec_params(bcn_struct,
+					 &params->ch_width,
+					 &params->sec_ch_offset,
+					 &params->vht_support,
+					 &params->center_freq,
+					 &params->center_freq_2);
+}
 
-		cur_node = qdf_container_of(cur_lst, struct scan_cache_node,
-					    node);
-		pSpectCh = pSpectInfoParams->pSpectCh;
-		/* Defining the default values, so that any value will hold the default values */
-		channelWidth = eHT_CHANNEL_WIDTH_20MHZ;
-		secondaryChannelOffset = PHY_SINGLE_CHANNEL_CENTERED;
-		vhtSupport = 0;
-		centerFreq = 0;
-
-		ie_len = util_scan_entry_ie_len(cur_node->entry);
-		ie_ptr = util_scan_entry_ie_data(cur_node->entry);
-		qdf_mem_zero((uint8_t *)bcn_struct,
-			     sizeof(tSirProbeRespBeacon));
-
-		if ((sir_parse_beacon_ie(mac, bcn_struct, ie_ptr, ie_len)) ==
-		     QDF_STATUS_SUCCESS)
-			sap_upd_chan_spec_params(
-				bcn_struct,
-				&channelWidth,
-				&secondaryChannelOffset,
-				&vhtSupport, &centerFreq,
-				&centerFreq_2);
-
-		/* Processing for each tCsrScanResultInfo in the tCsrScanResult DLink list */
-		for (chn_num = 0; chn_num < pSpectInfoParams->numSpectChans;
-		     chn_num++) {
-
-			channel_id =
-				util_scan_entry_channel_num(cur_node->entry);
-
-			if (pSpectCh && (channel_id == pSpectCh->chNum)) {
-				if (pSpectCh->rssiAgr <
-				    cur_node->entry->rssi_raw)
-					pSpectCh->rssiAgr =
-						cur_node->entry->rssi_raw;
-
-				++pSpectCh->bssCount;   /* Increment the count of BSS */
+/**
+ * sap_acs_init_bss_params() - set the HT20 defaults of a BSS
+ * @params: params to initialize
+ *
+ * Return: None
+ */
+static void sap_acs_init_bss_params(struct sap_acs_bss_params *params)
+{
+	params->ch_width = eHT_CHANNEL_WIDTH_20MHZ;
+	params->sec_ch_offset = PHY_SINGLE_CHANNEL_CENTERED;
+	params->vht_support = 0;
+	params->center_freq = 0;
+	params->center_freq_2 = 0;
+}
 
-				/*
-				 * Connsidering the Extension Channel
-				 * only in a channels
-				 */
-				switch (operatingBand) {
-				case eCSR_DOT11_MODE_11a:
-					sap_interference_rssi_count_5G(
-					    pSpectCh, channelWidth,
-					    secondaryChannelOffset,
-					    centerFreq,
-					    centerFreq_2,
-					    channel_id,
-					    spectch_start,
-					    spectch_end);
-					break;
+/**
+ * sap_acs_update_ch_aggr() - account one BSS in the channel aggregates
+ * @spect_ch: channel the BSS operates on
+ * @entry: scan entry of the BSS
+ * @params: operating params of the BSS
+ * @operating_band: ACS band
+ * @spectch_start: the start of spect ch array
+ * @spectch_end: the end of spect ch array
+ *
+ * Return: None
+ */
+static void sap_acs_update_ch_aggr(tSapSpectChInfo *spect_ch,
+				   struct scan_cache_entry *entry,
+				   struct sap_acs_bss_params *params,
+				   uint32_t operating_band,
+				   tSapSpectChInfo *spectch_start,
+				   tSapSpectChInfo *spectch_end)
+{
+	uint8_t channel_id = util_scan_entry_channel_num(entry);
+
+	if (spect_ch->rssiAgr < entry->rssi_raw)
+		spect_ch->rssiAgr = entry->rssi_raw;
+
+	++spect_ch->bssCount;   /* Increment the count of BSS */
+
+	/* Connsidering the Extension Channel only in a channels */
+	switch (operating_band) {
+	case eCSR_DOT11_MODE_11a:
+		sap_interference_rssi_count_5G(spect_ch, params->ch_width,
+					       params->sec_ch_offset,
+					       params->center_freq,
+					       params->center_freq_2,
+					       channel_id,
+					       spectch_start, spectch_end);
+		break;
 
-				case eCSR_DOT11_MODE_11g:
-					sap_interference_rssi_count(pSpectCh,
-						spectch_start, spectch_end);
-					break;
+	case eCSR_DOT11_MODE_11g:
+		sap_interference_rssi_count(spect_ch,
+					    spectch_start, spectch_end);
+		break;
 
-				case eCSR_DOT11_MODE_abg:
-					if (pSpectCh->chNum >=
-					    SIR_11A_CHANNEL_BEGIN)
-						sap_interference_rssi_count_5G(
-						    pSpectCh, channelWidth,
-						    secondaryChannelOffset,
-						    centerFreq,
-						    centerFreq_2,
-						    channel_id,
-						    spectch_start,
-						    spectch_end);
-					else
-						sap_interference_rssi_count(
-						    pSpectCh,
+	case eCSR_DOT11_MODE_abg:
+		if (spect_ch->chNum >= SIR_11A_CHANNEL_BEGIN)
+			sap_interference_rssi_count_5G(spect_ch,
+						       params->ch_width,
+						       params->sec_ch_offset,
+						       params->center_freq,
+						       params->center_freq_2,
+						       channel_id,
+						       spectch_start,
+						       spectch_end);
+		else
+			sap_interference_rssi_count(spect_ch,
 						    spectch_start,
 						    spectch_end);
-					break;
-				}
+		break;
+	}
 
-				QDF_TRACE(QDF_MODULE_ID_SAP,
-					  QDF_TRACE_LEVEL_INFO_HIGH,
-					  "In %s, channel_id=%d, bssdes.rssi=%d, SpectCh.bssCount=%d, ChannelWidth %d, secondaryChanOffset %d, center frequency %d",
-					  __func__,
-					  channel_id,
-					  cur_node->entry->rssi_raw,
-					  pSpectCh->bssCount,
-					  pSpectCh->channelWidth,
-					  secondaryChannelOffset, centerFreq);
-				pSpectCh++;
-				break;
-			} else {
-				pSpectCh++;
-			}
+	QDF_TRACE(QDF_MODULE_ID_SAP, QDF_TRACE_LEVEL_INFO_HIGH,
+		  "In %s, channel_id=%d, bssdes.rssi=%d, SpectCh.bssCount=%d, ChannelWidth %d, secondaryChanOffset %d, center frequency %d",
+		  __func__, channel_id, entry->rssi_raw, spect_ch->bssCount,
+		  spect_ch->channelWidth, params->sec_ch_offset,
+		  params->center_freq);
+}
+
+/**
+ * sap_acs_aggregate_scan_list() - fold the scan list into the spectrum
+ * @spect_info: spectrum of this ACS run
+ * @mac: Pointer to Global MAC structure
+ * @scan_list: scan results
+ * @map: channel lookup tables of @spect_info
+ * @operating_band: ACS band
+ * @bcn_struct: scratch buffer for the parsed IEs
+ *
+ * Each scan entry is applied to the aggregates of its channel and of the
+ * overlapping channels in one step. Entries on channels outside of the
+ * spectrum are skipped before their IEs are parsed, and the IEs are only
+ * parsed when the interference accounting of the band uses them.
+ *
+ * Return: None
+ */
+static void sap_acs_aggregate_scan_list(tSapChSelSpectInfo *spect_info,
+					struct mac_context *mac,
+					qdf_list_t *scan_list,
+					struct sap_acs_ch_map *map,
+					uint32_t operating_band,
+					tSirProbeRespBeacon *bcn_struct)
+{
+	tSapSpectChInfo *spectch_start = spect_info->pSpectCh;
+	tSapSpectChInfo *spectch_end = spect_info->pSpectCh +
+		spect_info->numSpectChans;
+	qdf_list_node_t *cur_lst = NULL, *next_lst = NULL;
+	struct scan_cache_node *cur_node;
+	struct sap_acs_bss_params params;
+	tSapSpectChInfo *spect_ch;
+	uint8_t channel_id, idx;
+
+	if (scan_list)
+		qdf_list_peek_front(scan_list, &cur_lst);
+	while (cur_lst) {
+		cur_node = qdf_container_of(cur_lst, struct scan_cache_node,
+					    node);
+		channel_id = util_scan_entry_channel_num(cur_node->entry);
+		idx = map->spect_idx[channel_id];
+		if (idx != SAP_ACS_INVALID_SPECT_IDX) {
+			spect_ch = &spect_info->pSpectCh[idx];
+			sap_acs_init_bss_params(&params);
+			if (sap_acs_need_bss_params(operating_band,
+						    spect_ch->chNum))
+				sap_acs_parse_bss_params(mac, cur_node->entry,
+							 bcn_struct, &params);
+			sap_acs_update_ch_aggr(spect_ch, cur_node->entry,
+					       &params, operating_band,
+					       spectch_start, spectch_end);
 		}
 
 		qdf_list_peek_next(scan_list, cur_lst, &next_lst);
 		cur_lst = next_lst;
 		next_lst = NULL;
 	}
+}
 
-	qdf_mem_free(bcn_struct);
-
-	/* Calculate the weights for all channels in the spectrum pSpectCh */
-	pSpectCh = pSpectInfoParams->pSpectCh;
+/**
+ * sap_acs_compute_ch_weights() - compute the weight of each channel
+ * @spect_info: spectrum of this ACS run, aggregates already filled
+ * @mac: Pointer to Global MAC structure
+ * @sap_ctx: Context of the SAP
+ * @map: channel lookup tables of @spect_info
+ *
+ * Return: None
+ */
+static void sap_acs_compute_ch_weights(tSapChSelSpectInfo *spect_info,
+				       struct mac_context *mac,
+				       struct sap_context *sap_ctx,
+				       struct sap_acs_ch_map *map)
+{
+	tSapSpectChInfo *pSpectCh = spect_info->pSpectCh;
+	uint32_t normalized_weight;
+	uint8_t normalize_factor;
+	uint8_t chn_num;
+	int8_t rssi;
 
 	QDF_TRACE(QDF_MODULE_ID_SAP, QDF_TRACE_LEVEL_INFO_HIGH,
 		  "In %s, Spectrum Channels Weight", __func__);
 
-	for (chn_num = 0; chn_num < (pSpectInfoParams->numSpectChans);
-	     chn_num++) {
+	for (chn_num = 0; chn_num < spect_info->numSpectChans;
+	     chn_num++, pSpectCh++) {
 
 		/*
 		   rssi : Maximum received signal strength among all BSS on that channel
@@ -1530,16 +1643,8 @@ static void sap_compute_spect_weight(tSapChSelSpectInfo *pSpectInfoParams,
 		 * to them, so that they always stay low in sorting of best
 		 * channles which were included in ACS scan list
 		 */
-		found = false;
-		for (i = 0; i < sap_ctx->num_of_channel; i++) {
-			if (pSpectCh->chNum == sap_ctx->channelList[i]) {
-			/* Scan channel was included in ACS scan list */
-				found = true;
-				break;
-			}
-		}
-
-		if (found)
+		if (pSpectCh->chNum < SAP_ACS_CH_MAP_SIZE &&
+		    qdf_test_bit(pSpectCh->chNum, map->acs_ch))
 			pSpectCh->weight =
 				SAPDFS_NORMALISE_1000 *
 				(sapweight_rssi_count(sap_ctx, rssi,
@@ -1582,8 +1687,57 @@ debug_info:
 					  pSpectCh->rssiAgr,
 					  pSpectCh->bssCount);
 		/* ------ Debug Info ------ */
-		pSpectCh++;
 	}
+}
+
+/**
+ * sap_compute_spect_weight() - Compute spectrum weight
+ * @pSpectInfoParams: Pointer to the tSpectInfoParams structure
+ * @mac_handle: Opaque handle to the global MAC context
+ * @pResult: Pointer to tScanResultHandle
+ * @sap_ctx: Context of the SAP
+ *
+ * Main function for computing the weight of each channel in the
+ * spectrum based on the RSSI value of the BSSes on the channel
+ * and number of BSS
+ */
+static void sap_compute_spect_weight(tSapChSelSpectInfo *pSpectInfoParams,
+				     mac_handle_t mac_handle,
+				     qdf_list_t *scan_list,
+				     struct sap_context *sap_ctx)
+{
+	struct mac_context *mac = MAC_CONTEXT(mac_handle);
+	tSirProbeRespBeacon *bcn_struct;
+	struct sap_acs_ch_map *map;
+	uint32_t operatingBand;
+
+	bcn_struct = qdf_mem_malloc(sizeof(tSirProbeRespBeacon));
+	if (!bcn_struct)
+		return;
+
+	map = qdf_mem_malloc(sizeof(*map));
+	if (!map) {
+		qdf_mem_free(bcn_struct);
+		return;
+	}
+
+	QDF_TRACE(QDF_MODULE_ID_SAP, QDF_TRACE_LEVEL_INFO_HIGH,
+		  "In %s, Computing spectral weight", __func__);
+
+	/**
+	 * Soft AP specific channel weight calculation using DFS formula
+	 */
+	SET_ACS_BAND(operatingBand, sap_ctx);
+
+	sap_acs_build_ch_map(map, pSpectInfoParams, sap_ctx);
+	sap_acs_aggregate_scan_list(pSpectInfoParams, mac, scan_list, map,
+				    operatingBand, bcn_struct);
+	qdf_mem_free(bcn_struct);
+
+	/* Calculate the weights for all channels in the spectrum pSpectCh */
+	sap_acs_compute_ch_weights(pSpectInfoParams, mac, sap_ctx, map);
+	qdf_mem_free(map);
+
 	sap_clear_channel_status(mac);
 }
 
@@ -1613,53 +1767,82 @@ static void sap_chan_sel_exit(tSapChSelSpectInfo *pSpectInfoParams)
 	qdf_mem_free(pSpectInfoParams->pSpectCh);
 }
 
-/*==========================================================================
-   FUNCTION    sap_sort_chl_weight
-
-   DESCRIPTION
-    Function to sort the channels with the least weight first for 20MHz channels
-
-   DEPENDENCIES
-    NA.
-
-   PARAMETERS
+/**
+ * sap_acs_ch_before() - ordering of the channels in the sorted spectrum
+ * @a: channel info
+ * @b: channel info
+ *
+ * Lesser weight first, then lesser number of BSS. Remaining ties go to the
+ * lower channel so that the order does not depend on the sort. The former
+ * selection sort left such ties in an order set by its swaps, so among
+ * channels of equal weight and BSS count a different one may now come
+ * first.
+ *
+ * Return: true if @a is to be placed before @b
+ */
+static bool sap_acs_ch_before(tSapSpectChInfo *a, tSapSpectChInfo *b)
+{
+	if (a->weight != b->weight)
+		return a->weight < b->weight;
+	if (a->bssCount != b->bssCount)
+		return a->bssCount < b->bssCount;
+	return a->chNum < b->chNum;
+}
 
-    IN
-    pSpectInfoParams       : Pointer to the tSapChSelSpectInfo structure
+/**
+ * sap_acs_ch_heap_sift() - restore the heap below a node
+ * @spect_ch: heap of channels, the worst channel on top
+ * @root: node to sift down
+ * @num_ch: number of channels in the heap
+ *
+ * Return: None
+ */
+static void sap_acs_ch_heap_sift(tSapSpectChInfo *spect_ch, uint32_t root,
+				 uint32_t num_ch)
+{
+	tSapSpectChInfo temp;
+	uint32_t child;
 
-   RETURN VALUE
-    void     : NULL
+	while ((child = 2 * root + 1) < num_ch) {
+		if (child + 1 < num_ch &&
+		    sap_acs_ch_before(&spect_ch[child], &spect_ch[child + 1]))
+			child++;
+		if (!sap_acs_ch_before(&spect_ch[root], &spect_ch[child]))
+			return;
+		temp = spect_ch[root];
+		spect_ch[root] = spect_ch[child];
+		spect_ch[child] = temp;
+		root = child;
+	}
+}
 
-   SIDE EFFECTS
-   ============================================================================*/
+/**
+ * sap_sort_chl_weight() - sort the channels with the least weight first
+ * @pSpectInfoParams: Pointer to the tSapChSelSpectInfo structure
+ *
+ * Heap sort of the spectrum, shared by all the channel widths once their
+ * bonded weights are applied.
+ *
+ * Return: None
+ */
 static void sap_sort_chl_weight(tSapChSelSpectInfo *pSpectInfoParams)
 {
+	tSapSpectChInfo *pSpectCh = pSpectInfoParams->pSpectCh;
+	uint32_t num_ch = pSpectInfoParams->numSpectChans;
 	tSapSpectChInfo temp;
+	uint32_t i;
 
-	tSapSpectChInfo *pSpectCh = NULL;
-	uint32_t i = 0, j = 0, minWeightIndex = 0;
+	if (num_ch < 2)
+		return;
 
-	pSpectCh = pSpectInfoParams->pSpectCh;
-	for (i = 0; i < pSpectInfoParams->numSpectChans; i++) {
-		minWeightIndex = i;
-		for (j = i + 1; j < pSpectInfoParams->numSpectChans; j++) {
-			if (pSpectCh[j].weight <
-			    pSpectCh[minWeightIndex].weight) {
-				minWeightIndex = j;
-			} else if (pSpectCh[j].weight ==
-				   pSpectCh[minWeightIndex].weight) {
-				if (pSpectCh[j].bssCount <
-				    pSpectCh[minWeightIndex].bssCount)
-					minWeightIndex = j;
-			}
-		}
-		if (minWeightIndex != i) {
-			qdf_mem_copy(&temp, &pSpectCh[minWeightIndex],
-				     sizeof(*pSpectCh));
-			qdf_mem_copy(&pSpectCh[minWeightIndex], &pSpectCh[i],
-				     sizeof(*pSpectCh));
-			qdf_mem_copy(&pSpectCh[i], &temp, sizeof(*pSpectCh));
-		}
+	for (i = num_ch / 2; i > 0; i--)
+		sap_acs_ch_heap_sift(pSpectCh, i - 1, num_ch);
+
+	for (i = num_ch - 1; i > 0; i--) {
+		temp = pSpectCh[0];
+		pSpectCh[0] = pSpectCh[i];
+		pSpectCh[i] = temp;
+		sap_acs_ch_heap_sift(pSpectCh, 0, i);
 	}
 }
 
@@ -2420,6 +2603,7 @@ uint8_t sap_select_channel(mac_handle_t mac_handle,
 			  FL("Ch Select initialization failed"));
 		return SAP_CHANNEL_NOT_SELECTED;
 	}
+
 	/* Compute the weight of the entire spectrum in the operating band */
 	sap_compute_spect_weight(spect_info, mac_handle, scan_list, sap_ctx);
 
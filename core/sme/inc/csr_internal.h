@@ -419,6 +419,28 @@ struct csr_roam_joinstatus {
 	tSirMacAddr bssId;
 };
 
+/**
+ * struct csr_scan_result_stats - cost of the scan result queries
+ * @num_query: csr_scan_get_result() calls which found matching entries
+ * @num_entries: scan entries matching the scan filters
+ * @num_converted: entries converted to a csr scan result
+ * @num_skipped: entries dropped without a csr scan result
+ * @filter_us: time spent getting the filtered scan entries
+ * @blm_us: time spent in the blacklist manager filter
+ * @convert_us: time spent converting the entries
+ * @max_us: longest query
+ */
+struct csr_scan_result_stats {
+	uint32_t num_query;
+	uint32_t num_entries;
+	uint32_t num_converted;
+	uint32_t num_skipped;
+	uint64_t filter_us;
+	uint64_t blm_us;
+	uint64_t convert_us;
+	uint64_t max_us;
+};
+
 struct csr_scanstruct {
 	tSirScanType curScanType;
 	struct csr_channel channels11d;
@@ -455,6 +477,7 @@ struct csr_scanstruct {
 	bool fcc_constraint;
 	bool pending_channel_list_req;
 	wlan_scan_requester requester_id;
+	struct csr_scan_result_stats result_stats;
 };
 
 /*
@@ -33,9 +33,17 @@
 #define LL_ACCESS_LOCK          true
 #define LL_ACCESS_NOLOCK        false
 
+/**
+ * struct tagListElem - link of an entry in a tDblLinkList
+ * @last: previous entry
+ * @next: next entry
+ * @owner: list the entry is linked in, NULL when not linked; gives the
+ *	membership check of find/next/previous/remove in constant time
+ */
 typedef struct tagListElem {
 	struct tagListElem *last;
 	struct tagListElem *next;
+	struct tagDblLinkList *owner;
 } tListElem;
 
 typedef enum {
@@ -90,6 +90,47 @@ typedef struct sCsrNeighborRoamBSSInfo {
 	struct bss_description *pBssDescription;
 } tCsrNeighborRoamBSSInfo, *tpCsrNeighborRoamBSSInfo;
 
+/* Number of candidates whose score components are cached per session */
+#define CSR_ROAM_SCORE_CACHE_SIZE 32
+
+/**
+ * struct csr_roam_score_entry - cached score components of a candidate
+ * @bssid: BSSID of the candidate
+ * @valid: entry holds the components of @bssid
+ * @chan: channel @band_pcnt was computed for
+ * @rssi: RSSI @rssi_pcnt was computed for
+ * @num_bss_on_chan: BSS count of the channel @congestion_pcnt was
+ *	computed for
+ * @band_pcnt: percentage of the band weightage for the channel
+ * @rssi_pcnt: percentage of the RSSI weightage for the RSSI
+ * @congestion_pcnt: percentage of the channel congestion weightage for the
+ *	number of BSS sharing the channel
+ */
+struct csr_roam_score_entry {
+	struct qdf_mac_addr bssid;
+	bool valid;
+	uint8_t chan;
+	int8_t rssi;
+	uint8_t num_bss_on_chan;
+	uint8_t band_pcnt;
+	uint8_t rssi_pcnt;
+	uint8_t congestion_pcnt;
+};
+
+/**
+ * struct csr_roam_score_cache - per session cache of candidate scores
+ * @entry: direct mapped entries, indexed by a hash of the BSSID
+ * @hits: candidates scored without recomputing any component
+ * @partial: candidates for which only the changed components were computed
+ * @misses: candidates scored from scratch
+ */
+struct csr_roam_score_cache {
+	struct csr_roam_score_entry entry[CSR_ROAM_SCORE_CACHE_SIZE];
+	uint32_t hits;
+	uint32_t partial;
+	uint32_t misses;
+};
+
 #define CSR_NEIGHBOR_ROAM_REPORT_QUERY_TIMEOUT  1000       /* in milliseconds */
 /* Max number of MAC addresses with which the pre-auth was failed */
 #define MAX_NUM_PREAUTH_FAIL_LIST_ADDRESS          10
@@ -125,6 +166,7 @@ typedef struct sCsr11rAssocNeighborInfo {
  *			 driver/firmware successfully. The same shall be
  *			 returned to userspace whenever queried for roam
  *			 control config status.
+ * @score_cache: score components of the candidates of the previous scans
  */
 typedef struct sCsrNeighborRoamControlInfo {
 	eCsrNeighborRoamState neighborRoamState;
@@ -161,6 +203,7 @@ typedef struct sCsrNeighborRoamControlInfo {
 	uint8_t last_sent_cmd;
 	struct scan_result_list *scan_res_lfr2_roam_ap;
 	bool roam_control_enable;
+	struct csr_roam_score_cache score_cache;
 } tCsrNeighborRoamControlInfo, *tpCsrNeighborRoamControlInfo;
 
 /* All the necessary Function declarations are here */
@@ -199,6 +242,8 @@ bool csr_neighbor_roam_is_handoff_in_progress(struct mac_context *mac,
 void csr_neighbor_roam_reset_preauth_control_info(
 		struct mac_context *mac_ctx, uint8_t session_id);
 void csr_neighbor_roam_purge_preauth_failed_list(struct mac_context *mac);
+void csr_neighbor_roam_score_cache_reset(struct mac_context *mac_ctx,
+					 uint8_t session_id);
 #else
 static inline bool csr_neighbor_roam_state_preauth_done(struct mac_context *mac,
 		uint8_t sessionId)
@@ -241,6 +286,9 @@ static inline void csr_neighbor_roam_reset_preauth_control_info(
 static inline void csr_neighbor_roam_purge_preauth_failed_list(
 		struct mac_context *mac)
 {}
+static inline void csr_neighbor_roam_score_cache_reset(
+		struct mac_context *mac_ctx, uint8_t session_id)
+{}
 static inline bool csr_neighbor_roam_get_handoff_ap_info(struct mac_context *mac,
 		tpCsrNeighborRoamBSSInfo pHandoffNode, uint8_t sessionId)
 {
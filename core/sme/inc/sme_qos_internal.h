@@ -58,6 +58,7 @@ typedef enum {
 	SME_QOS_CSR_HANDOFF_COMPLETE,
 	SME_QOS_CSR_PREAUTH_SUCCESS_IND,
 	SME_QOS_CSR_SET_KEY_SUCCESS_IND,
+	SME_QOS_CSR_EVENT_MAX
 } sme_qos_csr_event_indType;
 
 #ifdef FEATURE_WLAN_DIAG_SUPPORT
@@ -50,6 +50,7 @@
 #include "wlan_reg_services_api.h"
 #include "sch_api.h"
 #include "wlan_blm_api.h"
+#include "qdf_time.h"
 
 static void csr_set_cfg_valid_channel_list(struct mac_context *mac,
 					   uint8_t *pChannelList,
@@ -1476,6 +1477,8 @@ static void csr_set_cfg_valid_channel_list(struct mac_context *mac,
 	qdf_mem_copy(mac->mlme_cfg->reg.valid_channel_list, pChannelList,
 		     NumChannels);
 	mac->mlme_cfg->reg.valid_channel_list_num = NumChannels;
+	/* PCL is derived from the valid channel list */
+	policy_mgr_pcl_cache_invalidate(mac->psoc);
 
 	QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
 		  "Scan offload is enabled, update default chan list");
@@ -2552,6 +2555,7 @@ csr_fill_single_pmk_ap_cap_from_scan_entry(struct bss_description *bss_desc,
 #endif
 static QDF_STATUS csr_fill_bss_from_scan_entry(struct mac_context *mac_ctx,
 					struct scan_cache_entry *scan_entry,
+					bool assoc_disallowed,
 					struct tag_csrscan_result **p_result)
 {
 	tDot11fBeaconIEs *bcn_ies;
@@ -2648,8 +2652,7 @@ static QDF_STATUS csr_fill_bss_from_scan_entry(struct mac_context *mac_ctx,
 			  MGMT_SUBTYPE_PROBE_RESP);
 	bss_desc->seq_ctrl = hdr->seqControl;
 	bss_desc->tsf_delta = scan_entry->tsf_delta;
-	bss_desc->assoc_disallowed = csr_is_assoc_disallowed(mac_ctx,
-							     scan_entry);
+	bss_desc->assoc_disallowed = assoc_disallowed;
 	bss_desc->adaptive_11r_ap = scan_entry->adaptive_11r_ap;
 
 	bss_desc->mbo_oce_enabled_ap =
@@ -2699,13 +2702,29 @@ static QDF_STATUS csr_fill_bss_from_scan_entry(struct mac_context *mac_ctx,
 	return QDF_STATUS_SUCCESS;
 }
 
+/**
+ * csr_parse_scan_list() - convert the filtered scan entries to csr results
+ * @mac_ctx: mac context
+ * @ret_list: list to add the converted results to
+ * @scan_list: scan entries matching the scan filter
+ * @skip_assoc_disallowed: drop the APs which disallow association
+ *
+ * Entries which can't be candidates are dropped before the csr result is
+ * allocated and its IEs are parsed, only the matching entries are
+ * converted.
+ *
+ * Return: QDF_STATUS
+ */
 static QDF_STATUS csr_parse_scan_list(struct mac_context *mac_ctx,
 				      struct scan_result_list *ret_list,
-				      qdf_list_t *scan_list)
+				      qdf_list_t *scan_list,
+				      bool skip_assoc_disallowed)
 {
+	struct csr_scan_result_stats *stats = &mac_ctx->scan.result_stats;
 	struct tag_csrscan_result *pResult = NULL;
 	struct scan_cache_node *cur_node = NULL;
 	struct scan_cache_node *next_node = NULL;
+	bool assoc_disallowed;
 
 	qdf_list_peek_front(scan_list, (qdf_list_node_t **) &cur_node);
 
@@ -2713,11 +2732,24 @@ static QDF_STATUS csr_parse_scan_list(struct mac_context *mac_ctx,
 		qdf_list_peek_next(scan_list, (qdf_list_node_t *) cur_node,
 				  (qdf_list_node_t **) &next_node);
 		pResult = NULL;
-		csr_fill_bss_from_scan_entry(mac_ctx,
-					     cur_node->entry, &pResult);
-		if (pResult)
+		assoc_disallowed = csr_is_assoc_disallowed(mac_ctx,
+							   cur_node->entry);
+		if (skip_assoc_disallowed && assoc_disallowed &&
+		    !mac_ctx->ignore_assoc_disallowed) {
+			stats->num_skipped++;
+			goto next;
+		}
+
+		csr_fill_bss_from_scan_entry(mac_ctx, cur_node->entry,
+					     assoc_disallowed, &pResult);
+		if (pResult) {
 			csr_ll_insert_tail(&ret_list->List, &pResult->Link,
 					   LL_ACCESS_NOLOCK);
+			stats->num_converted++;
+		} else {
+			stats->num_skipped++;
+		}
+next:
 		cur_node = next_node;
 		next_node = NULL;
 	}
@@ -2726,39 +2758,35 @@ static QDF_STATUS csr_parse_scan_list(struct mac_context *mac_ctx,
 }
 
 /**
- * csr_remove_ap_with_assoc_disallowed() - Remove APs with assoc
- * disallowed bit set
+ * csr_scan_result_stats_update() - account the time of a scan result query
  * @mac_ctx: mac context
- * @scan_list: candidate list for the connection
+ * @num_entries: scan entries matching the scan filter
+ * @filter_us: time spent getting the filtered scan entries
+ * @blm_us: time spent in the blacklist manager filter
+ * @convert_us: time spent converting the entries
  *
  * Return: None
  */
-static void csr_remove_ap_with_assoc_disallowed(struct mac_context *mac_ctx,
-					     struct scan_result_list *scan_list)
+static void csr_scan_result_stats_update(struct mac_context *mac_ctx,
+					 uint32_t num_entries,
+					 uint64_t filter_us, uint64_t blm_us,
+					 uint64_t convert_us)
 {
-	tListElem *cur_entry;
-	tListElem *next_entry;
-	struct tag_csrscan_result *scan_res;
+	struct csr_scan_result_stats *stats = &mac_ctx->scan.result_stats;
+	uint64_t total_us = filter_us + blm_us + convert_us;
 
-	if (!scan_list)
-		return;
+	stats->num_query++;
+	stats->num_entries += num_entries;
+	stats->filter_us += filter_us;
+	stats->blm_us += blm_us;
+	stats->convert_us += convert_us;
+	if (total_us > stats->max_us)
+		stats->max_us = total_us;
 
-	cur_entry = csr_ll_peek_head(&scan_list->List, LL_ACCESS_NOLOCK);
-	while (cur_entry) {
-		scan_res = GET_BASE_ADDR(cur_entry, struct tag_csrscan_result,
-					 Link);
-		next_entry = csr_ll_next(&scan_list->List, cur_entry,
-					 LL_ACCESS_NOLOCK);
-
-		if (!mac_ctx->ignore_assoc_disallowed &&
-		    scan_res->Result.BssDescriptor.assoc_disallowed) {
-			csr_ll_remove_entry(&scan_list->List, cur_entry,
-					    LL_ACCESS_NOLOCK);
-			csr_free_scan_result_entry(mac_ctx, scan_res);
-		}
-		cur_entry = next_entry;
-		next_entry = NULL;
-	}
+	sme_debug("candidates: %u entries in %llu us (filter %llu blm %llu convert %llu); total %u queries, %u entries, %u converted, %u skipped, max %llu us",
+		  num_entries, total_us, filter_us, blm_us, convert_us,
+		  stats->num_query, stats->num_entries, stats->num_converted,
+		  stats->num_skipped, stats->max_us);
 }
 
 QDF_STATUS csr_scan_get_result(struct mac_context *mac_ctx,
@@ -2771,6 +2799,8 @@ QDF_STATUS csr_scan_get_result(struct mac_context *mac_ctx,
 	struct scan_filter *filter = NULL;
 	struct wlan_objmgr_pdev *pdev = NULL;
 	uint32_t num_bss = 0;
+	uint64_t start_us, filter_us, blm_us = 0, convert_us = 0;
+	bool sta_persona = pFilter && pFilter->csrPersona == QDF_STA_MODE;
 
 	if (results)
 		*results = CSR_INVALID_SCANRESULT_HANDLE;
@@ -2796,15 +2826,20 @@ QDF_STATUS csr_scan_get_result(struct mac_context *mac_ctx,
 		}
 	}
 
+	start_us = qdf_get_log_timestamp_usecs();
 	list = ucfg_scan_get_result(pdev,
 		    pFilter ? filter : NULL);
+	filter_us = qdf_get_log_timestamp_usecs() - start_us;
 	if (list) {
 		num_bss = qdf_list_size(list);
 		sme_debug("num_entries %d", num_bss);
 	}
 	/* Filter the scan list with the blacklist, rssi reject, avoided APs */
-	if (pFilter && pFilter->csrPersona == QDF_STA_MODE)
+	if (sta_persona) {
+		start_us = qdf_get_log_timestamp_usecs();
 		wlan_blm_filter_bssid(pdev, list);
+		blm_us = qdf_get_log_timestamp_usecs() - start_us;
+	}
 
 	if (!list || (list && !qdf_list_size(list))) {
 		sme_debug("scan list empty");
@@ -2823,14 +2858,15 @@ QDF_STATUS csr_scan_get_result(struct mac_context *mac_ctx,
 
 	csr_ll_open(&ret_list->List);
 	ret_list->pCurEntry = NULL;
-	status = csr_parse_scan_list(mac_ctx, ret_list, list);
+	start_us = qdf_get_log_timestamp_usecs();
+	status = csr_parse_scan_list(mac_ctx, ret_list, list, sta_persona);
+	convert_us = qdf_get_log_timestamp_usecs() - start_us;
+	csr_scan_result_stats_update(mac_ctx, num_bss, filter_us, blm_us,
+				     convert_us);
 	if (QDF_IS_STATUS_ERROR(status) || !results)
 		/* Fail or No one wants the result. */
 		csr_scan_result_purge(mac_ctx, (tScanResultHandle) ret_list);
 	else {
-		if (pFilter && pFilter->csrPersona == QDF_STA_MODE)
-			csr_remove_ap_with_assoc_disallowed(mac_ctx, ret_list);
-
 		if (!csr_ll_count(&ret_list->List)) {
 			/* This mean that there is no match */
 			csr_ll_close(&ret_list->List);
@@ -33,6 +33,7 @@
 #include "csr_neighbor_roam.h"
 #include "mac_trace.h"
 #include "wlan_policy_mgr_api.h"
+#include "wlan_reg_services_api.h"
 
 /**
  * csr_roam_issue_reassociate() - Issue Reassociate
@@ -143,6 +144,278 @@ QDF_STATUS csr_roam_issue_reassociate_cmd(struct mac_context *mac,
 	return status;
 }
 
+#define CSR_ROAM_SCORE_MAX_BSS_ON_CHAN	9
+#define CSR_ROAM_SCORE_MAX_CHAN		256
+#define CSR_ROAM_SCORE_MAX_PCNT		100
+#define CSR_ROAM_SCORE_BAND_IDX_2G	0
+#define CSR_ROAM_SCORE_BAND_IDX_5G	1
+
+/**
+ * csr_roam_score_rssi_slot_pcnt() - RSSI percentage within a segment
+ * @high: upper RSSI of the segment in dBm
+ * @low: lower RSSI of the segment in dBm
+ * @high_pcnt: percentage at @high
+ * @low_pcnt: percentage at @low
+ * @bucket_size: RSSI width of one slot of the segment
+ * @rssi: RSSI of the candidate, between @low and @high
+ *
+ * Return: percentage of the slot @rssi falls in
+ */
+static uint8_t csr_roam_score_rssi_slot_pcnt(int32_t high, int32_t low,
+					     uint32_t high_pcnt,
+					     uint32_t low_pcnt,
+					     uint32_t bucket_size,
+					     int32_t rssi)
+{
+	int32_t num_slot, slot;
+
+	if (!bucket_size)
+		bucket_size = 1;
+	if (high_pcnt < low_pcnt)
+		high_pcnt = low_pcnt;
+
+	num_slot = (high - low) / (int32_t)bucket_size + 1;
+	slot = (high - rssi) / (int32_t)bucket_size;
+
+	return high_pcnt - (high_pcnt - low_pcnt) * slot / num_slot;
+}
+
+/**
+ * csr_roam_score_rssi_pcnt() - RSSI percentage of a candidate
+ * @rssi_cfg: RSSI scoring config of the BSS scoring ini
+ * @rssi: RSSI of the candidate in dBm
+ *
+ * Full score above best_rssi_threshold, then decreasing per bucket down to
+ * good_rssi_pcnt at good_rssi_threshold and bad_rssi_pcnt at
+ * bad_rssi_threshold.
+ *
+ * Return: percentage out of the RSSI weightage
+ */
+static uint8_t
+csr_roam_score_rssi_pcnt(struct wlan_mlme_rssi_cfg_score *rssi_cfg,
+			 int8_t rssi)
+{
+	int32_t best = -(int32_t)rssi_cfg->best_rssi_threshold;
+	int32_t good = -(int32_t)rssi_cfg->good_rssi_threshold;
+	int32_t bad = -(int32_t)rssi_cfg->bad_rssi_threshold;
+
+	if (rssi > best)
+		return CSR_ROAM_SCORE_MAX_PCNT;
+	if (rssi > good)
+		return csr_roam_score_rssi_slot_pcnt(best, good,
+					CSR_ROAM_SCORE_MAX_PCNT,
+					rssi_cfg->good_rssi_pcnt,
+					rssi_cfg->good_rssi_bucket_size, rssi);
+	if (rssi > bad)
+		return csr_roam_score_rssi_slot_pcnt(good, bad,
+					rssi_cfg->good_rssi_pcnt,
+					rssi_cfg->bad_rssi_pcnt,
+					rssi_cfg->bad_rssi_bucket_size, rssi);
+
+	return rssi_cfg->bad_rssi_pcnt;
+}
+
+/**
+ * csr_roam_score_band_pcnt() - band percentage of a candidate
+ * @score_cfg: BSS scoring config
+ * @chan: channel of the candidate
+ *
+ * Return: percentage out of the band weightage
+ */
+static uint8_t
+csr_roam_score_band_pcnt(struct wlan_mlme_scoring_cfg *score_cfg,
+			 uint8_t chan)
+{
+	return WLAN_GET_SCORE_PERCENTAGE(score_cfg->band_weight_per_index,
+					 WLAN_REG_IS_5GHZ_CH(chan) ?
+					 CSR_ROAM_SCORE_BAND_IDX_5G :
+					 CSR_ROAM_SCORE_BAND_IDX_2G);
+}
+
+/**
+ * csr_roam_score_congestion_pcnt() - congestion percentage of a candidate
+ * @num_bss_on_chan: number of BSS seen on the channel, at least 1
+ *
+ * Return: percentage out of the channel congestion weightage, the fewer
+ * BSS share the channel the higher
+ */
+static uint8_t csr_roam_score_congestion_pcnt(uint8_t num_bss_on_chan)
+{
+	return CSR_ROAM_SCORE_MAX_PCNT *
+	       (CSR_ROAM_SCORE_MAX_BSS_ON_CHAN - num_bss_on_chan + 1) /
+	       CSR_ROAM_SCORE_MAX_BSS_ON_CHAN;
+}
+
+/**
+ * csr_roam_score_count_bss() - count the BSS of a scan list per channel
+ * @mac_ctx: Global MAC Context
+ * @scan_results_list: scan list, the iterator is back at the head on return
+ * @num_bss: per channel count to fill, CSR_ROAM_SCORE_MAX_CHAN entries
+ *
+ * Return: None
+ */
+static void csr_roam_score_count_bss(struct mac_context *mac_ctx,
+				     tScanResultHandle scan_results_list,
+				     uint8_t *num_bss)
+{
+	tCsrScanResultInfo *scan_result;
+	uint8_t chan;
+
+	qdf_mem_zero(num_bss, CSR_ROAM_SCORE_MAX_CHAN);
+	while ((scan_result = csr_scan_result_get_next(mac_ctx,
+						       scan_results_list))) {
+		chan = scan_result->BssDescriptor.channelId;
+		if (num_bss[chan] < CSR_ROAM_SCORE_MAX_BSS_ON_CHAN)
+			num_bss[chan]++;
+	}
+}
+
+/**
+ * csr_roam_score_bss() - score a candidate from its cached components
+ * @mac_ctx: Global MAC Context
+ * @cache: score cache of the session
+ * @scan_result: candidate
+ * @num_bss_on_chan: number of BSS seen on the channel of the candidate
+ *
+ * The band, RSSI and channel congestion percentages are weighted with the
+ * rssi_weightage, chan_band_weightage and channel_congestion_weightage of
+ * the BSS scoring ini. Only the percentages whose input changed since the
+ * candidate was last scored are computed again.
+ *
+ * The SSID and security match is not scored: the scan filter of the
+ * neighbor roam already drops every BSS which does not match the
+ * connected profile, so it would be the same for every candidate.
+ *
+ * Return: preference of the candidate out of 100, the bigger the better
+ */
+static uint8_t csr_roam_score_bss(struct mac_context *mac_ctx,
+				  struct csr_roam_score_cache *cache,
+				  tCsrScanResultInfo *scan_result,
+				  uint8_t num_bss_on_chan)
+{
+	struct wlan_mlme_scoring_cfg *score_cfg = &mac_ctx->mlme_cfg->scoring;
+	struct wlan_mlme_weight_config *weight = &score_cfg->weight_cfg;
+	struct bss_description *descr = &scan_result->BssDescriptor;
+	struct csr_roam_score_entry *entry;
+	uint32_t total_weight, score;
+	uint8_t idx;
+	bool updated = false;
+
+	idx = (descr->bssId[3] ^ descr->bssId[4] ^ descr->bssId[5]) &
+		(CSR_ROAM_SCORE_CACHE_SIZE - 1);
+	entry = &cache->entry[idx];
+
+	if (!entry->valid || qdf_mem_cmp(entry->bssid.bytes, descr->bssId,
+					 QDF_MAC_ADDR_SIZE)) {
+		qdf_mem_copy(entry->bssid.bytes, descr->bssId,
+			     QDF_MAC_ADDR_SIZE);
+		entry->valid = true;
+		entry->chan = descr->channelId;
+		entry->band_pcnt = csr_roam_score_band_pcnt(score_cfg,
+							    entry->chan);
+		entry->rssi = descr->rssi;
+		entry->rssi_pcnt = csr_roam_score_rssi_pcnt(
+					&score_cfg->rssi_score, entry->rssi);
+		entry->num_bss_on_chan = num_bss_on_chan;
+		entry->congestion_pcnt =
+			csr_roam_score_congestion_pcnt(num_bss_on_chan);
+		cache->misses++;
+		goto out;
+	}
+
+	if (entry->chan != descr->channelId) {
+		entry->chan = descr->channelId;
+		entry->band_pcnt = csr_roam_score_band_pcnt(score_cfg,
+							    entry->chan);
+		updated = true;
+	}
+
+	if (entry->rssi != descr->rssi) {
+		entry->rssi = descr->rssi;
+		entry->rssi_pcnt = csr_roam_score_rssi_pcnt(
+					&score_cfg->rssi_score, entry->rssi);
+		updated = true;
+	}
+
+	if (entry->num_bss_on_chan != num_bss_on_chan) {
+		entry->num_bss_on_chan = num_bss_on_chan;
+		entry->congestion_pcnt =
+			csr_roam_score_congestion_pcnt(num_bss_on_chan);
+		updated = true;
+	}
+
+	if (updated)
+		cache->partial++;
+	else
+		cache->hits++;
+
+out:
+	total_weight = weight->rssi_weightage + weight->chan_band_weightage +
+		       weight->channel_congestion_weightage;
+	if (!total_weight)
+		return 0;
+
+	score = weight->rssi_weightage * entry->rssi_pcnt +
+		weight->chan_band_weightage * entry->band_pcnt +
+		weight->channel_congestion_weightage * entry->congestion_pcnt;
+
+	return score / total_weight;
+}
+
+/**
+ * csr_roam_insert_candidate() - insert a candidate by preference
+ * @list: roamable AP list
+ * @bss_info: candidate with its preference set
+ *
+ * The list is kept in decreasing preference; candidates of equal preference
+ * stay in the scan order, which is sorted by RSSI.
+ *
+ * Return: None
+ */
+static void csr_roam_insert_candidate(tDblLinkList *list,
+				      tpCsrNeighborRoamBSSInfo bss_info)
+{
+	tListElem *entry;
+	tpCsrNeighborRoamBSSInfo cur;
+
+	entry = csr_ll_peek_head(list, LL_ACCESS_LOCK);
+	while (entry) {
+		cur = GET_BASE_ADDR(entry, tCsrNeighborRoamBSSInfo, List);
+		if (cur->apPreferenceVal < bss_info->apPreferenceVal) {
+			csr_ll_insert_entry(list, entry, &bss_info->List,
+					    LL_ACCESS_LOCK);
+			return;
+		}
+		entry = csr_ll_next(list, entry, LL_ACCESS_LOCK);
+	}
+
+	csr_ll_insert_tail(list, &bss_info->List, LL_ACCESS_LOCK);
+}
+
+/**
+ * csr_neighbor_roam_score_cache_reset() - drop the cached candidate scores
+ * @mac_ctx: Global MAC Context
+ * @session_id: SME Session ID
+ *
+ * Called on a new connection, the candidates of the previous one are
+ * scored from scratch on their next scan.
+ *
+ * Return: None
+ */
+void csr_neighbor_roam_score_cache_reset(struct mac_context *mac_ctx,
+					 uint8_t session_id)
+{
+	struct csr_roam_score_cache *cache =
+		&mac_ctx->roam.neighborRoamInfo[session_id].score_cache;
+
+	if (cache->hits || cache->partial || cache->misses)
+		sme_debug("vdev %d roam score cache: hits %u partial %u misses %u",
+			  session_id, cache->hits, cache->partial,
+			  cache->misses);
+
+	qdf_mem_zero(cache, sizeof(*cache));
+}
+
 /**
  * csr_neighbor_roam_process_scan_results() - build roaming candidate list
  *
@@ -152,7 +425,9 @@ QDF_STATUS csr_roam_issue_reassociate_cmd(struct mac_context *mac,
  *
  * This function applies various candidate checks like LFR, 11r, preauth, ESE
  * and builds a roamable AP list. It applies age limit only if no suitable
- * recent candidates are found.
+ * recent candidates are found. With host_roam_candidate_scoring, the list is
+ * sorted by the candidate score computed from the components cached in the
+ * session score cache; otherwise it keeps the scan order, sorted by RSSI.
  *
  * Output list is built in mac_ctx->roam.neighborRoamInfo[sessionid].
  *
@@ -169,6 +444,8 @@ void csr_neighbor_roam_process_scan_results(struct mac_context *mac_ctx,
 	uint64_t age = 0;
 	uint8_t num_candidates = 0;
 	uint8_t num_dropped = 0;
+	uint8_t num_bss[CSR_ROAM_SCORE_MAX_CHAN];
+	bool scoring = mac_ctx->mlme_cfg->lfr.host_roam_candidate_scoring;
 	/*
 	 * first iteration of scan list should consider
 	 * age constraint for candidates
@@ -190,6 +467,8 @@ void csr_neighbor_roam_process_scan_results(struct mac_context *mac_ctx,
 	 * result API. Hence it is assumed that neighbor score and rssi score
 	 * are in the same order. This will be taken care later.
 	 */
+	if (scoring)
+		csr_roam_score_count_bss(mac_ctx, *scan_results_list, num_bss);
 
 	do {
 		while (true) {
@@ -336,15 +615,27 @@ void csr_neighbor_roam_process_scan_results(struct mac_context *mac_ctx,
 				qdf_mem_free(bss_info);
 				continue;
 			}
-			/*
-			 * Assign some preference value for now. Need to
-			 * calculate theactual score based on RSSI and neighbor
-			 * AP score
-			 */
-			bss_info->apPreferenceVal = 10;
+			if (scoring) {
+				bss_info->apPreferenceVal =
+				    csr_roam_score_bss(mac_ctx,
+						&n_roam_info->score_cache,
+						scan_result,
+						num_bss[descr->channelId]);
+				csr_roam_insert_candidate(
+					&n_roam_info->roamableAPList,
+					bss_info);
+			} else {
+				/*
+				 * Assign some preference value for now. Need
+				 * to calculate theactual score based on RSSI
+				 * and neighbor AP score
+				 */
+				bss_info->apPreferenceVal = 10;
+				csr_ll_insert_tail(&n_roam_info->roamableAPList,
+						   &bss_info->List,
+						   LL_ACCESS_LOCK);
+			}
 			num_candidates++;
-			csr_ll_insert_tail(&n_roam_info->roamableAPList,
-				&bss_info->List, LL_ACCESS_LOCK);
 		} /* end of while (csr_scan_result_get_next) */
 
 		/* if some candidates were found, then no need to repeat */
@@ -175,32 +175,16 @@ bool csr_ll_is_list_empty(tDblLinkList *pList, bool fInterlocked)
 
 bool csr_ll_find_entry(tDblLinkList *pList, tListElem *pEntryToFind)
 {
-	bool fFound = false;
-	tListElem *pEntry;
-
 	if (!pList) {
 		QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_ERROR,
 			  "%s: Error!! pList is Null", __func__);
-		return fFound;
+		return false;
 	}
 
-	if (LIST_FLAG_OPEN == pList->Flag) {
-		pEntry = csr_ll_peek_head(pList, LL_ACCESS_NOLOCK);
-
-		/* Have to make sure we don't loop back to the head of the list,
-		 * which will happen if the entry is NOT on the list.
-		 */
-
-		while (pEntry && (pEntry != &pList->ListHead)) {
-			if (pEntry == pEntryToFind) {
-				fFound = true;
-				break;
-			}
-			pEntry = pEntry->next;
-		}
+	if (LIST_FLAG_OPEN != pList->Flag || !pEntryToFind)
+		return false;
 
-	}
-	return fFound;
+	return pEntryToFind->owner == pList;
 }
 
 QDF_STATUS csr_ll_open(tDblLinkList *pList)
@@ -257,6 +241,7 @@ void csr_ll_insert_tail(tDblLinkList *pList, tListElem *pEntry,
 			csr_ll_lock(pList);
 
 		csr_list_insert_tail(&pList->ListHead, pEntry);
+		pEntry->owner = pList;
 		pList->Count++;
 		if (fInterlocked)
 			csr_ll_unlock(pList);
@@ -278,6 +263,7 @@ void csr_ll_insert_head(tDblLinkList *pList, tListElem *pEntry,
 			csr_ll_lock(pList);
 
 		csr_list_insert_head(&pList->ListHead, pEntry);
+		pEntry->owner = pList;
 		pList->Count++;
 		if (fInterlocked)
 			csr_ll_unlock(pList);
@@ -298,6 +284,7 @@ void csr_ll_insert_entry(tDblLinkList *pList, tListElem *pEntry,
 			csr_ll_lock(pList);
 
 		csr_list_insert_entry(pEntry, pNewEntry);
+		pNewEntry->owner = pList;
 		pList->Count++;
 		if (fInterlocked)
 			csr_ll_unlock(pList);
@@ -320,6 +307,7 @@ tListElem *csr_ll_remove_tail(tDblLinkList *pList, bool fInterlocked)
 
 		if (!csrIsListEmpty(&pList->ListHead)) {
 			pEntry = csr_list_remove_tail(&pList->ListHead);
+			pEntry->owner = NULL;
 			pList->Count--;
 		}
 		if (fInterlocked)
@@ -369,6 +357,7 @@ tListElem *csr_ll_remove_head(tDblLinkList *pList, bool fInterlocked)
 
 		if (!csrIsListEmpty(&pList->ListHead)) {
 			pEntry = csr_list_remove_head(&pList->ListHead);
+			pEntry->owner = NULL;
 			pList->Count--;
 		}
 
@@ -430,7 +419,6 @@ bool csr_ll_remove_entry(tDblLinkList *pList, tListElem *pEntryToRemove,
 			 bool fInterlocked)
 {
 	bool fFound = false;
-	tListElem *pEntry;
 
 	if (!pList) {
 		QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_ERROR,
@@ -442,21 +430,12 @@ bool csr_ll_remove_entry(tDblLinkList *pList, tListElem *pEntryToRemove,
 		if (fInterlocked)
 			csr_ll_lock(pList);
 
-		pEntry = csr_ll_peek_head(pList, LL_ACCESS_NOLOCK);
-
-		/* Have to make sure we don't loop back to the head of the
-		 * list, which will happen if the entry is NOT on the list.
-		 */
-		while (pEntry && (pEntry != &pList->ListHead)) {
-			if (pEntry == pEntryToRemove) {
-				csr_list_remove_entry(pEntry);
-				pList->Count--;
-
-				fFound = true;
-				break;
-			}
+		if (csr_ll_find_entry(pList, pEntryToRemove)) {
+			csr_list_remove_entry(pEntryToRemove);
+			pEntryToRemove->owner = NULL;
+			pList->Count--;
 
-			pEntry = pEntry->next;
+			fFound = true;
 		}
 		if (fInterlocked)
 			csr_ll_unlock(pList);
@@ -973,6 +973,7 @@ static void csr_neighbor_roam_info_ctx_init(struct mac_context *mac,
 		ngbr_roam_info->cfgParams.nRoamBmissFinalBcnt;
 	ngbr_roam_info->currentRoamBeaconRssiWeight =
 		ngbr_roam_info->cfgParams.nRoamBeaconRssiWeight;
+	csr_neighbor_roam_score_cache_reset(mac, session_id);
 
 	/*
 	 * Now we can clear the preauthDone that
@@ -34,6 +34,8 @@
 #include "utils_parser.h"
 #include "sme_power_save_api.h"
 #include "wlan_mlme_ucfg_api.h"
+#include "qdf_list.h"
+#include "qdf_time.h"
 
 #ifndef WLAN_MDM_CODE_REDUCTION_OPT
 /* TODO : 6Mbps as Cisco APs seem to like only this value; analysis req.   */
@@ -77,6 +79,9 @@
 #define SME_QOS_MIN_FLOW_ID              1
 #define SME_QOS_MAX_FLOW_ID              0xFFFFFFFE
 #define SME_QOS_INVALID_FLOW_ID          0xFFFFFFFF
+/* buckets of the flow ID index, flow IDs are assigned sequentially */
+#define SME_QOS_FLOW_HASH_SIZE           16
+#define SME_QOS_FLOW_HASH(_id)           ((_id) & (SME_QOS_FLOW_HASH_SIZE - 1))
 /* per the WMM Specification v1.2 Section 2.2.10 */
 /* The Dialog Token field shall be set [...] to a non-zero value */
 #define SME_QOS_MIN_DIALOG_TOKEN         1
@@ -148,6 +153,9 @@ struct sme_qos_flowinfoentry {
 	/* handoff, will set to false once done with */
 	/* the process. Helps SME to decide if at all */
 	/* to notify HDD/LIS for flow renewal after HO */
+	qdf_list_node_t id_node;      /* node in the flow ID index */
+	qdf_list_node_t session_node; /* node in the session flows */
+	qdf_list_node_t ac_node;      /* node in the session flows of the AC */
 };
 /*
  *  DESCRIPTION
@@ -275,6 +283,10 @@ struct sme_qos_sessioninfo {
 
 	bool ftHandoffInProgress;
 
+	/* flows of this session, in the order of the flow list */
+	qdf_list_t flows;
+	/* flows of this session per AC, in the order of the flow list */
+	qdf_list_t ac_flows[QCA_WLAN_AC_ALL];
 };
 /*
  *  DESCRIPTION
@@ -384,6 +396,8 @@ static bool
 sme_qos_is_acm(struct mac_context *mac, struct bss_description *pSirBssDesc,
 	       enum qca_wlan_ac_type ac, tDot11fBeaconIEs *pIes);
 
+static void sme_qos_insert_flow(struct sme_qos_flowinfoentry *flow_info);
+static void sme_qos_remove_flow(tListElem *entry);
 static tListElem *sme_qos_find_in_flow_list(struct sme_qos_searchinfo
 						search_key);
 static QDF_STATUS sme_qos_find_all_in_flow_list(struct mac_context *mac,
@@ -445,6 +459,16 @@ static QDF_STATUS sme_qos_update_tspec_mask(uint8_t sessionId,
 					   struct sme_qos_searchinfo search_key,
 					    uint8_t new_tspec_mask);
 
+/*
+ *  DESCRIPTION
+ *  Time spent by SME QoS processing one type of CSR event
+ */
+struct sme_qos_event_stats {
+	uint32_t count;
+	uint64_t total_us;
+	uint64_t max_us;
+};
+
 /*
  *  DESCRIPTION
  *  SME QoS module's internal control block.
@@ -456,6 +480,10 @@ struct sme_qos_cb_s {
 	struct sme_qos_sessioninfo *sessionInfo;
 	/* All FLOW info */
 	tDblLinkList flow_list;
+	/* FLOW info indexed by flow ID */
+	qdf_list_t flow_id_hash[SME_QOS_FLOW_HASH_SIZE];
+	/* time spent processing the CSR events */
+	struct sme_qos_event_stats event_stats[SME_QOS_CSR_EVENT_MAX];
 	/* default TSPEC params */
 	struct sme_qos_wmmtspecinfo *def_QoSInfo;
 	/* counter for assigning Flow IDs */
@@ -530,7 +558,7 @@ static inline void sme_qos_free_control_block_buffer(void)
 QDF_STATUS sme_qos_open(struct mac_context *mac)
 {
 	struct sme_qos_sessioninfo *pSession;
-	uint8_t sessionId;
+	uint8_t sessionId, i;
 	QDF_STATUS status;
 
 	QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
@@ -556,10 +584,16 @@ QDF_STATUS sme_qos_open(struct mac_context *mac)
 		sme_qos_free_control_block_buffer();
 		return QDF_STATUS_E_FAILURE;
 	}
+	for (i = 0; i < SME_QOS_FLOW_HASH_SIZE; i++)
+		qdf_list_create(&sme_qos_cb.flow_id_hash[i], 0);
+	qdf_mem_zero(sme_qos_cb.event_stats, sizeof(sme_qos_cb.event_stats));
 
 	for (sessionId = 0; sessionId < WLAN_MAX_VDEVS; ++sessionId) {
 		pSession = &sme_qos_cb.sessionInfo[sessionId];
 		pSession->sessionId = sessionId;
+		qdf_list_create(&pSession->flows, 0);
+		for (i = 0; i < QCA_WLAN_AC_ALL; i++)
+			qdf_list_create(&pSession->ac_flows[i], 0);
 		/* initialize the session's per-AC information */
 		sme_qos_init_a_cs(mac, sessionId);
 		/* initialize the session's buffered command list */
@@ -882,6 +916,48 @@ QDF_STATUS sme_qos_msg_processor(struct mac_context *mac_ctx,
 	return status;
 }
 
+/**
+ * sme_qos_update_event_stats() - account the time spent on a CSR event
+ * @session_id: session the event was received on
+ * @ind: event
+ * @time_us: time spent processing the event
+ *
+ * The events of a handoff are logged along with the number of flows the
+ * session carries, so that the QoS share of the roam time can be read off
+ * the logs.
+ *
+ * Return: None
+ */
+static void sme_qos_update_event_stats(uint8_t session_id,
+				       sme_qos_csr_event_indType ind,
+				       uint64_t time_us)
+{
+	struct sme_qos_event_stats *stats = &sme_qos_cb.event_stats[ind];
+
+	stats->count++;
+	stats->total_us += time_us;
+	if (time_us > stats->max_us)
+		stats->max_us = time_us;
+
+	switch (ind) {
+	case SME_QOS_CSR_REASSOC_REQ:
+	case SME_QOS_CSR_REASSOC_COMPLETE:
+	case SME_QOS_CSR_REASSOC_FAILURE:
+	case SME_QOS_CSR_HANDOFF_ASSOC_REQ:
+	case SME_QOS_CSR_HANDOFF_COMPLETE:
+	case SME_QOS_CSR_PREAUTH_SUCCESS_IND:
+	case SME_QOS_CSR_SET_KEY_SUCCESS_IND:
+		sme_debug("Session %d event %d took %llu us with %u flows, avg %llu us max %llu us over %u events",
+			  session_id, ind, time_us,
+			  qdf_list_size(&sme_qos_cb.sessionInfo[session_id].flows),
+			  qdf_do_div(stats->total_us, stats->count),
+			  stats->max_us, stats->count);
+		break;
+	default:
+		break;
+	}
+}
+
 /*
  * sme_qos_csr_event_ind() - The QoS sub-module in SME expects notifications
  * from CSR when certain events occur as mentioned in sme_qos_csr_event_indType.
@@ -896,6 +972,7 @@ QDF_STATUS sme_qos_csr_event_ind(struct mac_context *mac,
 			sme_qos_csr_event_indType ind, void *pEvent_info)
 {
 	QDF_STATUS status = QDF_STATUS_E_FAILURE;
+	uint64_t start_us = qdf_get_log_timestamp_usecs();
 
 	sme_debug("On Session %d Event %d received from CSR", sessionId, ind);
 	switch (ind) {
@@ -957,9 +1034,12 @@ QDF_STATUS sme_qos_csr_event_ind(struct mac_context *mac,
 		/* Err msg */
 		sme_err("On Session %d Unknown Event %d received from CSR",
 			sessionId, ind);
-		break;
+		return status;
 	}
 
+	sme_qos_update_event_stats(sessionId, ind,
+				   qdf_get_log_timestamp_usecs() - start_us);
+
 	return status;
 }
 
@@ -1202,8 +1282,7 @@ static enum sme_qos_statustype sme_qos_internal_setup_req(struct mac_context *ma
 				  "%s: %d: Creating entry on session %d at %pK with flowID %d",
 				  __func__, __LINE__,
 				  sessionId, pentry, QosFlowID);
-			csr_ll_insert_tail(&sme_qos_cb.flow_list, &pentry->link,
-					   true);
+			sme_qos_insert_flow(pentry);
 		} else {
 			/* unexpected status returned by sme_qos_setup() */
 			QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_ERROR,
@@ -1559,8 +1638,7 @@ static enum sme_qos_statustype sme_qos_internal_setup_req(struct mac_context *ma
 				  "%s: %d: On session %d creating entry at %pK with flowID %d",
 				  __func__, __LINE__,
 				  sessionId, pentry, QosFlowID);
-			csr_ll_insert_tail(&sme_qos_cb.flow_list, &pentry->link,
-					   true);
+			sme_qos_insert_flow(pentry);
 		} else {
 			/* unexpected status returned by sme_qos_setup() */
 			QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_ERROR,
@@ -1768,8 +1846,7 @@ static enum sme_qos_statustype sme_qos_internal_modify_req(struct mac_context *m
 			  __func__, __LINE__,
 			  sessionId, pNewEntry, pNewEntry->QosFlowID);
 		/* add the new entry under construction to the Flow List */
-		csr_ll_insert_tail(&sme_qos_cb.flow_list, &pNewEntry->link,
-				   true);
+		sme_qos_insert_flow(pNewEntry);
 		/* update TSPEC with the new param set */
 		hstatus = sme_qos_update_params(sessionId,
 						ac, pNewEntry->tspec_mask,
@@ -2240,8 +2317,7 @@ static enum sme_qos_statustype sme_qos_internal_release_req(struct mac_context *
 						  "%s: %d: Deleting entry at %pK with flowID %d",
 						  __func__, __LINE__, flow_info,
 						  QosFlowID);
-					csr_ll_remove_entry(&sme_qos_cb.
-						flow_list, pEntry, true);
+					sme_qos_remove_flow(pEntry);
 					pDeletedFlow = flow_info;
 					if (SME_QOS_STATUS_SETUP_SUCCESS_APSD_SET_ALREADY == status) {
 						qdf_mem_zero(&search_key,
@@ -2303,9 +2379,7 @@ static enum sme_qos_statustype sme_qos_internal_release_req(struct mac_context *
 						  "%s: %d: On session %d deleting entry at %pK with flowID %d",
 						__func__, __LINE__, sessionId,
 						  flow_info, QosFlowID);
-					csr_ll_remove_entry(&sme_qos_cb.
-								flow_list,
-							    pEntry, true);
+					sme_qos_remove_flow(pEntry);
 					pDeletedFlow = flow_info;
 					if (buffered_cmd) {
 						flow_info->QoSCallback(MAC_HANDLE(mac),
@@ -2527,8 +2601,7 @@ static enum sme_qos_statustype sme_qos_internal_release_req(struct mac_context *
 				  "%s: %d: On session %d deleting entry at %pK with flowID %d",
 				  __func__, __LINE__,
 				  sessionId, flow_info, QosFlowID);
-			csr_ll_remove_entry(&sme_qos_cb.flow_list, pEntry,
-					    true);
+			sme_qos_remove_flow(pEntry);
 			pDeletedFlow = flow_info;
 			pACInfo->relTrig = SME_QOS_RELEASE_DEFAULT;
 		}
@@ -3246,7 +3319,6 @@ static QDF_STATUS sme_qos_process_ft_reassoc_req_ev(
 	uint8_t ac, qos_requested = false;
 	uint8_t tspec_index;
 	struct sme_qos_flowinfoentry *flow_info = NULL;
-	tListElem *entry = NULL;
 
 	QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
 		FL("Invoked on session %d"), sessionId);
@@ -3312,25 +3384,19 @@ static QDF_STATUS sme_qos_process_ft_reassoc_req_ev(
 	 * Now change reason and HO renewal of
 	 * all the flow in this session only
 	 */
-	entry = csr_ll_peek_head(&sme_qos_cb.flow_list, false);
-	if (!entry) {
+	if (!csr_ll_count(&sme_qos_cb.flow_list)) {
 		QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_WARN,
 			FL("Flow List empty, nothing to update"));
 		return QDF_STATUS_E_FAILURE;
 	}
 
-	do {
-		flow_info = GET_BASE_ADDR(entry, struct sme_qos_flowinfoentry,
-					link);
-		if (sessionId == flow_info->sessionId) {
-			QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
-				"Changing FlowID %d reason to SETUP and HO renewal to false",
-				flow_info->QosFlowID);
-			flow_info->reason = SME_QOS_REASON_SETUP;
-			flow_info->hoRenewal = true;
-		}
-		entry = csr_ll_next(&sme_qos_cb.flow_list, entry, false);
-	} while (entry);
+	qdf_list_for_each(&session->flows, flow_info, session_node) {
+		QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
+			"Changing FlowID %d reason to SETUP and HO renewal to false",
+			flow_info->QosFlowID);
+		flow_info->reason = SME_QOS_REASON_SETUP;
+		flow_info->hoRenewal = true;
+	}
 
 	return QDF_STATUS_SUCCESS;
 }
@@ -4313,7 +4379,6 @@ static QDF_STATUS sme_qos_process_reassoc_req_ev(struct mac_context *mac, uint8_
 	struct sme_qos_acinfo *pACInfo;
 	enum qca_wlan_ac_type ac;
 	struct sme_qos_flowinfoentry *flow_info = NULL;
-	tListElem *entry = NULL;
 
 	QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_INFO_HIGH,
 		  "%s: %d: invoked on session %d",
@@ -4356,28 +4421,21 @@ static QDF_STATUS sme_qos_process_reassoc_req_ev(struct mac_context *mac, uint8_
 		 * Now change reason and HO renewal of
 		 * all the flow in this session only
 		 */
-		entry = csr_ll_peek_head(&sme_qos_cb.flow_list, false);
-		if (!entry) {
+		if (!csr_ll_count(&sme_qos_cb.flow_list)) {
 			QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
 				FL("Flow List empty, nothing to update"));
 			return QDF_STATUS_E_FAILURE;
 		}
 
-		do {
-			flow_info = GET_BASE_ADDR(entry, struct sme_qos_flowinfoentry,
-						  link);
-			if (sessionId == flow_info->sessionId) {
-				QDF_TRACE(QDF_MODULE_ID_SME,
-					  QDF_TRACE_LEVEL_INFO_HIGH,
-					  FL("Changing FlowID %d reason to"
-					     " SETUP and HO renewal to true"),
-					  flow_info->QosFlowID);
-				flow_info->reason = SME_QOS_REASON_SETUP;
-				flow_info->hoRenewal = true;
-			}
-			entry = csr_ll_next(&sme_qos_cb.flow_list, entry,
-					    false);
-		} while (entry);
+		qdf_list_for_each(&pSession->flows, flow_info, session_node) {
+			QDF_TRACE(QDF_MODULE_ID_SME,
+				  QDF_TRACE_LEVEL_INFO_HIGH,
+				  FL("Changing FlowID %d reason to"
+				     " SETUP and HO renewal to true"),
+				  flow_info->QosFlowID);
+			flow_info->reason = SME_QOS_REASON_SETUP;
+			flow_info->hoRenewal = true;
+		}
 
 		/* buffer the existing flows to be renewed after handoff is
 		 * done
@@ -5167,7 +5225,6 @@ static QDF_STATUS sme_qos_update_tspec_mask(uint8_t sessionid,
 						search_key,
 					    uint8_t new_tspec_mask)
 {
-	tListElem *list_elt = NULL, *list_next_elt = NULL;
 	struct sme_qos_flowinfoentry *flow_info = NULL;
 	struct sme_qos_sessioninfo *qos_session;
 	struct sme_qos_acinfo *ac_info;
@@ -5186,28 +5243,17 @@ static QDF_STATUS sme_qos_update_tspec_mask(uint8_t sessionid,
 		return QDF_STATUS_E_FAILURE;
 	}
 
-	list_elt = csr_ll_peek_head(&sme_qos_cb.flow_list, false);
-	if (!list_elt) {
+	if (!csr_ll_count(&sme_qos_cb.flow_list)) {
 		QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_ERROR,
 			  FL("Flow List empty, nothing to update"));
 		return QDF_STATUS_E_FAILURE;
 	}
 
-	while (list_elt) {
-		list_next_elt = csr_ll_next(&sme_qos_cb.flow_list, list_elt,
-					    false);
-		flow_info = GET_BASE_ADDR(list_elt, struct
-					sme_qos_flowinfoentry, link);
-
-		if (search_key.sessionId != flow_info->sessionId) {
-			list_elt = list_next_elt;
-			continue;
-		}
-
+	qdf_list_for_each(&qos_session->ac_flows[search_key.key.ac_type],
+			  flow_info, ac_node) {
 		if (search_key.index & SME_QOS_SEARCH_KEY_INDEX_4) {
-			if ((search_key.key.ac_type == flow_info->ac_type) &&
-			    (search_key.direction ==
-				flow_info->QoSInfo.ts_info.direction)) {
+			if (search_key.direction ==
+			    flow_info->QoSInfo.ts_info.direction) {
 				QDF_TRACE(QDF_MODULE_ID_SME,
 				  QDF_TRACE_LEVEL_DEBUG,
 				  FL("Flow %d matches"), flow_info->QosFlowID);
@@ -5216,8 +5262,7 @@ static QDF_STATUS sme_qos_update_tspec_mask(uint8_t sessionid,
 				flow_info->tspec_mask = new_tspec_mask;
 			}
 		} else if (search_key.index & SME_QOS_SEARCH_KEY_INDEX_5) {
-			if ((search_key.key.ac_type == flow_info->ac_type) &&
-			    (search_key.tspec_mask == flow_info->tspec_mask)) {
+			if (search_key.tspec_mask == flow_info->tspec_mask) {
 				QDF_TRACE(QDF_MODULE_ID_SME,
 				  QDF_TRACE_LEVEL_DEBUG,
 				  FL("Flow %d matches"), flow_info->QosFlowID);
@@ -5226,7 +5271,6 @@ static QDF_STATUS sme_qos_update_tspec_mask(uint8_t sessionid,
 				flow_info->tspec_mask = new_tspec_mask;
 			}
 		}
-		list_elt = list_next_elt;
 	}
 
 	return QDF_STATUS_SUCCESS;
@@ -5665,7 +5709,6 @@ static QDF_STATUS sme_qos_update_params(uint8_t sessionId,
 		uint8_t tspec_mask,
 		struct sme_qos_wmmtspecinfo *pTspec_Info)
 {
-	tListElem *pEntry = NULL, *pNextEntry = NULL;
 	struct sme_qos_sessioninfo *pSession;
 	struct sme_qos_acinfo *pACInfo;
 	struct sme_qos_flowinfoentry *flow_info = NULL;
@@ -5681,8 +5724,7 @@ static QDF_STATUS sme_qos_update_params(uint8_t sessionId,
 		return QDF_STATUS_E_FAILURE;
 	}
 	qdf_mem_zero(&Tspec_Info, sizeof(struct sme_qos_wmmtspecinfo));
-	pEntry = csr_ll_peek_head(&sme_qos_cb.flow_list, false);
-	if (!pEntry) {
+	if (!csr_ll_count(&sme_qos_cb.flow_list)) {
 		QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_ERROR,
 			  "%s: %d: Flow List empty, nothing to update",
 			  __func__, __LINE__);
@@ -5697,13 +5739,8 @@ static QDF_STATUS sme_qos_update_params(uint8_t sessionId,
 		pACInfo->curr_QoSInfo[tspec_mask - 1].ts_info.psb;
 	Tspec_Info.ts_info.tid =
 		pACInfo->curr_QoSInfo[tspec_mask - 1].ts_info.tid;
-	while (pEntry) {
-		pNextEntry = csr_ll_next(&sme_qos_cb.flow_list, pEntry, false);
-		flow_info = GET_BASE_ADDR(pEntry, struct sme_qos_flowinfoentry,
-					link);
-		if ((sessionId == flow_info->sessionId) &&
-		    (ac == flow_info->ac_type) &&
-		    (tspec_mask == flow_info->tspec_mask)) {
+	qdf_list_for_each(&pSession->ac_flows[ac], flow_info, ac_node) {
+		if (tspec_mask == flow_info->tspec_mask) {
 			QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
 				  "%s: %d: Flow %d matches",
 				  __func__, __LINE__, flow_info->QosFlowID);
@@ -5728,7 +5765,6 @@ static QDF_STATUS sme_qos_update_params(uint8_t sessionId,
 					  __func__, __LINE__);
 			}
 		}
-		pEntry = pNextEntry;
 	}
 	/* return the aggregate */
 	*pTspec_Info = Tspec_Info;
@@ -5781,6 +5817,99 @@ static void sme_qos_state_transition(uint8_t sessionId,
 			  pACInfo->prev_state, ac);
 }
 
+/**
+ * sme_qos_insert_flow() - add a flow entry to the flow list and its indexes
+ * @flow_info: flow entry with its session, AC and flow ID set
+ *
+ * Return: None
+ */
+static void sme_qos_insert_flow(struct sme_qos_flowinfoentry *flow_info)
+{
+	struct sme_qos_sessioninfo *qos_session =
+		&sme_qos_cb.sessionInfo[flow_info->sessionId];
+
+	csr_ll_insert_tail(&sme_qos_cb.flow_list, &flow_info->link, true);
+	qdf_list_insert_back(&sme_qos_cb.flow_id_hash[SME_QOS_FLOW_HASH(
+						flow_info->QosFlowID)],
+			     &flow_info->id_node);
+	qdf_list_insert_back(&qos_session->flows, &flow_info->session_node);
+	qdf_list_insert_back(&qos_session->ac_flows[flow_info->ac_type],
+			     &flow_info->ac_node);
+}
+
+/**
+ * sme_qos_remove_flow() - remove a flow entry from the flow list and indexes
+ * @entry: list element of the flow entry, the entry is not freed
+ *
+ * Return: None
+ */
+static void sme_qos_remove_flow(tListElem *entry)
+{
+	struct sme_qos_flowinfoentry *flow_info =
+		GET_BASE_ADDR(entry, struct sme_qos_flowinfoentry, link);
+	struct sme_qos_sessioninfo *qos_session =
+		&sme_qos_cb.sessionInfo[flow_info->sessionId];
+
+	csr_ll_remove_entry(&sme_qos_cb.flow_list, entry, true);
+	qdf_list_remove_node(&sme_qos_cb.flow_id_hash[SME_QOS_FLOW_HASH(
+						flow_info->QosFlowID)],
+			     &flow_info->id_node);
+	qdf_list_remove_node(&qos_session->flows, &flow_info->session_node);
+	qdf_list_remove_node(&qos_session->ac_flows[flow_info->ac_type],
+			     &flow_info->ac_node);
+}
+
+/**
+ * sme_qos_find_in_session() - find a flow entry of a session
+ * @qos_session: session to search
+ * @search_key: search key, any key but the flow ID
+ *
+ * The AC keys only walk the flows of the session on the AC. The keys are
+ * checked in the same order as the flow list search used to: AC, reason,
+ * then AC and direction.
+ *
+ * Return: first matching flow entry in flow list order, NULL if none
+ */
+static struct sme_qos_flowinfoentry *
+sme_qos_find_in_session(struct sme_qos_sessioninfo *qos_session,
+			struct sme_qos_searchinfo *search_key)
+{
+	struct sme_qos_flowinfoentry *flow_info;
+	bool match_ac = search_key->index & SME_QOS_SEARCH_KEY_INDEX_2;
+
+	if (!match_ac && (search_key->index & SME_QOS_SEARCH_KEY_INDEX_3)) {
+		qdf_list_for_each(&qos_session->flows, flow_info,
+				  session_node) {
+			if (search_key->key.reason == flow_info->reason) {
+				sme_debug("match found on reason, ending search");
+				return flow_info;
+			}
+		}
+		return NULL;
+	}
+
+	if (!match_ac && !(search_key->index & SME_QOS_SEARCH_KEY_INDEX_4))
+		return NULL;
+
+	if (search_key->key.ac_type >= QCA_WLAN_AC_ALL)
+		return NULL;
+
+	qdf_list_for_each(&qos_session->ac_flows[search_key->key.ac_type],
+			  flow_info, ac_node) {
+		if (match_ac) {
+			sme_debug("match found on ac, ending search");
+			return flow_info;
+		}
+		if (search_key->direction ==
+		    flow_info->QoSInfo.ts_info.direction) {
+			sme_debug("match found on ac and direction, ending search");
+			return flow_info;
+		}
+	}
+
+	return NULL;
+}
+
 /**
  * sme_qos_find_in_flow_list() - find a flow entry from the flow list
  * @search_key: We can either use the flowID or the ac type to find the
@@ -5790,69 +5919,58 @@ static void sme_qos_state_transition(uint8_t sessionId,
  *              bit 0 - Flow ID
  *              bit 1 - AC type
  *
- * Utility function to find an flow entry from the flow_list.
+ * Utility function to find an flow entry from the flow_list. The flow ID is
+ * looked up in the flow ID index, the other keys are looked up in the flows
+ * of the session, or of each session in turn for
+ * SME_QOS_SEARCH_SESSION_ID_ANY.
  *
  * Return: pointer to the list element
  */
 static tListElem *sme_qos_find_in_flow_list(struct sme_qos_searchinfo
 						search_key)
 {
-	tListElem *list_elt = NULL, *list_next_elt = NULL;
-	struct sme_qos_flowinfoentry *flow_info = NULL;
+	struct sme_qos_flowinfoentry *flow_info;
+	uint8_t session_id, last_session_id;
 
-	list_elt = csr_ll_peek_head(&sme_qos_cb.flow_list, false);
-	if (!list_elt) {
+	if (!csr_ll_count(&sme_qos_cb.flow_list)) {
 		QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_ERROR,
 			  FL("Flow List empty, can't search"));
 		return NULL;
 	}
 
-	while (list_elt) {
-		list_next_elt = csr_ll_next(&sme_qos_cb.flow_list, list_elt,
-					    false);
-		flow_info = GET_BASE_ADDR(list_elt, struct
-					sme_qos_flowinfoentry, link);
-
-		if ((search_key.sessionId != flow_info->sessionId) &&
-		    (search_key.sessionId != SME_QOS_SEARCH_SESSION_ID_ANY)) {
-			list_elt = list_next_elt;
-			continue;
+	if (search_key.index & SME_QOS_SEARCH_KEY_INDEX_1) {
+		qdf_list_for_each(&sme_qos_cb.flow_id_hash[SME_QOS_FLOW_HASH(
+						search_key.key.QosFlowID)],
+				  flow_info, id_node) {
+			if (search_key.key.QosFlowID != flow_info->QosFlowID)
+				continue;
+			if ((search_key.sessionId != flow_info->sessionId) &&
+			    (search_key.sessionId !=
+			     SME_QOS_SEARCH_SESSION_ID_ANY))
+				continue;
+			sme_debug("match found on flowID, ending search");
+			return &flow_info->link;
 		}
+		return NULL;
+	}
 
-		if (search_key.index & SME_QOS_SEARCH_KEY_INDEX_1) {
-			if (search_key.key.QosFlowID == flow_info->QosFlowID) {
-				QDF_TRACE(QDF_MODULE_ID_SME,
-				  QDF_TRACE_LEVEL_DEBUG,
-				  FL("match found on flowID, ending search"));
-				break;
-			}
-		} else if (search_key.index & SME_QOS_SEARCH_KEY_INDEX_2) {
-			if (search_key.key.ac_type == flow_info->ac_type) {
-				QDF_TRACE(QDF_MODULE_ID_SME,
-				  QDF_TRACE_LEVEL_DEBUG,
-				  FL("match found on ac, ending search"));
-				break;
-			}
-		} else if (search_key.index & SME_QOS_SEARCH_KEY_INDEX_3) {
-			if (search_key.key.reason == flow_info->reason) {
-				QDF_TRACE(QDF_MODULE_ID_SME,
-				  QDF_TRACE_LEVEL_DEBUG,
-				  FL("match found on reason, ending search"));
-				break;
-			}
-		} else if (search_key.index & SME_QOS_SEARCH_KEY_INDEX_4) {
-			if ((search_key.key.ac_type == flow_info->ac_type) &&
-			    (search_key.direction ==
-				flow_info->QoSInfo.ts_info.direction)) {
-				QDF_TRACE(QDF_MODULE_ID_SME,
-				  QDF_TRACE_LEVEL_DEBUG,
-				  FL("match found on reason, ending search"));
-				break;
-			}
-		}
-		list_elt = list_next_elt;
+	if (search_key.sessionId == SME_QOS_SEARCH_SESSION_ID_ANY) {
+		session_id = 0;
+		last_session_id = WLAN_MAX_VDEVS - 1;
+	} else {
+		session_id = search_key.sessionId;
+		last_session_id = search_key.sessionId;
 	}
-	return list_elt;
+
+	for (; session_id <= last_session_id; session_id++) {
+		flow_info = sme_qos_find_in_session(
+				&sme_qos_cb.sessionInfo[session_id],
+				&search_key);
+		if (flow_info)
+			return &flow_info->link;
+	}
+
+	return NULL;
 }
 
 /**
@@ -5869,65 +5987,80 @@ static tListElem *sme_qos_find_in_flow_list(struct sme_qos_searchinfo
  *  bit 0 - Flow ID
  *  bit 1 - AC type
  *
+ * The flow ID is looked up in the flow ID index and the AC in the flows of
+ * the session on the AC, @fnp may delete the entry it is called for.
+ *
  * Return: None
  */
 static QDF_STATUS sme_qos_find_all_in_flow_list(struct mac_context *mac_ctx,
 					 struct sme_qos_searchinfo search_key,
 					 sme_QosProcessSearchEntry fnp)
 {
-	tListElem *list_elt = NULL, *list_next_elt = NULL;
 	struct sme_qos_sessioninfo *qos_session;
-	struct sme_qos_flowinfoentry *flow_info = NULL;
+	struct sme_qos_flowinfoentry *flow_info, *next_flow_info;
 	QDF_STATUS status = QDF_STATUS_E_FAILURE;
-	enum qca_wlan_ac_type ac_type;
+	enum qca_wlan_ac_type ac_type = search_key.key.ac_type;
+	uint8_t session_id, last_session_id;
 
-	list_elt = csr_ll_peek_head(&sme_qos_cb.flow_list, false);
-	if (!list_elt) {
+	if (!csr_ll_count(&sme_qos_cb.flow_list)) {
 		QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_ERROR,
 			  FL("Flow List empty, can't search"));
 		return QDF_STATUS_E_FAILURE;
 	}
 
-	while (list_elt) {
-		list_next_elt = csr_ll_next(&sme_qos_cb.flow_list, list_elt,
-					    false);
-		flow_info = GET_BASE_ADDR(list_elt, struct
-					sme_qos_flowinfoentry, link);
-		qos_session = &sme_qos_cb.sessionInfo[flow_info->sessionId];
-		if ((search_key.sessionId != flow_info->sessionId) &&
-		    (search_key.sessionId != SME_QOS_SEARCH_SESSION_ID_ANY)) {
-			list_elt = list_next_elt;
-			continue;
-		}
-
-		if ((search_key.index & SME_QOS_SEARCH_KEY_INDEX_1) &&
-		    (search_key.key.QosFlowID == flow_info->QosFlowID)) {
+	if (search_key.index & SME_QOS_SEARCH_KEY_INDEX_1) {
+		qdf_list_for_each_del(&sme_qos_cb.flow_id_hash[
+				SME_QOS_FLOW_HASH(search_key.key.QosFlowID)],
+				flow_info, next_flow_info, id_node) {
+			if (search_key.key.QosFlowID != flow_info->QosFlowID)
+				continue;
+			if ((search_key.sessionId != flow_info->sessionId) &&
+			    (search_key.sessionId !=
+			     SME_QOS_SEARCH_SESSION_ID_ANY))
+				continue;
 			QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
 			    FL("match found on flowID, ending search"));
-			status = fnp(mac_ctx, list_elt);
+			status = fnp(mac_ctx, &flow_info->link);
 			if (QDF_STATUS_E_FAILURE == status) {
 				QDF_TRACE(QDF_MODULE_ID_SME,
 				    QDF_TRACE_LEVEL_ERROR,
 				    FL("Failed to process entry"));
 				break;
 			}
-		} else if ((search_key.index & SME_QOS_SEARCH_KEY_INDEX_2) &&
-			   (search_key.key.ac_type == flow_info->ac_type)) {
+		}
+		return status;
+	}
+
+	if (!(search_key.index & SME_QOS_SEARCH_KEY_INDEX_2) ||
+	    ac_type >= QCA_WLAN_AC_ALL)
+		return status;
+
+	if (search_key.sessionId == SME_QOS_SEARCH_SESSION_ID_ANY) {
+		session_id = 0;
+		last_session_id = WLAN_MAX_VDEVS - 1;
+	} else {
+		session_id = search_key.sessionId;
+		last_session_id = search_key.sessionId;
+	}
+
+	for (; session_id <= last_session_id; session_id++) {
+		qos_session = &sme_qos_cb.sessionInfo[session_id];
+		qdf_list_for_each_del(&qos_session->ac_flows[ac_type],
+				      flow_info, next_flow_info, ac_node) {
 			QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
 			    FL("match found on ac, ending search"));
-			ac_type = flow_info->ac_type;
 			flow_info->hoRenewal =
 				qos_session->ac_info[ac_type].hoRenewal;
-			status = fnp(mac_ctx, list_elt);
+			status = fnp(mac_ctx, &flow_info->link);
 			if (QDF_STATUS_E_FAILURE == status) {
 				QDF_TRACE(QDF_MODULE_ID_SME,
 				    QDF_TRACE_LEVEL_ERROR,
 				    FL("Failed to process entry"));
-				break;
+				return status;
 			}
 		}
-		list_elt = list_next_elt;
 	}
+
 	return status;
 }
 
@@ -6018,29 +6151,20 @@ sme_qos_is_acm(struct mac_context *mac, struct bss_description *pSirBssDesc,
 static QDF_STATUS sme_qos_buffer_existing_flows(struct mac_context *mac_ctx,
 						uint8_t sessionid)
 {
-	tListElem *list_entry = NULL, *list_nextentry = NULL;
 	struct sme_qos_sessioninfo *qos_session;
-	struct sme_qos_flowinfoentry *flow_info = NULL;
+	struct sme_qos_flowinfoentry *flow_info = NULL, *next_flow_info;
 	struct sme_qos_cmdinfo cmd;
 	struct sme_qos_setupcmdinfo *setupinfo;
 
-	list_entry = csr_ll_peek_head(&sme_qos_cb.flow_list, false);
-	if (!list_entry) {
+	if (!csr_ll_count(&sme_qos_cb.flow_list)) {
 		QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
 			  FL("Flow List empty, nothing to buffer"));
 		return QDF_STATUS_E_FAILURE;
 	}
 
-	while (list_entry) {
-		list_nextentry = csr_ll_next(&sme_qos_cb.flow_list, list_entry,
-					     false);
-		flow_info = GET_BASE_ADDR(list_entry, struct
-					sme_qos_flowinfoentry, link);
-		if (flow_info->sessionId != sessionid) {
-			list_entry = list_nextentry;
-			continue;
-		}
-
+	qos_session = &sme_qos_cb.sessionInfo[sessionid];
+	qdf_list_for_each_del(&qos_session->flows, flow_info, next_flow_info,
+			      session_node) {
 		if ((SME_QOS_REASON_REQ_SUCCESS == flow_info->reason) ||
 		    (SME_QOS_REASON_SETUP == flow_info->reason)) {
 			cmd.command = SME_QOS_SETUP_REQ;
@@ -6109,12 +6233,9 @@ static QDF_STATUS sme_qos_buffer_existing_flows(struct mac_context *mac_ctx,
 		QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
 			  FL("Deleting original entry at %pK with flowID %d"),
 			  flow_info, flow_info->QosFlowID);
-		csr_ll_remove_entry(&sme_qos_cb.flow_list, list_entry, true);
+		sme_qos_remove_flow(&flow_info->link);
 		qdf_mem_free(flow_info);
-
-		list_entry = list_nextentry;
 	}
-	qos_session = &sme_qos_cb.sessionInfo[sessionid];
 	return QDF_STATUS_SUCCESS;
 }
 
@@ -6127,41 +6248,35 @@ static QDF_STATUS sme_qos_buffer_existing_flows(struct mac_context *mac_ctx,
 static QDF_STATUS sme_qos_delete_existing_flows(struct mac_context *mac,
 						uint8_t sessionId)
 {
-	tListElem *pEntry = NULL, *pNextEntry = NULL;
-	struct sme_qos_flowinfoentry *flow_info = NULL;
+	struct sme_qos_sessioninfo *qos_session;
+	struct sme_qos_flowinfoentry *flow_info = NULL, *next_flow_info;
 
-	pEntry = csr_ll_peek_head(&sme_qos_cb.flow_list, true);
-	if (!pEntry) {
+	qos_session = &sme_qos_cb.sessionInfo[sessionId];
+	if (qdf_list_empty(&qos_session->flows)) {
 		QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
 			  "%s: %d: Flow List empty, nothing to delete",
 			  __func__, __LINE__);
 		return QDF_STATUS_E_FAILURE;
 	}
-	while (pEntry) {
-		pNextEntry = csr_ll_next(&sme_qos_cb.flow_list, pEntry, true);
-		flow_info = GET_BASE_ADDR(pEntry, struct sme_qos_flowinfoentry,
-					link);
-		if (flow_info->sessionId == sessionId) {
-			if ((SME_QOS_REASON_REQ_SUCCESS == flow_info->reason) ||
-			    (SME_QOS_REASON_SETUP == flow_info->reason) ||
-			    (SME_QOS_REASON_RELEASE == flow_info->reason) ||
-			    (SME_QOS_REASON_MODIFY == flow_info->reason)) {
-				flow_info->QoSCallback(MAC_HANDLE(mac),
-						       flow_info->HDDcontext,
-						       NULL,
+	qdf_list_for_each_del(&qos_session->flows, flow_info, next_flow_info,
+			      session_node) {
+		if ((SME_QOS_REASON_REQ_SUCCESS == flow_info->reason) ||
+		    (SME_QOS_REASON_SETUP == flow_info->reason) ||
+		    (SME_QOS_REASON_RELEASE == flow_info->reason) ||
+		    (SME_QOS_REASON_MODIFY == flow_info->reason)) {
+			flow_info->QoSCallback(MAC_HANDLE(mac),
+					       flow_info->HDDcontext,
+					       NULL,
 					SME_QOS_STATUS_RELEASE_QOS_LOST_IND,
-						       flow_info->QosFlowID);
-			}
-			QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
-				  "%s: %d: Deleting entry at %pK with flowID %d",
-				  __func__, __LINE__,
-				  flow_info, flow_info->QosFlowID);
-			/* delete the entry from Flow List */
-			csr_ll_remove_entry(&sme_qos_cb.flow_list, pEntry,
-					    true);
-			qdf_mem_free(flow_info);
+					       flow_info->QosFlowID);
 		}
-		pEntry = pNextEntry;
+		QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
+			  "%s: %d: Deleting entry at %pK with flowID %d",
+			  __func__, __LINE__,
+			  flow_info, flow_info->QosFlowID);
+		/* delete the entry from Flow List */
+		sme_qos_remove_flow(&flow_info->link);
+		qdf_mem_free(flow_info);
 	}
 	return QDF_STATUS_SUCCESS;
 }
@@ -6517,7 +6632,7 @@ static QDF_STATUS sme_qos_modify_fnp(struct mac_context *mac, tListElem *pEntry)
 		QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
 			  "%s: %d: Deleting original entry at %pK with flowID %d",
 			  __func__, __LINE__, flow_info, flow_info->QosFlowID);
-		csr_ll_remove_entry(&sme_qos_cb.flow_list, pEntry, true);
+		sme_qos_remove_flow(pEntry);
 		/* reclaim the memory */
 		qdf_mem_free(flow_info);
 		break;
@@ -6693,7 +6808,7 @@ sme_qos_reassoc_success_ev_fnp(struct mac_context *mac_ctx,
 		QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
 			FL("Deleting entry at %pK with flowID %d"),
 			flow_info, flow_info->QosFlowID);
-		csr_ll_remove_entry(&sme_qos_cb.flow_list, entry, true);
+		sme_qos_remove_flow(entry);
 		/* reclaim the memory */
 		qdf_mem_free(flow_info);
 	}
@@ -6781,7 +6896,7 @@ static QDF_STATUS sme_qos_add_ts_failure_fnp(struct mac_context *mac, tListElem
 		QDF_TRACE(QDF_MODULE_ID_SME, QDF_TRACE_LEVEL_DEBUG,
 			  "%s: %d: Deleting entry at %pK with flowID %d",
 			  __func__, __LINE__, flow_info, flow_info->QosFlowID);
-		csr_ll_remove_entry(&sme_qos_cb.flow_list, pEntry, true);
+		sme_qos_remove_flow(pEntry);
 		/* reclaim the memory */
 		qdf_mem_free(flow_info);
 	}
@@ -6949,7 +7064,7 @@ static QDF_STATUS sme_qos_add_ts_success_fnp(struct mac_context *mac_ctx,
 			FL("Deleting entry at %pK with flowID %d"),
 			flow_info, flow_info->QosFlowID);
 		/* delete the entry from Flow List */
-		csr_ll_remove_entry(&sme_qos_cb.flow_list, entry, true);
+		sme_qos_remove_flow(entry);
 		/* reclaim the memory */
 		qdf_mem_free(flow_info);
 	}
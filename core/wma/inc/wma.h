@@ -45,6 +45,7 @@
 #include <wlan_policy_mgr_api.h>
 #include "wma_api.h"
 #include "wmi_unified_param.h"
+#include "qdf_debugfs.h"
 
 /* Platform specific configuration for max. no. of fragments */
 #define QCA_OL_11AC_TX_MAX_FRAGS            2
@@ -923,6 +924,41 @@ struct wma_wlm_stats_data {
 };
 #endif
 
+/* Number of event ids tracked in the fw event statistics */
+#define WMA_FW_EVENT_STATS_SIZE 64
+/* Maximum number of serialized fw events pending per priority */
+#define WMA_FW_EVENT_LANE_SIZE 1024
+
+/**
+ * enum wma_fw_event_prio - priority of fw events serialized to mc thread
+ * @WMA_FW_EVENT_PRIO_NORMAL: events not classified otherwise, kept in order
+ * @WMA_FW_EVENT_PRIO_LOW: statistics and logging events
+ * @WMA_FW_EVENT_PRIO_MAX: number of priorities
+ */
+enum wma_fw_event_prio {
+	WMA_FW_EVENT_PRIO_NORMAL,
+	WMA_FW_EVENT_PRIO_LOW,
+	WMA_FW_EVENT_PRIO_MAX,
+};
+
+/**
+ * struct wma_fw_event_stats - statistics of a serialized fw event id
+ * @event_id: WMI event id, 0 if the entry is unused
+ * @count: number of events processed
+ * @queue_us: total time spent waiting for the mc thread
+ * @max_queue_us: longest time spent waiting for the mc thread
+ * @run_us: total time spent in the event handler
+ * @max_run_us: longest time spent in the event handler
+ */
+struct wma_fw_event_stats {
+	uint32_t event_id;
+	uint32_t count;
+	uint64_t queue_us;
+	uint32_t max_queue_us;
+	uint64_t run_us;
+	uint32_t max_run_us;
+};
+
 /**
  * struct t_wma_handle - wma context
  * @wmi_handle: wmi handle
@@ -1056,6 +1092,15 @@ struct wma_wlm_stats_data {
  * @wma_fw_time_sync_timer: timer used for firmware time sync
  * @critical_events_in_flight: number of suspend-preventing events
  *   in flight
+ * @fw_event_lock: lock protecting @fw_event_lane
+ * @fw_event_lane: serialized fw events waiting for the mc thread, per
+ *   priority
+ * @fw_event_msg_pending: number of WMA_PROCESS_FW_EVENT messages posted
+ *   and not processed yet
+ * @fw_event_stats: queueing and handler time of serialized fw events, per
+ *   event id
+ * @fw_event_debugfs_dir: debugfs directory of the fw event statistics
+ * @fw_event_debugfs_fops: debugfs ops of the fw event statistics
  * * @fw_therm_throt_support: FW Supports thermal throttling?
  *
  * This structure is the global wma context.  It contains global wma
@@ -1198,6 +1243,14 @@ typedef struct {
 	uint8_t  ito_repeat_count;
 	qdf_mc_timer_t wma_fw_time_sync_timer;
 	qdf_atomic_t critical_events_in_flight;
+	qdf_spinlock_t fw_event_lock;
+	qdf_list_t fw_event_lane[WMA_FW_EVENT_PRIO_MAX];
+	qdf_atomic_t fw_event_msg_pending;
+	struct wma_fw_event_stats fw_event_stats[WMA_FW_EVENT_STATS_SIZE];
+#ifdef WLAN_DEBUGFS
+	struct dentry *fw_event_debugfs_dir;
+	struct qdf_debugfs_fops fw_event_debugfs_fops;
+#endif
 	bool fw_therm_throt_support;
 	bool enable_tx_compl_tsf64;
 } t_wma_handle, *tp_wma_handle;
@@ -1647,12 +1700,20 @@ struct wma_roam_invoke_cmd {
 
 /**
  * struct wma_process_fw_event_params - fw event parameters
+ * @node: node in the priority lane of the event
  * @wmi_handle: wmi handle
  * @evt_buf: event buffer
+ * @event_id: WMI event id
+ * @prio: priority of the event
+ * @enqueue_us: time the event was queued for the mc thread
  */
 typedef struct {
+	qdf_list_node_t node;
 	void *wmi_handle;
 	void *evt_buf;
+	uint32_t event_id;
+	enum wma_fw_event_prio prio;
+	uint64_t enqueue_us;
 } wma_process_fw_event_params;
 
 /**
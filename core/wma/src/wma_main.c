@@ -103,6 +103,7 @@
 #endif
 
 #include "wlan_pkt_capture_ucfg_api.h"
+#include "qdf_time.h"
 
 #define WMA_LOG_COMPLETION_TIMER 3000 /* 3 seconds */
 #define WMI_TLV_HEADROOM 128
@@ -1612,30 +1613,412 @@ static bool wma_event_is_critical(uint32_t event_id)
 	}
 }
 
+/**
+ * wma_get_fw_event_prio() - get the priority of a serialized fw event
+ * @event_id: WMI event id
+ *
+ * Only statistics and logging events are moved behind the others. They
+ * change no vdev or peer state and their handlers look the vdev or peer
+ * up by id and drop the report once it is gone, so it does not matter
+ * whether they run before or after a later lifecycle event. All the other
+ * events, roaming included, stay in the order firmware sent them.
+ *
+ * Return: priority lane of the event
+ */
+static enum wma_fw_event_prio wma_get_fw_event_prio(uint32_t event_id)
+{
+	switch (event_id) {
+	case WMI_UPDATE_STATS_EVENTID:
+	case WMI_PEER_STATS_INFO_EVENTID:
+	case WMI_IFACE_LINK_STATS_EVENTID:
+	case WMI_PEER_LINK_STATS_EVENTID:
+	case WMI_RADIO_LINK_STATS_EVENTID:
+	case WMI_RADIO_TX_POWER_LEVEL_STATS_EVENTID:
+	case WMI_REPORT_STATS_EVENTID:
+	case WMI_STATS_EXT_EVENTID:
+	case WMI_ROAM_STATS_EVENTID:
+	case WMI_WLAN_PROFILE_DATA_EVENTID:
+	case WMI_DEBUG_PRINT_EVENTID:
+	case WMI_DEBUG_MESG_FLUSH_COMPLETE_EVENTID:
+		return WMA_FW_EVENT_PRIO_LOW;
+	default:
+		return WMA_FW_EVENT_PRIO_NORMAL;
+	}
+}
+
+/**
+ * wma_fw_event_stats_update() - account a processed serialized fw event
+ * @wma: wma handle
+ * @buf: fw event parameters
+ * @queue_us: time the event waited for the mc thread
+ * @run_us: time spent in the event handler
+ *
+ * The table is open addressed on the event id; once it is full, the events
+ * not tracked yet are accounted in the entry they hash to. Only updated
+ * from the mc thread.
+ *
+ * Return: none
+ */
+static void wma_fw_event_stats_update(tp_wma_handle wma,
+				      wma_process_fw_event_params *buf,
+				      uint32_t queue_us, uint32_t run_us)
+{
+	struct wma_fw_event_stats *stats;
+	uint32_t idx, i;
+
+	idx = (buf->event_id ^ (buf->event_id >> 12)) %
+		WMA_FW_EVENT_STATS_SIZE;
+	for (i = 0; i < WMA_FW_EVENT_STATS_SIZE; i++) {
+		stats = &wma->fw_event_stats[(idx + i) %
+					     WMA_FW_EVENT_STATS_SIZE];
+		if (!stats->event_id || stats->event_id == buf->event_id)
+			break;
+	}
+
+	if (i == WMA_FW_EVENT_STATS_SIZE)
+		stats = &wma->fw_event_stats[idx];
+	else
+		stats->event_id = buf->event_id;
+
+	stats->count++;
+	stats->queue_us += queue_us;
+	stats->run_us += run_us;
+	if (queue_us > stats->max_queue_us)
+		stats->max_queue_us = queue_us;
+	if (run_us > stats->max_run_us)
+		stats->max_run_us = run_us;
+}
+
+/**
+ * wma_fw_event_free() - free a serialized fw event which is not processed
+ * @wma: wma handle
+ * @buf: fw event parameters
+ *
+ * Return: none
+ */
+static void wma_fw_event_free(tp_wma_handle wma,
+			      wma_process_fw_event_params *buf)
+{
+	if (wma_event_is_critical(buf->event_id))
+		qdf_atomic_dec(&wma->critical_events_in_flight);
+
+	qdf_nbuf_free(buf->evt_buf);
+	qdf_mem_free(buf);
+}
+
+/**
+ * wma_fw_event_run() - run the handler of a serialized fw event
+ * @wma: wma handle
+ * @buf: fw event parameters, freed here
+ *
+ * Return: none
+ */
+static void wma_fw_event_run(tp_wma_handle wma,
+			     wma_process_fw_event_params *buf)
+{
+	uint64_t start_us = qdf_get_log_timestamp_usecs();
+
+	wmi_process_fw_event(buf->wmi_handle, buf->evt_buf);
+
+	wma_fw_event_stats_update(wma, buf, start_us - buf->enqueue_us,
+				  qdf_get_log_timestamp_usecs() - start_us);
+
+	if (wma_event_is_critical(buf->event_id))
+		qdf_atomic_dec(&wma->critical_events_in_flight);
+
+	qdf_mem_free(buf);
+}
+
 /**
  * wma_process_fw_event() - process any fw event
  * @wma: wma handle
- * @buf: fw event buffer
+ * @buf: fw event posted with the message, NULL for the priority lanes
  *
  * This function process any fw event to serialize it through mc thread.
+ * Every WMA_PROCESS_FW_EVENT message without an event of its own processes
+ * the oldest pending event of the highest priority lane, so that the other
+ * events are not delayed by a burst of statistics events queued before
+ * them. An event is only posted with its message when its lane is full.
+ *
+ * Every event in a lane is matched by one pending message, see
+ * wma_fw_event_post_failed(). The message also processes the events which
+ * are left without one.
  *
  * Return: none
  */
 static int wma_process_fw_event(tp_wma_handle wma,
 				wma_process_fw_event_params *buf)
 {
-	struct wmi_unified *wmi_handle = (struct wmi_unified *)buf->wmi_handle;
-	uint32_t event_id = WMI_GET_FIELD(qdf_nbuf_data(buf->evt_buf),
-					  WMI_CMD_HDR, COMMANDID);
+	qdf_list_node_t *node;
+	uint32_t num_events;
+	bool own_msg = true;
+	uint8_t prio;
 
-	wmi_process_fw_event(wmi_handle, buf->evt_buf);
+	if (buf) {
+		wma_fw_event_run(wma, buf);
+		return 0;
+	}
 
-	if (wma_event_is_critical(event_id))
-		qdf_atomic_dec(&wma->critical_events_in_flight);
+	do {
+		node = NULL;
+		num_events = 0;
+		qdf_spin_lock_bh(&wma->fw_event_lock);
+		/* consumed together with the event it was posted for */
+		if (own_msg)
+			qdf_atomic_dec(&wma->fw_event_msg_pending);
+		own_msg = false;
+		for (prio = 0; prio < WMA_FW_EVENT_PRIO_MAX; prio++) {
+			if (!node)
+				qdf_list_remove_front(&wma->fw_event_lane[prio],
+						      &node);
+			num_events += qdf_list_size(&wma->fw_event_lane[prio]);
+		}
+		qdf_spin_unlock_bh(&wma->fw_event_lock);
+
+		if (!node)
+			return 0;
+
+		wma_fw_event_run(wma, qdf_container_of(
+					node, wma_process_fw_event_params,
+					node));
+	} while (num_events >
+		 (uint32_t)qdf_atomic_read(&wma->fw_event_msg_pending));
 
 	return 0;
 }
 
+/**
+ * wma_fw_event_post_failed() - drop a fw event whose message was not posted
+ * @wma: wma handle
+ * @buf: fw event queued for the message, may already be processed
+ * @prio: priority lane @buf was queued in
+ *
+ * Without its message, one of the queued events would only be processed
+ * once a later event is received, which may never happen, holding
+ * critical_events_in_flight and blocking suspend meanwhile. @buf is
+ * dropped if it is still queued, otherwise it was processed by an earlier
+ * message on behalf of the newest event of the lowest priority, which is
+ * dropped instead.
+ *
+ * Return: none
+ */
+static void wma_fw_event_post_failed(tp_wma_handle wma,
+				     wma_process_fw_event_params *buf,
+				     uint8_t prio)
+{
+	qdf_list_node_t *node = NULL;
+	uint32_t num_events = 0;
+	uint8_t i;
+
+	qdf_spin_lock_bh(&wma->fw_event_lock);
+	qdf_atomic_dec(&wma->fw_event_msg_pending);
+	for (i = 0; i < WMA_FW_EVENT_PRIO_MAX; i++)
+		num_events += qdf_list_size(&wma->fw_event_lane[i]);
+
+	if (num_events >
+	    (uint32_t)qdf_atomic_read(&wma->fw_event_msg_pending)) {
+		/* only compares @buf, which may be freed already */
+		if (QDF_IS_STATUS_SUCCESS(
+			qdf_list_remove_node(&wma->fw_event_lane[prio],
+					     &buf->node)))
+			node = &buf->node;
+
+		for (i = WMA_FW_EVENT_PRIO_MAX; !node && i > 0; i--)
+			qdf_list_remove_back(&wma->fw_event_lane[i - 1],
+					     &node);
+	}
+	qdf_spin_unlock_bh(&wma->fw_event_lock);
+
+	if (!node)
+		return;
+
+	buf = qdf_container_of(node, wma_process_fw_event_params, node);
+	WMA_LOGE("%s: fw event 0x%x dropped", __func__, buf->event_id);
+	wma_fw_event_free(wma, buf);
+}
+
+/**
+ * wma_fw_event_lanes_init() - initialize the priority lanes of fw events
+ * @wma: wma handle
+ *
+ * Return: none
+ */
+static void wma_fw_event_lanes_init(tp_wma_handle wma)
+{
+	uint8_t prio;
+
+	qdf_spinlock_create(&wma->fw_event_lock);
+	for (prio = 0; prio < WMA_FW_EVENT_PRIO_MAX; prio++)
+		qdf_list_create(&wma->fw_event_lane[prio],
+				WMA_FW_EVENT_LANE_SIZE);
+	qdf_atomic_init(&wma->fw_event_msg_pending);
+}
+
+/**
+ * wma_fw_event_lanes_flush() - free the fw events pending in priority lanes
+ * @wma: wma handle
+ *
+ * Called when the WMA_PROCESS_FW_EVENT messages are flushed from the
+ * scheduler queue, and from wma_close() for the events left without any
+ * message.
+ *
+ * Return: none
+ */
+static void wma_fw_event_lanes_flush(tp_wma_handle wma)
+{
+	wma_process_fw_event_params *buf;
+	qdf_list_node_t *node;
+	QDF_STATUS status;
+	uint8_t prio;
+
+	for (prio = 0; prio < WMA_FW_EVENT_PRIO_MAX; prio++) {
+		do {
+			node = NULL;
+			qdf_spin_lock_bh(&wma->fw_event_lock);
+			status = qdf_list_remove_front(&wma->fw_event_lane[prio],
+						       &node);
+			qdf_spin_unlock_bh(&wma->fw_event_lock);
+			if (QDF_IS_STATUS_ERROR(status))
+				break;
+
+			buf = qdf_container_of(node,
+					       wma_process_fw_event_params,
+					       node);
+			wma_fw_event_free(wma, buf);
+		} while (true);
+	}
+}
+
+/**
+ * wma_fw_event_lanes_deinit() - free the fw events left in priority lanes
+ * @wma: wma handle
+ *
+ * Return: none
+ */
+static void wma_fw_event_lanes_deinit(tp_wma_handle wma)
+{
+	uint8_t prio;
+
+	wma_fw_event_lanes_flush(wma);
+	for (prio = 0; prio < WMA_FW_EVENT_PRIO_MAX; prio++)
+		qdf_list_destroy(&wma->fw_event_lane[prio]);
+	qdf_spinlock_destroy(&wma->fw_event_lock);
+}
+
+#ifdef WLAN_DEBUGFS
+/* Number of event ids shown in the fw event debugfs table */
+#define WMA_FW_EVENT_DEBUGFS_TOP 16
+
+/**
+ * wma_fw_event_stats_show() - show the slowest serialized fw event handlers
+ * @file: debugfs file to print to
+ * @arg: wma handle
+ *
+ * Return: QDF_STATUS
+ */
+static QDF_STATUS wma_fw_event_stats_show(qdf_debugfs_file_t file, void *arg)
+{
+	tp_wma_handle wma = arg;
+	struct wma_fw_event_stats *top[WMA_FW_EVENT_DEBUGFS_TOP];
+	struct wma_fw_event_stats *stats;
+	uint32_t num_top = 0, i, j;
+	uint8_t prio;
+
+	qdf_spin_lock_bh(&wma->fw_event_lock);
+	qdf_debugfs_printf(file, "pending: normal %u low %u\n",
+			   qdf_list_size(
+				&wma->fw_event_lane[WMA_FW_EVENT_PRIO_NORMAL]),
+			   qdf_list_size(
+				&wma->fw_event_lane[WMA_FW_EVENT_PRIO_LOW]));
+	qdf_spin_unlock_bh(&wma->fw_event_lock);
+
+	/* Insertion sort of the entries by their longest handler run */
+	for (i = 0; i < WMA_FW_EVENT_STATS_SIZE; i++) {
+		stats = &wma->fw_event_stats[i];
+		if (!stats->count)
+			continue;
+
+		for (j = num_top; j > 0; j--) {
+			if (top[j - 1]->max_run_us >= stats->max_run_us)
+				break;
+			if (j < WMA_FW_EVENT_DEBUGFS_TOP)
+				top[j] = top[j - 1];
+		}
+		if (j < WMA_FW_EVENT_DEBUGFS_TOP) {
+			top[j] = stats;
+			if (num_top < WMA_FW_EVENT_DEBUGFS_TOP)
+				num_top++;
+		}
+	}
+
+	qdf_debugfs_printf(file,
+			   "event_id   prio count      avg_queue_us max_queue_us avg_run_us max_run_us\n");
+	for (i = 0; i < num_top; i++) {
+		stats = top[i];
+		prio = wma_get_fw_event_prio(stats->event_id);
+		qdf_debugfs_printf(file,
+				   "0x%08x %4u %10u %12llu %12u %10llu %10u\n",
+				   stats->event_id, prio, stats->count,
+				   stats->queue_us / stats->count,
+				   stats->max_queue_us,
+				   stats->run_us / stats->count,
+				   stats->max_run_us);
+	}
+
+	return QDF_STATUS_SUCCESS;
+}
+
+/**
+ * wma_fw_event_debugfs_init() - create the fw event statistics debugfs file
+ * @wma: wma handle
+ *
+ * Return: none
+ */
+static void wma_fw_event_debugfs_init(tp_wma_handle wma)
+{
+	wma->fw_event_debugfs_fops.show = wma_fw_event_stats_show;
+	wma->fw_event_debugfs_fops.write = NULL;
+	wma->fw_event_debugfs_fops.priv = wma;
+
+	wma->fw_event_debugfs_dir = qdf_debugfs_create_dir("wma", NULL);
+	if (!wma->fw_event_debugfs_dir) {
+		WMA_LOGE("%s: failed to create debugfs dir", __func__);
+		return;
+	}
+
+	if (!qdf_debugfs_create_file("fw_event_latency", 00400,
+				     wma->fw_event_debugfs_dir,
+				     &wma->fw_event_debugfs_fops)) {
+		WMA_LOGE("%s: failed to create debugfs file", __func__);
+		qdf_debugfs_remove_dir_recursive(wma->fw_event_debugfs_dir);
+		wma->fw_event_debugfs_dir = NULL;
+	}
+}
+
+/**
+ * wma_fw_event_debugfs_deinit() - remove the fw event statistics file
+ * @wma: wma handle
+ *
+ * Return: none
+ */
+static void wma_fw_event_debugfs_deinit(tp_wma_handle wma)
+{
+	if (!wma->fw_event_debugfs_dir)
+		return;
+
+	qdf_debugfs_remove_dir_recursive(wma->fw_event_debugfs_dir);
+	wma->fw_event_debugfs_dir = NULL;
+}
+#else
+static inline void wma_fw_event_debugfs_init(tp_wma_handle wma)
+{
+}
+
+static inline void wma_fw_event_debugfs_deinit(tp_wma_handle wma)
+{
+}
+#endif
+
 /**
  * wmi_process_fw_event_tasklet_ctx() - process in tasklet context
  * @ctx: handle to wmi
@@ -1690,14 +2073,29 @@ QDF_STATUS wma_process_hal_pwr_dbg_cmd(WMA_HANDLE handle,
 
 static void wma_discard_fw_event(struct scheduler_msg *msg)
 {
+	tp_wma_handle wma;
+
+	if (msg->type == WMA_PROCESS_FW_EVENT) {
+		wma = cds_get_context(QDF_MODULE_ID_WMA);
+		if (!wma)
+			return;
+
+		/* posted with its message as its lane was full */
+		if (msg->bodyptr) {
+			wma_fw_event_free(wma, msg->bodyptr);
+			msg->bodyptr = NULL;
+			return;
+		}
+
+		/* the events themselves are freed from the priority lanes */
+		qdf_atomic_dec(&wma->fw_event_msg_pending);
+		wma_fw_event_lanes_flush(wma);
+	}
+
 	if (!msg->bodyptr)
 		return;
 
 	switch (msg->type) {
-	case WMA_PROCESS_FW_EVENT:
-		qdf_nbuf_free(((wma_process_fw_event_params *)msg->bodyptr)
-				->evt_buf);
-		break;
 	case WMA_SET_LINK_STATE:
 		qdf_mem_free(((tpLinkStateParams) msg->bodyptr)->callbackArg);
 		break;
@@ -1770,7 +2168,14 @@ static int wma_process_fw_event_mc_thread_ctx(void *ctx, void *ev)
 	wma_process_fw_event_params *params_buf;
 	struct scheduler_msg cds_msg = { 0 };
 	tp_wma_handle wma;
-	uint32_t event_id;
+	uint8_t prio;
+	QDF_STATUS status;
+
+	wma = cds_get_context(QDF_MODULE_ID_WMA);
+	if (!wma) {
+		qdf_nbuf_free(ev);
+		return -EINVAL;
+	}
 
 	params_buf = qdf_mem_malloc(sizeof(wma_process_fw_event_params));
 	if (!params_buf) {
@@ -1780,27 +2185,50 @@ static int wma_process_fw_event_mc_thread_ctx(void *ctx, void *ev)
 
 	params_buf->wmi_handle = (struct wmi_unified *)ctx;
 	params_buf->evt_buf = ev;
+	params_buf->event_id = WMI_GET_FIELD(qdf_nbuf_data(ev),
+					     WMI_CMD_HDR, COMMANDID);
+	params_buf->prio = wma_get_fw_event_prio(params_buf->event_id);
+	params_buf->enqueue_us = qdf_get_log_timestamp_usecs();
+	prio = params_buf->prio;
 
-	wma = cds_get_context(QDF_MODULE_ID_WMA);
-	event_id = WMI_GET_FIELD(qdf_nbuf_data(params_buf->evt_buf),
-				 WMI_CMD_HDR, COMMANDID);
-	if (wma && wma_event_is_critical(event_id))
+	if (wma_event_is_critical(params_buf->event_id))
 		qdf_atomic_inc(&wma->critical_events_in_flight);
 
+	/*
+	 * The message only schedules the processing of one pending event, it
+	 * does not own params_buf which may already be processed by an earlier
+	 * message.
+	 */
 	cds_msg.type = WMA_PROCESS_FW_EVENT;
-	cds_msg.bodyptr = params_buf;
+	cds_msg.bodyptr = NULL;
 	cds_msg.bodyval = 0;
 	cds_msg.flush_callback = wma_discard_fw_event;
 
-	if (QDF_STATUS_SUCCESS !=
+	qdf_spin_lock_bh(&wma->fw_event_lock);
+	status = qdf_list_insert_back(&wma->fw_event_lane[prio],
+				      &params_buf->node);
+	if (QDF_IS_STATUS_SUCCESS(status))
+		qdf_atomic_inc(&wma->fw_event_msg_pending);
+	qdf_spin_unlock_bh(&wma->fw_event_lock);
+	if (QDF_IS_STATUS_ERROR(status)) {
+		WMA_LOGW("%s: fw event lane %d full, post event 0x%x",
+			 __func__, prio, params_buf->event_id);
+		cds_msg.bodyptr = params_buf;
+	}
+
+	if (QDF_STATUS_SUCCESS ==
 		scheduler_post_message(QDF_MODULE_ID_WMA,
 				       QDF_MODULE_ID_WMA,
-				       QDF_MODULE_ID_WMA, &cds_msg)) {
-		qdf_nbuf_free(ev);
-		qdf_mem_free(params_buf);
-		return -EFAULT;
-	}
-	return 0;
+				       QDF_MODULE_ID_WMA, &cds_msg))
+		return 0;
+
+	WMA_LOGE("%s: failed to post fw event", __func__);
+	if (cds_msg.bodyptr)
+		wma_fw_event_free(wma, params_buf);
+	else
+		wma_fw_event_post_failed(wma, params_buf, prio);
+
+	return -EFAULT;
 
 }
 
@@ -3563,6 +3991,8 @@ QDF_STATUS wma_open(struct wlan_objmgr_psoc *psoc,
 	qdf_list_create(&wma_handle->wma_hold_req_queue,
 		      MAX_ENTRY_HOLD_REQ_QUEUE);
 	qdf_spinlock_create(&wma_handle->wma_hold_req_q_lock);
+	wma_fw_event_lanes_init(wma_handle);
+	wma_fw_event_debugfs_init(wma_handle);
 	qdf_atomic_init(&wma_handle->is_wow_bus_suspended);
 
 	/* Register vdev start response event handler */
@@ -3865,6 +4295,8 @@ err_dbglog_init:
 	qdf_runtime_lock_deinit(&wma_handle->wmi_cmd_rsp_runtime_lock);
 	qdf_spinlock_destroy(&wma_handle->vdev_respq_lock);
 	qdf_spinlock_destroy(&wma_handle->wma_hold_req_q_lock);
+	wma_fw_event_debugfs_deinit(wma_handle);
+	wma_fw_event_lanes_deinit(wma_handle);
 err_event_init:
 	wmi_unified_unregister_event_handler(wma_handle->wmi_handle,
 					     wmi_debug_print_event_id);
@@ -4942,6 +5374,8 @@ QDF_STATUS wma_close(void)
 	qdf_runtime_lock_deinit(&wma_handle->wmi_cmd_rsp_runtime_lock);
 	qdf_spinlock_destroy(&wma_handle->vdev_respq_lock);
 	qdf_spinlock_destroy(&wma_handle->wma_hold_req_q_lock);
+	wma_fw_event_debugfs_deinit(wma_handle);
+	wma_fw_event_lanes_deinit(wma_handle);
 
 	if (wma_handle->pGetRssiReq) {
 		qdf_mem_free(wma_handle->pGetRssiReq);
@@ -8745,9 +9179,7 @@ static QDF_STATUS wma_mc_process_msg(struct scheduler_msg *msg)
 	 * FW events to serialize through mc_thread.
 	 */
 	case WMA_PROCESS_FW_EVENT:
-		wma_process_fw_event(wma_handle,
-				(wma_process_fw_event_params *) msg->bodyptr);
-		qdf_mem_free(msg->bodyptr);
+		wma_process_fw_event(wma_handle, msg->bodyptr);
 		break;
 
 #ifdef FEATURE_WLAN_ESE